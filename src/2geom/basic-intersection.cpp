@@ -1,11 +1,9 @@
 #include <2geom/basic-intersection.h>
 #include <2geom/sbasis-to-bezier.h>
 #include <2geom/exception.h>
+#include <2geom/curve.h>
+#include <algorithm>
 
-#ifdef HAVE_GSL
-#include <gsl/gsl_vector.h>
-#include <gsl/gsl_multiroots.h>
-#endif
 
 using std::vector;
 namespace Geom {
@@ -114,22 +112,28 @@ find_self_intersections(std::vector<std::pair<double, double> > &xs,
         }
     }
 
+    vector<std::pair<unsigned, unsigned> > pairs;
     for(unsigned i = 0; i < dr.size()-1; i++) {
         for(unsigned j = i+1; j < dr.size()-1; j++) {
-            std::vector<std::pair<double, double> > section;
-            
-            find_intersections( section, pieces[i], pieces[j]);
-            for(unsigned k = 0; k < section.size(); k++) {
-                double l = section[k].first;
-                double r = section[k].second;
+            pairs.push_back(std::make_pair(i, j));
+        }
+    }
+    vector<vector<std::pair<double, double> > > sections;
+    find_intersections_bezier_clipping(sections, pieces, pairs);
+
+    for(unsigned p = 0; p < pairs.size(); p++) {
+        unsigned i = pairs[p].first, j = pairs[p].second;
+        vector<std::pair<double, double> > const &section = sections[p];
+        for(unsigned k = 0; k < section.size(); k++) {
+            double l = section[k].first;
+            double r = section[k].second;
 // XXX: This condition will prune out false positives, but it might create some false negatives.  Todo: Confirm it is correct.
-                if(j == i+1)
-                    //if((l == 1) && (r == 0))
-                    if( ( l > 1-1e-4 ) && (r < 1e-4) )//FIXME: what precision should be used here???
-                        continue;
-                xs.push_back(std::make_pair((1-l)*dr[i] + l*dr[i+1],
-                                                (1-r)*dr[j] + r*dr[j+1]));
-            }
+            if(j == i+1)
+                //if((l == 1) && (r == 0))
+                if( ( l > 1-1e-4 ) && (r < 1e-4) )//FIXME: what precision should be used here???
+                    continue;
+            xs.push_back(std::make_pair((1-l)*dr[i] + l*dr[i+1],
+                                            (1-r)*dr[j] + r*dr[j+1]));
         }
     }
 
@@ -138,32 +142,6 @@ find_self_intersections(std::vector<std::pair<double, double> > &xs,
     //unique(xs.begin(), xs.end());
 }
 
-#ifdef HAVE_GSL
-#include <gsl/gsl_multiroots.h>
-
-struct rparams
-{
-    D2<SBasis> const &A;
-    D2<SBasis> const &B;
-};
-
-static int
-intersect_polish_f (const gsl_vector * x, void *params,
-                    gsl_vector * f)
-{
-    const double x0 = gsl_vector_get (x, 0);
-    const double x1 = gsl_vector_get (x, 1);
-
-    Geom::Point dx = ((struct rparams *) params)->A(x0) -
-        ((struct rparams *) params)->B(x1);
-
-    gsl_vector_set (f, 0, dx[0]);
-    gsl_vector_set (f, 1, dx[1]);
-
-    return GSL_SUCCESS;
-}
-#endif
-
 union dbl_64{
     long long i64;
     double d64;
@@ -177,89 +155,57 @@ static double EpsilonBy(double value, int eps)
     return s.d64;
 }
 
+static inline Point value_and_derivative(D2<SBasis> const &c, Coord t, Point &deriv)
+{
+    return c.valueAndDerivative(t, deriv);
+}
 
-static void intersect_polish_root (D2<SBasis> const &A, double &s,
-                                   D2<SBasis> const &B, double &t) {
-#ifdef HAVE_GSL
-    const gsl_multiroot_fsolver_type *T;
-    gsl_multiroot_fsolver *sol;
+static inline Point value_and_derivative(Curve const &c, Coord t, Point &deriv)
+{
+    return c.pointAndDerivative(t, deriv);
+}
 
-    int status;
-    size_t iter = 0;
-#endif
-    std::vector<Point> as, bs;
-    as = A.valueAndDerivatives(s, 2);
-    bs = B.valueAndDerivatives(t, 2);
-    Point F = as[0] - bs[0];
-    double best = dot(F, F);
-    
-    for(int i = 0; i < 4; i++) {
-        
-        /**
-           we want to solve
-           J*(x1 - x0) = f(x0)
-           
-           |dA(s)[0]  -dB(t)[0]|  (X1 - X0) = A(s) - B(t)
-           |dA(s)[1]  -dB(t)[1]| 
-        **/
-
-        // We're using the standard transformation matricies, which is numerically rather poor.  Much better to solve the equation using elimination.
-
-        Affine jack(as[1][0], as[1][1],
-                    -bs[1][0], -bs[1][1],
-                    0, 0);
-        Point soln = (F)*jack.inverse();
-        double ns = s - soln[0];
-        double nt = t - soln[1];
-        
-        as = A.valueAndDerivatives(ns, 2);
-        bs = B.valueAndDerivatives(nt, 2);
-        F = as[0] - bs[0];
-        double trial = dot(F, F);
-        if (trial > best*0.1) {// we have standards, you know
-            // At this point we could do a line search
-            break;
+/* Newton's method on A(s) - B(t) = 0. Each step solves the 2x2 system
+ *
+ *     |A'(s)[X]  -B'(t)[X]| |ds|   |A(s)[X] - B(t)[X]|
+ *     |A'(s)[Y]  -B'(t)[Y]| |dt| = |A(s)[Y] - B(t)[Y]|
+ *
+ * by Cramer's rule, and is only taken while it makes the distance smaller, which
+ * stops the iteration once rounding errors dominate. Nothing is allocated. */
+template <typename T>
+static void newton_polish(T const &A, Coord &s, T const &B, Coord &t, bool clamp)
+{
+    Point da, db;
+    Point F = value_and_derivative(A, s, da) - value_and_derivative(B, t, db);
+    Coord best = dot(F, F);
+
+    for (unsigned i = 0; i < 8 && best > 0; ++i) {
+        Coord det = db[X] * da[Y] - da[X] * db[Y];
+        if (det == 0) break;
+        Coord ns = s - (db[X] * F[Y] - F[X] * db[Y]) / det;
+        Coord nt = t - (da[X] * F[Y] - F[X] * da[Y]) / det;
+        if (clamp) {
+            ns = std::min(std::max(ns, 0.0), 1.0);
+            nt = std::min(std::max(nt, 0.0), 1.0);
         }
+
+        Point nda, ndb;
+        Point nF = value_and_derivative(A, ns, nda) - value_and_derivative(B, nt, ndb);
+        Coord trial = dot(nF, nF);
+        if (!(trial < best)) break;
         best = trial;
         s = ns;
         t = nt;
+        F = nF;
+        da = nda;
+        db = ndb;
     }
-    
-#ifdef HAVE_GSL
-    const size_t n = 2;
-    struct rparams p = {A, B};
-    gsl_multiroot_function f = {&intersect_polish_f, n, &p};
-
-    double x_init[2] = {s, t};
-    gsl_vector *x = gsl_vector_alloc (n);
-
-    gsl_vector_set (x, 0, x_init[0]);
-    gsl_vector_set (x, 1, x_init[1]);
-
-    T = gsl_multiroot_fsolver_hybrids;
-    sol = gsl_multiroot_fsolver_alloc (T, 2);
-    gsl_multiroot_fsolver_set (sol, &f, x);
-
-    do
-    {
-        iter++;
-        status = gsl_multiroot_fsolver_iterate (sol);
-
-        if (status)   /* check if solver is stuck */
-            break;
-
-        status =
-            gsl_multiroot_test_residual (sol->f, 1e-12);
-    }
-    while (status == GSL_CONTINUE && iter < 1000);
+}
 
-    s = gsl_vector_get (sol->x, 0);
-    t = gsl_vector_get (sol->x, 1);
+static void intersect_polish_root (D2<SBasis> const &A, double &s,
+                                   D2<SBasis> const &B, double &t) {
+    newton_polish(A, s, B, t, false);
 
-    gsl_multiroot_fsolver_free (sol);
-    gsl_vector_free (x);
-#endif
-    
     {
     // This code does a neighbourhood search for minor improvements.
     double best_v = L1(A(s) - B(t));
@@ -304,6 +250,11 @@ void polish_intersections(std::vector<std::pair<double, double> > &xs,
                               B, xs[i].second);
 }
 
+void polish_intersection(Curve const &A, Coord &s, Curve const &B, Coord &t)
+{
+    newton_polish(A, s, B, t, true);
+}
+
 
  /**
   * Compute the Hausdorf distance from A to B only.
@@ -36,9 +36,11 @@
 #define SEEN_GEOM_BASICINTERSECTION_H
 
 #include <2geom/point.h>
+#include <2geom/interval.h>
 #include <2geom/sbasis.h>
 #include <2geom/d2.h>
 
+#include <deque>
 #include <vector>
 #include <utility>
 
@@ -47,6 +49,29 @@
 
 namespace Geom {
 
+class Curve;
+namespace detail { namespace bezier_clipping { struct Frame; } }
+
+/**
+ * @brief Scratch memory for find_intersections_bezier_clipping().
+ *
+ * Bezier clipping subdivides the curves recursively. The control polygons of
+ * the pieces are kept here between calls, so a workspace reused over many
+ * pairs of curves stops allocating once it has grown to the deepest recursion.
+ * A workspace must not be used by two threads at the same time.
+ */
+class BezierClippingWorkspace {
+public:
+    BezierClippingWorkspace() : _top(0), _counter(0) {}
+private:
+    std::deque<std::vector<Point> > _curves; // used as a stack
+    std::vector<Point> _hull;                // distance curve of the current clip
+    std::vector<Interval> _doms_a, _doms_b;
+    std::size_t _top;
+    std::size_t _counter;                    // subdivisions of the current pair
+    friend struct detail::bezier_clipping::Frame;
+};
+
 //why not allowing precision to be set here?
 void find_intersections(std::vector<std::pair<double, double> >& xs,
                         D2<SBasis> const & A,
@@ -97,6 +122,32 @@ void find_intersections_bezier_clipping (std::vector< std::pair<double, double>
                          std::vector<Point> const& A,
                          std::vector<Point> const& B,
                          double precision = 1e-5);
+
+/*
+ * The same, with the temporary storage taken from "ws"; use one workspace
+ * for many calls to avoid allocating memory in each of them.
+ */
+void find_intersections_bezier_clipping (std::vector< std::pair<double, double> > & xs,
+                         std::vector<Point> const& A,
+                         std::vector<Point> const& B,
+                         BezierClippingWorkspace & ws,
+                         double precision = 1e-5);
+
+/*
+ * find_intersections_bezier_clipping
+ *
+ *  input: curves     - control points of Bezier curves
+ *  input: pairs      - pairs of indices into curves, e.g. found by sweep_bounds
+ *  input: precision  - required precision of computation
+ *  output: xs        - for each pair, the parameter values of its crossings,
+ *                      the same as for a single pair
+ *
+ *  When the library is built with OpenMP the pairs are processed in parallel.
+ */
+void find_intersections_bezier_clipping (std::vector< std::vector< std::pair<double, double> > > & xs,
+                         std::vector< std::vector<Point> > const& curves,
+                         std::vector< std::pair<unsigned, unsigned> > const& pairs,
+                         double precision = 1e-5);
 //#endif
 
 
@@ -121,6 +172,13 @@ void polish_intersections(std::vector<std::pair<double, double> > &xs,
                           D2<SBasis> const &A,
                           D2<SBasis> const &B);
 
+/**
+ * Refine an approximate intersection A(s) = B(t) of two curves with Newton's method,
+ * keeping s and t in [0, 1]. The curves are evaluated with Curve::pointAndDerivative(),
+ * so no memory is allocated for the curves that come with 2Geom.
+ */
+void polish_intersection(Curve const &A, Coord &s, Curve const &B, Coord &t);
+
 
 /**
  * Compute the Hausdorf distance from A to B only.
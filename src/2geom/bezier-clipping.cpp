@@ -393,13 +393,11 @@ void iterate(std::vector<Interval>& domsA,
  *  vector : l[0] * x + l[1] * y + l[2] == 0; the line is normalized.
  */
 inline
-void orientation_line (std::vector<double> & l,
-                       std::vector<Point> const& c,
-                       size_t i, size_t j)
+void orientation_line (double l[3], Point const& p, Point const& q)
 {
-    l[0] = c[j][Y] - c[i][Y];
-    l[1] = c[i][X] - c[j][X];
-    l[2] = cross(c[i], c[j]);
+    l[0] = q[Y] - p[Y];
+    l[1] = p[X] - q[X];
+    l[2] = cross(p, q);
     double length = std::sqrt(l[0] * l[0] + l[1] * l[1]);
     assert (length != 0);
     l[0] /= length;
@@ -407,12 +405,20 @@ void orientation_line (std::vector<double> & l,
     l[2] /= length;
 }
 
+inline
+void orientation_line (double l[3],
+                       std::vector<Point> const& c,
+                       size_t i, size_t j)
+{
+    orientation_line(l, c[i], c[j]);
+}
+
 /*
  * Pick up an orientation line for the Bezier curve "c" and return it in
  * the output parameter "l"
  */
 inline
-void pick_orientation_line (std::vector<double> & l,
+void pick_orientation_line (double l[3],
                             std::vector<Point> const& c)
 {
     size_t i = c.size();
@@ -437,7 +443,7 @@ void pick_orientation_line (std::vector<double> & l,
  *  vector : l[0] * x + l[1] * y + l[2] == 0; the line is normalized.
  */
 inline
-void orthogonal_orientation_line (std::vector<double> & l,
+void orthogonal_orientation_line (double l[3],
                                   std::vector<Point> const& c,
                                   Point const& p)
 {
@@ -446,17 +452,14 @@ void orthogonal_orientation_line (std::vector<double> & l,
         // this should never happen
         assert(!is_constant(c));
     }
-    std::vector<Point> ol(2);
-    ol[0] = p;
-    ol[1] = (c.back() - c.front()).cw() + p;
-    orientation_line(l, ol, 0, 1);
+    orientation_line(l, p, (c.back() - c.front()).cw() + p);
 }
 
 /*
  *  Compute the signed distance of the point "P" from the normalized line l
  */
 inline
-double distance (Point const& P, std::vector<double> const& l)
+double distance (Point const& P, double const l[3])
 {
     return l[X] * P[X] + l[Y] * P[Y] + l[2];
 }
@@ -469,7 +472,7 @@ double distance (Point const& P, std::vector<double> const& l)
 inline
 void fat_line_bounds (Interval& bound,
                       std::vector<Point> const& c,
-                      std::vector<double> const& l)
+                      double const l[3])
 {
     bound[0] = 0;
     bound[1] = 0;
@@ -499,16 +502,17 @@ double intersect (Point const& p1, Point const& p2, double y)
 /*
  * Clip the Bezier curve "B" wrt the fat line defined by the orientation
  * line "l" and the interval range "bound", the new parameter interval for
- * the clipped curve is returned through the output parameter "dom"
+ * the clipped curve is returned through the output parameter "dom";
+ * "D" is scratch space for the distance curve
  */
 void clip_interval (Interval& dom,
                     std::vector<Point> const& B,
-                    std::vector<double> const& l,
-                    Interval const& bound)
+                    double const l[3],
+                    Interval const& bound,
+                    std::vector<Point> & D)
 {
     double n = B.size() - 1;  // number of sub-intervals
-    std::vector<Point> D;     // distance curve control points
-    D.reserve (B.size());
+    D.clear();                // distance curve control points
     double d;
     for (size_t i = 0; i < B.size(); ++i)
     {
@@ -600,13 +604,13 @@ void clip_interval (Interval& dom,
  *  intersection points the new parameter interval for the clipped curve
  *  is returned through the output parameter "dom"
  */
-template <>
 inline
-void clip<intersection_point_tag> (Interval & dom,
-                                   std::vector<Point> const& A,
-                                   std::vector<Point> const& B)
+void clip_intersection (Interval & dom,
+                        std::vector<Point> const& A,
+                        std::vector<Point> const& B,
+                        std::vector<Point> & D)
 {
-    std::vector<double> bl(3);
+    double bl[3];
     Interval bound;
     if (is_constant(A))
     {
@@ -618,7 +622,7 @@ void clip<intersection_point_tag> (Interval & dom,
         pick_orientation_line(bl, A);
     }
     fat_line_bounds(bound, A, bl);
-    clip_interval(dom, B, bl, bound);
+    clip_interval(dom, B, bl, bound, D);
 }
 
 
@@ -834,6 +838,34 @@ const Interval EMPTY_INTERVAL = make_empty_interval();
 const Interval H1_INTERVAL(0, 0.5);
 const Interval H2_INTERVAL(0.5 + MAX_PRECISION, 1.0);
 
+
+/*
+ * The control polygons of the subdivided curves are taken from the workspace
+ * as from a stack; a frame gives back everything taken since it was made
+ * when it goes out of scope. The vectors keep their capacity, so once the
+ * workspace has grown to the deepest recursion nothing else is allocated.
+ */
+struct Frame
+{
+    BezierClippingWorkspace & ws;
+    size_t top;
+
+    explicit Frame(BezierClippingWorkspace & w) : ws(w), top(w._top) {}
+    ~Frame() { ws._top = top; }
+
+    std::vector<Point> & take()
+    {
+        // a deque does not move its elements when it grows
+        if (ws._top == ws._curves.size())
+            ws._curves.push_back(std::vector<Point>());
+        return ws._curves[ws._top++];
+    }
+    std::vector<Point> & hull() { return ws._hull; }
+    std::vector<Interval> & doms_a() { return ws._doms_a; }
+    std::vector<Interval> & doms_b() { return ws._doms_b; }
+    size_t & counter() { return ws._counter; }
+};
+
 /*
  * iterate
  *
@@ -851,19 +883,18 @@ const Interval H2_INTERVAL(0.5 + MAX_PRECISION, 1.0);
  * the routine exits indipendently by the precision reached in the computation
  * of the curve intervals.
  */
-template <>
-void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
-                                      std::vector<Interval>& domsB,
-                                      std::vector<Point> const& A,
-                                      std::vector<Point> const& B,
-                                      Interval const& domA,
-                                      Interval const& domB,
-                                      double precision )
+void iterate_intersections (std::vector<Interval>& domsA,
+                            std::vector<Interval>& domsB,
+                            std::vector<Point> const& A,
+                            std::vector<Point> const& B,
+                            Interval const& domA,
+                            Interval const& domB,
+                            double precision,
+                            BezierClippingWorkspace & ws)
 {
-    // in order to limit recursion
-    static size_t counter = 0;
-    if (domA.extent() == 1 && domB.extent() == 1) counter  = 0;
-    if (++counter > 100) return;
+    Frame frame(ws);
+    // in order to limit recursion; the counter is reset for each pair of curves
+    if (++frame.counter() > 100) return;
 #if VERBOSE
     std::cerr << std::fixed << std::setprecision(16);
     std::cerr << ">> curve subdision performed <<" << std::endl;
@@ -876,8 +907,10 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
     if (precision < MAX_PRECISION)
         precision = MAX_PRECISION;
 
-    std::vector<Point> pA = A;
-    std::vector<Point> pB = B;
+    std::vector<Point> & pA = frame.take();
+    std::vector<Point> & pB = frame.take();
+    pA = A;
+    pB = B;
     std::vector<Point>* C1 = &pA;
     std::vector<Point>* C2 = &pB;
 
@@ -905,7 +938,7 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
 #if VERBOSE
         std::cerr << "iter: " << iter << std::endl;
 #endif
-        clip<intersection_point_tag>(dom, *C1, *C2);
+        clip_intersection(dom, *C1, *C2, frame.hull());
 
         // [1,0] is utilized to represent an empty interval
         if (dom == EMPTY_INTERVAL)
@@ -954,7 +987,8 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
             std::cerr << "angle(pA) : " << angle(pA) << std::endl;
             std::cerr << "angle(pB) : " << angle(pB) << std::endl;
 #endif
-            std::vector<Point> pC1, pC2;
+            std::vector<Point> & pC1 = frame.take();
+            std::vector<Point> & pC2 = frame.take();
             Interval dompC1, dompC2;
             if (dompA.extent() > dompB.extent())
             {
@@ -964,10 +998,10 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
                 dompC1 = dompC2 = dompA;
                 map_to(dompC1, H1_INTERVAL);
                 map_to(dompC2, H2_INTERVAL);
-                iterate<intersection_point_tag>(domsA, domsB, pC1, pB,
-                                                dompC1, dompB, precision);
-                iterate<intersection_point_tag>(domsA, domsB, pC2, pB,
-                                                dompC2, dompB, precision);
+                iterate_intersections(domsA, domsB, pC1, pB,
+                                      dompC1, dompB, precision, ws);
+                iterate_intersections(domsA, domsB, pC2, pB,
+                                      dompC2, dompB, precision, ws);
             }
             else
             {
@@ -977,10 +1011,10 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
                 dompC1 = dompC2 = dompB;
                 map_to(dompC1, H1_INTERVAL);
                 map_to(dompC2, H2_INTERVAL);
-                iterate<intersection_point_tag>(domsB, domsA, pC1, pA,
-                                                dompC1, dompA, precision);
-                iterate<intersection_point_tag>(domsB, domsA, pC2, pA,
-                                                dompC2, dompA, precision);
+                iterate_intersections(domsB, domsA, pC1, pA,
+                                      dompC1, dompA, precision, ws);
+                iterate_intersections(domsB, domsA, pC2, pA,
+                                      dompC2, dompA, precision, ws);
             }
             return;
         }
@@ -1014,18 +1048,17 @@ void iterate<intersection_point_tag> (std::vector<Interval>& domsA,
  * than MAX_PRECISION the routine exits indipendently by the precision reached
  * in the computation of the other curve interval.
  */
-template <>
-void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
-                                    std::vector<Interval>& domsB,
-                                    std::vector<Point> const& A,
-                                    std::vector<Point> const& B,
-                                    Interval const& domA,
-                                    Interval const& domB,
-                                    double precision)
+static
+void iterate_collinear_normals (std::vector<Interval>& domsA,
+                                std::vector<Interval>& domsB,
+                                std::vector<Point> const& A,
+                                std::vector<Point> const& B,
+                                Interval const& domA,
+                                Interval const& domB,
+                                double precision,
+                                size_t & counter)
 {
-    // in order to limit recursion
-    static size_t counter = 0;
-    if (domA.extent() == 1 && domB.extent() == 1) counter  = 0;
+    // in order to limit recursion; the counter is local to each pair of curves
     if (++counter > 100) return;
 #if VERBOSE
     std::cerr << std::fixed << std::setprecision(16);
@@ -1135,10 +1168,10 @@ void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
                 dompC1 = dompC2 = dompA;
                 map_to(dompC1, H1_INTERVAL);
                 map_to(dompC2, H2_INTERVAL);
-                iterate<collinear_normal_tag>(domsA, domsB, pC1, pB,
-                                              dompC1, dompB, precision);
-                iterate<collinear_normal_tag>(domsA, domsB, pC2, pB,
-                                              dompC2, dompB, precision);
+                iterate_collinear_normals(domsA, domsB, pC1, pB,
+                                          dompC1, dompB, precision, counter);
+                iterate_collinear_normals(domsA, domsB, pC2, pB,
+                                          dompC2, dompB, precision, counter);
             }
             else
             {
@@ -1166,10 +1199,10 @@ void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
                 dompC1 = dompC2 = dompB;
                 map_to(dompC1, H1_INTERVAL);
                 map_to(dompC2, H2_INTERVAL);
-                iterate<collinear_normal_tag>(domsB, domsA, pC1, pA,
-                                              dompC1, dompA, precision);
-                iterate<collinear_normal_tag>(domsB, domsA, pC2, pA,
-                                              dompC2, dompA, precision);
+                iterate_collinear_normals(domsB, domsA, pC1, pA,
+                                          dompC1, dompA, precision, counter);
+                iterate_collinear_normals(domsB, domsA, pC2, pA,
+                                          dompC2, dompA, precision, counter);
             }
             return;
         }
@@ -1185,6 +1218,19 @@ void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
     domsB.push_back(dompB);
 }
 
+template <>
+void iterate<collinear_normal_tag> (std::vector<Interval>& domsA,
+                                    std::vector<Interval>& domsB,
+                                    std::vector<Point> const& A,
+                                    std::vector<Point> const& B,
+                                    Interval const& domA,
+                                    Interval const& domB,
+                                    double precision)
+{
+    size_t counter = 0;
+    iterate_collinear_normals(domsA, domsB, A, B, domA, domB, precision, counter);
+}
+
 
 /*
  * get_solutions
@@ -1229,6 +1275,34 @@ void get_solutions (std::vector< std::pair<double, double> >& xs,
     }
 }
 
+/*
+ * get_intersections
+ *
+ *  the same as get_solutions<intersection_point_tag>, with all the
+ *  temporary storage taken from the workspace "ws"
+ */
+void get_intersections (std::vector< std::pair<double, double> >& xs,
+                        std::vector<Point> const& A,
+                        std::vector<Point> const& B,
+                        double precision,
+                        BezierClippingWorkspace & ws)
+{
+    Frame frame(ws);
+    std::vector<Interval> & domsA = frame.doms_a();
+    std::vector<Interval> & domsB = frame.doms_b();
+    domsA.clear();
+    domsB.clear();
+    frame.counter() = 0;
+    iterate_intersections(domsA, domsB, A, B, UNIT_INTERVAL, UNIT_INTERVAL, precision, ws);
+    assert (domsA.size() == domsB.size());
+    xs.clear();
+    xs.reserve(domsA.size());
+    for (size_t i = 0; i < domsA.size(); ++i)
+    {
+        xs.push_back(std::make_pair(domsA[i].middle(), domsB[i].middle()));
+    }
+}
+
 } /* end namespace bezier_clipping */ } /* end namespace detail */
 
 
@@ -1270,9 +1344,71 @@ void find_intersections_bezier_clipping (std::vector< std::pair<double, double>
                          std::vector<Point> const& B,
                          double precision)
 {
-    using detail::bezier_clipping::get_solutions;
-    using detail::bezier_clipping::intersection_point_tag;
-    get_solutions<intersection_point_tag>(xs, A, B, precision);
+    BezierClippingWorkspace ws;
+    detail::bezier_clipping::get_intersections(xs, A, B, precision, ws);
+}
+
+void find_intersections_bezier_clipping (std::vector< std::pair<double, double> >& xs,
+                         std::vector<Point> const& A,
+                         std::vector<Point> const& B,
+                         BezierClippingWorkspace & ws,
+                         double precision)
+{
+    detail::bezier_clipping::get_intersections(xs, A, B, precision, ws);
+}
+
+/*
+ * The pairs are independent of each other, so when the library is built with
+ * OpenMP they are spread over the threads, each with a workspace of its own.
+ * Exceptions must not leave the parallel region, so the pairs that fail there
+ * are run again afterwards on this thread, which throws the same exception as
+ * a single thread would.
+ */
+void find_intersections_bezier_clipping (std::vector< std::vector< std::pair<double, double> > >& xs,
+                         std::vector< std::vector<Point> > const& curves,
+                         std::vector< std::pair<unsigned, unsigned> > const& pairs,
+                         double precision)
+{
+    int n = pairs.size();
+    xs.resize(n);
+    std::vector<char> failed(n, 0);
+#ifdef _OPENMP
+#pragma omp parallel if(n > 1)
+#endif
+    {
+        // a thread without a workspace leaves its pairs to the serial pass
+        BezierClippingWorkspace *ws = NULL;
+        try {
+            ws = new BezierClippingWorkspace;
+        } catch (...) {
+        }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+        for (int i = 0; i < n; ++i)
+        {
+            if (!ws) {
+                failed[i] = 1;
+                continue;
+            }
+            try {
+                detail::bezier_clipping::get_intersections(xs[i], curves[pairs[i].first],
+                                                           curves[pairs[i].second], precision, *ws);
+            } catch (...) {
+                failed[i] = 1;
+            }
+        }
+        delete ws;
+    }
+
+    BezierClippingWorkspace ws;
+    for (int i = 0; i < n; ++i)
+    {
+        if (failed[i]) {
+            detail::bezier_clipping::get_intersections(xs[i], curves[pairs[i].first],
+                                                       curves[pairs[i].second], precision, ws);
+        }
+    }
 }
 
 }  // end namespace Geom
@@ -32,6 +32,15 @@
  */
 
 #include <2geom/bezier-curve.h>
+#include <2geom/quadrature.h>
+#include <2geom/solver.h>
+#include <2geom/choose.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace Geom 
 {
@@ -114,6 +123,53 @@ BezierCurve::BezierCurve(std::vector<Point> const &pts)
     }
 }
 
+/* Speed |B'(t)| of a quadratic or cubic Bezier curve, from the control points
+ * of its derivative. */
+struct BezierSpeed {
+    Point d[3];
+    unsigned order;
+    BezierSpeed(BezierCurve const &c) : order(c.order() - 1) {
+        for (unsigned i = 0; i <= order; ++i) {
+            d[i] = (order + 1) * (c[i+1] - c[i]);
+        }
+    }
+    Coord operator()(Coord t) const {
+        Coord s = 1 - t;
+        if (order == 1) return L2(s * d[0] + t * d[1]);
+        return L2(s * s * d[0] + 2 * s * t * d[1] + t * t * d[2]);
+    }
+    /* Times in (0, 1) where a coordinate of the derivative vanishes, sorted.
+     * The speed can only drop to zero at one of them, and quadrature does not
+     * notice a cusp inside an interval, so the length is integrated between them. */
+    unsigned splits(Coord *ts) const {
+        unsigned n = 0;
+        for (unsigned dim = 0; dim < 2; ++dim) {
+            Coord a = d[0][dim], b = d[1][dim], c = order == 1 ? 0 : d[2][dim];
+            if (order == 1) {
+                // linear: a (1 - t) + b t
+                if (a != b) _add(ts, n, a / (a - b));
+                continue;
+            }
+            // quadratic in the power basis: A t^2 + B t + C
+            Coord A = a - 2 * b + c, B = 2 * (b - a), C = a;
+            if (A == 0) {
+                if (B != 0) _add(ts, n, -C / B);
+                continue;
+            }
+            Coord disc = B * B - 4 * A * C;
+            if (disc < 0) continue;
+            Coord q = -0.5 * (B + (B < 0 ? -1 : 1) * std::sqrt(disc));
+            _add(ts, n, q / A);
+            if (q != 0) _add(ts, n, C / q);
+        }
+        std::sort(ts, ts + n);
+        return n;
+    }
+    static void _add(Coord *ts, unsigned &n, Coord t) {
+        if (t > 0 && t < 1) ts[n++] = t;
+    }
+};
+
 Coord BezierCurve::length(Coord tolerance) const
 {
     switch (order())
@@ -123,14 +179,18 @@ Coord BezierCurve::length(Coord tolerance) const
     case 1:
         return distance(initialPoint(), finalPoint());
     case 2:
-        {
-            std::vector<Point> pts = points();
-            return bezier_length(pts[0], pts[1], pts[2], tolerance);
-        }
     case 3:
         {
-            std::vector<Point> pts = points();
-            return bezier_length(pts[0], pts[1], pts[2], pts[3], tolerance);
+            BezierSpeed speed(*this);
+            Coord ts[5];
+            unsigned n = speed.splits(ts);
+            ts[n] = 1;
+            Coord result = 0, prev = 0;
+            for (unsigned i = 0; i <= n; ++i) {
+                result += integrate_gauss(speed, prev, ts[i], tolerance * (ts[i] - prev));
+                prev = ts[i];
+            }
+            return result;
         }
     default:
         return bezier_length(points(), tolerance);
@@ -155,6 +215,17 @@ BezierCurve *BezierCurve::create(std::vector<Point> const &pts)
     }
 }
 
+bool BezierCurve::operator==(Curve const &c) const
+{
+    if (this == &c) return true;
+    BezierCurve const *other = dynamic_cast<BezierCurve const *>(&c);
+    if (!other || order() != other->order()) return false;
+    for (unsigned i = 0; i <= order(); ++i) {
+        if ((*this)[i] != (*other)[i]) return false;
+    }
+    return true;
+}
+
 // optimized specializations for LineSegment
 
 template <>
@@ -179,6 +250,262 @@ Coord BezierCurveN<1>::nearestPoint(Point const& p, Coord from, Coord to) const
 }
 
 
+// batch evaluation of low-degree Bezier curves
+
+/* The curve is evaluated as a sum of control points weighted by the Bernstein
+ * polynomials from BezierKernel. With SSE2, the weights for two time values are
+ * computed at once by the functions below. */
+#if defined(__SSE2__)
+template <unsigned degree> struct BernsteinWeights;
+
+template <>
+struct BernsteinWeights<1> {
+    static void compute(__m128d t, __m128d *w) {
+        w[0] = _mm_sub_pd(_mm_set1_pd(1), t);
+        w[1] = t;
+    }
+};
+
+template <>
+struct BernsteinWeights<2> {
+    static void compute(__m128d t, __m128d *w) {
+        __m128d s = _mm_sub_pd(_mm_set1_pd(1), t);
+        w[0] = _mm_mul_pd(s, s);
+        w[1] = _mm_mul_pd(_mm_set1_pd(2), _mm_mul_pd(s, t));
+        w[2] = _mm_mul_pd(t, t);
+    }
+};
+
+template <>
+struct BernsteinWeights<3> {
+    static void compute(__m128d t, __m128d *w) {
+        __m128d three = _mm_set1_pd(3);
+        __m128d s = _mm_sub_pd(_mm_set1_pd(1), t);
+        __m128d s2 = _mm_mul_pd(s, s), t2 = _mm_mul_pd(t, t);
+        w[0] = _mm_mul_pd(s2, s);
+        w[1] = _mm_mul_pd(three, _mm_mul_pd(s2, t));
+        w[2] = _mm_mul_pd(three, _mm_mul_pd(s, t2));
+        w[3] = _mm_mul_pd(t2, t);
+    }
+};
+#endif
+
+/* With SSE2, the X and Y coordinates of a point are computed together in one register. */
+template <unsigned degree>
+static void bezier_points_at(D2<Bezier> const &b, Coord const *ts, Point *out, size_t n)
+{
+    Coord w[degree + 1];
+#if defined(__SSE2__)
+    __m128d c[degree + 1];
+    for (unsigned k = 0; k <= degree; ++k) {
+        c[k] = _mm_setr_pd(b[X][k], b[Y][k]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        BezierKernel<degree>::weights(ts[i], w);
+        __m128d p = _mm_mul_pd(c[0], _mm_set1_pd(w[0]));
+        for (unsigned k = 1; k <= degree; ++k) {
+            p = _mm_add_pd(p, _mm_mul_pd(c[k], _mm_set1_pd(w[k])));
+        }
+        _mm_storeu_pd(&out[i][X], p);
+    }
+#else
+    Point c[degree + 1];
+    for (unsigned k = 0; k <= degree; ++k) {
+        c[k] = Point(b[X][k], b[Y][k]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        BezierKernel<degree>::weights(ts[i], w);
+        Point p = w[0] * c[0];
+        for (unsigned k = 1; k <= degree; ++k) {
+            p += w[k] * c[k];
+        }
+        out[i] = p;
+    }
+#endif
+}
+
+/* With SSE2, two time values are processed at once. */
+template <unsigned degree>
+static void bezier_values_at(Bezier const &b, Coord const *ts, Coord *out, size_t n)
+{
+    Coord w[degree + 1];
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128d c[degree + 1], wv[degree + 1];
+    for (unsigned k = 0; k <= degree; ++k) {
+        c[k] = _mm_set1_pd(b[k]);
+    }
+    for (; i + 1 < n; i += 2) {
+        BernsteinWeights<degree>::compute(_mm_loadu_pd(ts + i), wv);
+        __m128d v = _mm_mul_pd(c[0], wv[0]);
+        for (unsigned k = 1; k <= degree; ++k) {
+            v = _mm_add_pd(v, _mm_mul_pd(c[k], wv[k]));
+        }
+        _mm_storeu_pd(out + i, v);
+    }
+#endif
+    for (; i < n; ++i) {
+        BezierKernel<degree>::weights(ts[i], w);
+        Coord v = w[0] * b[0];
+        for (unsigned k = 1; k <= degree; ++k) {
+            v += w[k] * b[k];
+        }
+        out[i] = v;
+    }
+}
+
+template <>
+void BezierCurveN<1>::pointsAt(Coord const *ts, Point *out, size_t n) const {
+    bezier_points_at<1>(inner, ts, out, n);
+}
+template <>
+void BezierCurveN<2>::pointsAt(Coord const *ts, Point *out, size_t n) const {
+    bezier_points_at<2>(inner, ts, out, n);
+}
+template <>
+void BezierCurveN<3>::pointsAt(Coord const *ts, Point *out, size_t n) const {
+    bezier_points_at<3>(inner, ts, out, n);
+}
+
+template <>
+void BezierCurveN<1>::valuesAt(Coord const *ts, Coord *out, size_t n, Dim2 d) const {
+    bezier_values_at<1>(inner[d], ts, out, n);
+}
+template <>
+void BezierCurveN<2>::valuesAt(Coord const *ts, Coord *out, size_t n, Dim2 d) const {
+    bezier_values_at<2>(inner[d], ts, out, n);
+}
+template <>
+void BezierCurveN<3>::valuesAt(Coord const *ts, Coord *out, size_t n, Dim2 d) const {
+    bezier_values_at<3>(inner[d], ts, out, n);
+}
+
+// nearest points on quadratic and cubic Bezier curves
+
+/* The point C(t) is nearest to p where (C(t) - p) . C'(t) = 0. For a curve of degree n,
+ * this is a polynomial of degree 2n - 1, whose Bernstein coefficients are
+ *     f_k = sum over i + j = k of w_ij (P_i - p) . D_j,  w_ij = C(n,i) C(n-1,j) / C(2n-1,k)
+ * with D_j = P_{j+1} - P_j the control points of the derivative, up to a factor n.
+ * They are split into a part that depends only on the curve and a part linear in p,
+ * so that solving for another query point only takes one dot product per coefficient.
+ * Control points are taken relative to the first one to avoid cancellation. */
+template <unsigned degree>
+class BezierNearestPoint {
+public:
+    enum { ORDER = 2 * degree - 1 };
+
+    BezierNearestPoint(D2<Bezier> const &b) {
+        Point d[degree];
+        for (unsigned i = 0; i <= degree; ++i) {
+            _c[i] = Point(b[X][i] - b[X][0], b[Y][i] - b[Y][0]);
+        }
+        for (unsigned j = 0; j < degree; ++j) {
+            d[j] = _c[j+1] - _c[j];
+        }
+        for (unsigned k = 0; k <= ORDER; ++k) {
+            _a[k] = 0;
+            _v[k] = Point(0, 0);
+        }
+        for (unsigned i = 0; i <= degree; ++i) {
+            for (unsigned j = 0; j < degree; ++j) {
+                Coord w = choose<Coord>(degree, i) * choose<Coord>(degree - 1, j)
+                        / choose<Coord>(ORDER, i + j);
+                _a[i+j] += w * dot(_c[i], d[j]);
+                _v[i+j] += w * d[j];
+            }
+        }
+        _origin = Point(b[X][0], b[Y][0]);
+    }
+
+    /* The first time value in [from, to] with the smallest distance, like nearest_point().
+     * The roots vector is only scratch space, passed in to reuse its memory. */
+    Coord solve(Point const &p, Coord from, Coord to, std::vector<Coord> &roots) const {
+        Point q = p - _origin;
+        Coord f[ORDER + 1];
+        for (unsigned k = 0; k <= ORDER; ++k) {
+            f[k] = _a[k] - dot(q, _v[k]);
+        }
+        roots.clear();
+        find_bernstein_roots(f, ORDER, roots, 0, 0, 1);
+
+        Coord best = from;
+        Coord best_dist = distanceSq(q, from);
+        for (unsigned i = 0; i < roots.size(); ++i) {
+            if (roots[i] <= from || roots[i] >= to) continue;
+            Coord dist = distanceSq(q, roots[i]);
+            if (dist < best_dist) {
+                best = roots[i];
+                best_dist = dist;
+            }
+        }
+        if (distanceSq(q, to) < best_dist) {
+            best = to;
+        }
+        return best;
+    }
+
+private:
+    Coord distanceSq(Point const &q, Coord t) const {
+        Coord w[degree + 1];
+        BezierKernel<degree>::weights(t, w);
+        Point c = w[0] * _c[0];
+        for (unsigned k = 1; k <= degree; ++k) {
+            c += w[k] * _c[k];
+        }
+        return L2sq(c - q);
+    }
+
+    Point _c[degree + 1];
+    Coord _a[ORDER + 1];
+    Point _v[ORDER + 1];
+    Point _origin;
+};
+
+static void check_nearest_interval(Coord &from, Coord &to)
+{
+    if (from > to) std::swap(from, to);
+    if (from < 0 || to > 1) {
+        THROW_RANGEERROR("[from,to] interval out of bounds");
+    }
+}
+
+template <unsigned degree>
+static void bezier_nearest_points(D2<Bezier> const &b, Point const *ps, Coord *out, size_t n,
+                                  Coord from, Coord to)
+{
+    check_nearest_interval(from, to);
+    BezierNearestPoint<degree> np(b);
+    std::vector<Coord> roots;
+    roots.reserve(BezierNearestPoint<degree>::ORDER);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = np.solve(ps[i], from, to, roots);
+    }
+}
+
+template <>
+Coord BezierCurveN<2>::nearestPoint(Point const &p, Coord from, Coord to) const {
+    Coord t;
+    bezier_nearest_points<2>(inner, &p, &t, 1, from, to);
+    return t;
+}
+template <>
+Coord BezierCurveN<3>::nearestPoint(Point const &p, Coord from, Coord to) const {
+    Coord t;
+    bezier_nearest_points<3>(inner, &p, &t, 1, from, to);
+    return t;
+}
+
+template <>
+void BezierCurveN<2>::nearestPoints(Point const *ps, Coord *out, size_t n,
+                                    Coord from, Coord to) const {
+    bezier_nearest_points<2>(inner, ps, out, n, from, to);
+}
+template <>
+void BezierCurveN<3>::nearestPoints(Point const *ps, Coord *out, size_t n,
+                                    Coord from, Coord to) const {
+    bezier_nearest_points<3>(inner, ps, out, n, from, to);
+}
+
 static Coord bezier_length_internal(std::vector<Point> &v1, Coord tolerance)
 {
     /* The Bezier length algorithm used in 2Geom utilizes a simple fact:
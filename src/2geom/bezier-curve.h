@@ -133,13 +133,25 @@ public:
     virtual int degreesOfFreedom() const {
         return 2 * (order() + 1);
     }
+    virtual bool operator==(Curve const &c) const;
     virtual std::vector<Coord> roots(Coord v, Dim2 d) const {
         return (inner[d] - v).roots();
     }
     virtual Coord length(Coord tolerance) const;
     virtual Point pointAt(Coord t) const { return inner.valueAt(t); }
     virtual std::vector<Point> pointAndDerivatives(Coord t, unsigned n) const { return inner.valueAndDerivatives(t, n); }
+    virtual Point pointAndDerivative(Coord t, Point &deriv) const { return inner.valueAndDerivative(t, deriv); }
     virtual Coord valueAt(Coord t, Dim2 d) const { return inner[d].valueAt(t); }
+    virtual void pointsAt(Coord const *ts, Point *out, size_t n) const {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = inner.valueAt(ts[i]);
+        }
+    }
+    virtual void valuesAt(Coord const *ts, Coord *out, size_t n, Dim2 d) const {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = inner[d].valueAt(ts[i]);
+        }
+    }
     virtual D2<SBasis> toSBasis() const {return inner.toSBasis(); }
 #endif
 };
@@ -211,10 +223,12 @@ public:
      *         \f$\mathbf{D}[ [0,1] ] = \mathbf{C}[ [0,t] ]\f$ and
      *         \f$\mathbf{E}[ [0,1] ] = \mathbf{C}[ [t,1] ]\f$ */
     std::pair<BezierCurveN, BezierCurveN> subdivide(Coord t) const {
-        std::pair<Bezier, Bezier> sx = inner[X].subdivide(t), sy = inner[Y].subdivide(t);
-        return std::make_pair(
-                   BezierCurveN(sx.first, sy.first),
-                   BezierCurveN(sx.second, sy.second));
+        std::pair<BezierCurveN, BezierCurveN> ret;
+        for (unsigned d = 0; d < 2; ++d) {
+            BezierKernel<degree>::subdivide(&inner[d][0], t,
+                                            &ret.first.inner[d][0], &ret.second.inner[d][0]);
+        }
+        return ret;
     }
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -225,7 +239,11 @@ public:
         if (degree == 1) {
             return new BezierCurveN<1>(pointAt(f), pointAt(t));
         } else {
-            return new BezierCurveN(Geom::portion(inner, f, t));
+            BezierCurveN *ret = new BezierCurveN();
+            for (unsigned d = 0; d < 2; ++d) {
+                BezierKernel<degree>::portion(&inner[d][0], f, t, &ret->inner[d][0]);
+            }
+            return ret;
         }
     }
     virtual Curve *reverse() const {
@@ -249,11 +267,28 @@ public:
         }
     }
     virtual Curve *derivative() const;
-    
-    // the method below is defined so that LineSegment can specialize it
+    virtual Rect boundsExact() const {
+        return Rect(BezierKernel<degree>::bounds(&inner[X][0]),
+                    BezierKernel<degree>::bounds(&inner[Y][0]));
+    }
+    virtual Point pointAt(Coord t) const {
+        return Point(BezierKernel<degree>::valueAt(&inner[X][0], t),
+                     BezierKernel<degree>::valueAt(&inner[Y][0], t));
+    }
+    virtual Coord valueAt(Coord t, Dim2 d) const {
+        return BezierKernel<degree>::valueAt(&inner[d][0], t);
+    }
+    virtual void pointsAt(Coord const *ts, Point *out, size_t n) const;
+    virtual void valuesAt(Coord const *ts, Coord *out, size_t n, Dim2 d) const;
+
+    // the methods below are defined so that LineSegment and low degrees can specialize them
     virtual Coord nearestPoint(Point const& p, Coord from = 0, Coord to = 1) const {
         return Curve::nearestPoint(p, from, to);
     }
+    virtual void nearestPoints(Point const *ps, Coord *out, size_t n,
+                               Coord from = 0, Coord to = 1) const {
+        Curve::nearestPoints(ps, out, n, from, to);
+    }
 #endif
 };
 
@@ -280,10 +315,36 @@ Curve *BezierCurveN<degree>::derivative() const {
     return new BezierCurveN<degree-1>(Geom::derivative(inner[X]), Geom::derivative(inner[Y]));
 }
 
+template <unsigned degree>
+inline
+void BezierCurveN<degree>::pointsAt(Coord const *ts, Point *out, size_t n) const {
+    BezierCurve::pointsAt(ts, out, n);
+}
+
+template <unsigned degree>
+inline
+void BezierCurveN<degree>::valuesAt(Coord const *ts, Coord *out, size_t n, Dim2 d) const {
+    BezierCurve::valuesAt(ts, out, n, d);
+}
+
 // optimized specializations for LineSegment
 template <> Curve *BezierCurveN<1>::derivative() const;
 template <> Coord BezierCurveN<1>::nearestPoint(Point const &, Coord, Coord) const;
 
+// nearest points found by solving the distance derivative in Bernstein form
+template <> Coord BezierCurveN<2>::nearestPoint(Point const &, Coord, Coord) const;
+template <> Coord BezierCurveN<3>::nearestPoint(Point const &, Coord, Coord) const;
+template <> void BezierCurveN<2>::nearestPoints(Point const *, Coord *, size_t, Coord, Coord) const;
+template <> void BezierCurveN<3>::nearestPoints(Point const *, Coord *, size_t, Coord, Coord) const;
+
+// batch evaluation with the degree known at compile time
+template <> void BezierCurveN<1>::pointsAt(Coord const *, Point *, size_t) const;
+template <> void BezierCurveN<2>::pointsAt(Coord const *, Point *, size_t) const;
+template <> void BezierCurveN<3>::pointsAt(Coord const *, Point *, size_t) const;
+template <> void BezierCurveN<1>::valuesAt(Coord const *, Coord *, size_t, Dim2) const;
+template <> void BezierCurveN<2>::valuesAt(Coord const *, Coord *, size_t, Dim2) const;
+template <> void BezierCurveN<3>::valuesAt(Coord const *, Coord *, size_t, Dim2) const;
+
 inline Point middle_point(LineSegment const& _segment) {
     return ( _segment.initialPoint() + _segment.finalPoint() ) / 2;
 }
@@ -38,17 +38,239 @@
 #define LIB2GEOM_SEEN_BEZIER_H
 
 #include <valarray>
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <2geom/coord.h>
 #include <2geom/choose.h>
-#include <valarray>
 #include <2geom/math-utils.h>
 #include <2geom/d2.h>
 #include <2geom/solver.h>
 
 namespace Geom {
 
+/* Coefficient array of a Bezier. Up to INLINE_SIZE coefficients (order 7) are
+ * stored inside the object, so low order Beziers and the temporaries created
+ * when working with them never touch the heap. */
+class BezierCoeffs {
+public:
+    enum { INLINE_SIZE = 8 };
+
+    BezierCoeffs() : size_(0) {}
+    BezierCoeffs(Coord v, unsigned n) : size_(0) { resize(n, v); }
+    BezierCoeffs(Coord const *c, unsigned n) : size_(0) {
+        allocate(n);
+        std::copy(c, c + n, data());
+    }
+    BezierCoeffs(BezierCoeffs const &other) : size_(0) {
+        allocate(other.size_);
+        std::copy(other.data(), other.data() + size_, data());
+    }
+    BezierCoeffs &operator=(BezierCoeffs const &other) {
+        if (this != &other) {
+            if (size_ != other.size_) {
+                release();
+                allocate(other.size_);
+            }
+            std::copy(other.data(), other.data() + size_, data());
+        }
+        return *this;
+    }
+    ~BezierCoeffs() { release(); }
+
+    unsigned size() const { return size_; }
+    Coord *data() { return size_ <= INLINE_SIZE ? inline_ : heap_; }
+    Coord const *data() const { return size_ <= INLINE_SIZE ? inline_ : heap_; }
+    Coord &operator[](unsigned i) { return data()[i]; }
+    Coord const &operator[](unsigned i) const { return data()[i]; }
+
+    /// Like std::valarray::resize(), sets all coefficients to @a v.
+    void resize(unsigned n, Coord v = 0) {
+        if (n != size_) {
+            release();
+            allocate(n);
+        }
+        std::fill(data(), data() + n, v);
+    }
+
+private:
+    void allocate(unsigned n) {
+        if (n > INLINE_SIZE) {
+            heap_ = new Coord[n];
+        }
+        size_ = n;
+    }
+    void release() {
+        if (size_ > INLINE_SIZE) {
+            delete[] heap_;
+        }
+        size_ = 0;
+    }
+
+    unsigned size_;
+    union {
+        Coord inline_[INLINE_SIZE];
+        Coord *heap_;
+    };
+};
+
+/* Kernels for Bezier polynomials whose order is known at compile time. Their loops have
+ * constant trip counts and, for orders 1 to 3, the binomial coefficients are literals, so
+ * the compiler unrolls them completely. BezierCurveN calls them directly; the functions
+ * below that take the order at runtime dispatch to them for orders 1 to 3. */
+template <unsigned order>
+struct BezierKernel {
+    /// The Bernstein basis polynomials of this order at t.
+    static void weights(Coord t, Coord *w) {
+        Coord s = 1 - t;
+        for (unsigned k = 0; k <= order; ++k) {
+            w[k] = choose<Coord>(order, k) * std::pow(t, Coord(k)) * std::pow(s, Coord(order - k));
+        }
+    }
+
+    /* The sum of the coefficients weighted by the basis polynomials, which takes fewer
+     * operations than de Casteljau's algorithm and returns the ends exactly at 0 and 1. */
+    static Coord valueAt(Coord const *c, Coord t) {
+        Coord w[order + 1];
+        weights(t, w);
+        Coord v = w[0] * c[0];
+        for (unsigned k = 1; k <= order; ++k) {
+            v += w[k] * c[k];
+        }
+        return v;
+    }
+
+    /** @brief Split at t with de Casteljau's algorithm.
+     * Either output may be NULL, and may be the same array as the input.
+     * @return The value at t */
+    static Coord subdivide(Coord const *c, Coord t, Coord *left, Coord *right) {
+        Coord row[order + 1];
+        std::copy(c, c + order + 1, row);
+        Coord const omt = 1 - t;
+        if (left) left[0] = row[0];
+        if (right) right[order] = row[order];
+        for (unsigned i = 1; i <= order; ++i) {
+            for (unsigned j = 0; j <= order - i; ++j) {
+                row[j] = omt*row[j] + t*row[j+1];
+            }
+            if (left) left[i] = row[0];
+            if (right) right[order-i] = row[order-i];
+        }
+        return row[0];
+    }
+
+    /// The part between from and to, written to out, which may be the input.
+    static void portion(Coord const *c, Coord from, Coord to, Coord *out) {
+        if (from == 0) {
+            if (to == 1) {
+                std::copy(c, c + order + 1, out);
+            } else {
+                subdivide(c, to, out, NULL);
+            }
+            return;
+        }
+        subdivide(c, from, NULL, out);
+        if (to != 1) {
+            subdivide(out, (to - from) / (1 - from), out, NULL);
+        }
+    }
+
+    /// Writes the order coefficients of the derivative.
+    static void derivative(Coord const *c, Coord *d) {
+        for (unsigned i = 0; i < order; ++i) {
+            d[i] = order * (c[i+1] - c[i]);
+        }
+    }
+
+    /// Writes the order + 2 coefficients of the same polynomial of the next order.
+    static void elevate(Coord const *c, Coord *e) {
+        unsigned const n = order + 1;
+        e[0] = c[0];
+        e[n] = c[n-1];
+        for (unsigned i = 1; i < n; ++i) {
+            e[i] = (i*c[i-1] + (n - i)*c[i]) / n;
+        }
+    }
+
+    /// The exact range over [0, 1].
+    static Interval bounds(Coord const *c);
+};
+
+template <>
+inline void BezierKernel<1>::weights(Coord t, Coord *w) {
+    w[0] = 1 - t;
+    w[1] = t;
+}
+
+template <>
+inline void BezierKernel<2>::weights(Coord t, Coord *w) {
+    Coord s = 1 - t;
+    w[0] = s * s;
+    w[1] = 2 * s * t;
+    w[2] = t * t;
+}
+
+template <>
+inline void BezierKernel<3>::weights(Coord t, Coord *w) {
+    Coord s = 1 - t;
+    Coord s2 = s * s, t2 = t * t;
+    w[0] = s2 * s;
+    w[1] = 3 * s2 * t;
+    w[2] = 3 * s * t2;
+    w[3] = t2 * t;
+}
+
+template <>
+inline Interval BezierKernel<1>::bounds(Coord const *c) {
+    return Interval(c[0], c[1]);
+}
+
+template <>
+inline Interval BezierKernel<2>::bounds(Coord const *c) {
+    Interval ret(c[0], c[2]);
+    if (ret.contains(c[1])) return ret;
+    // the extremum is where the linear derivative (c1 - c0)(1 - t) + (c2 - c1) t vanishes
+    Coord t = (c[0] - c[1]) / (c[0] - 2 * c[1] + c[2]);
+    if (t > 0 && t < 1) {
+        ret.expandTo(valueAt(c, t));
+    }
+    return ret;
+}
+
+template <>
+inline Interval BezierKernel<3>::bounds(Coord const *c) {
+    Interval ret(c[0], c[3]);
+    if (ret.contains(c[1]) && ret.contains(c[2])) return ret;
+    // extrema are at the roots of the quadratic derivative A t^2 + B t + C
+    Coord a = c[1] - c[0], b = c[2] - c[1], d = c[3] - c[2];
+    Coord A = a - 2 * b + d, B = 2 * (b - a), C = a;
+    Coord ts[2];
+    unsigned n = 0;
+    if (A == 0) {
+        if (B != 0) ts[n++] = -C / B;
+    } else {
+        Coord disc = B * B - 4 * A * C;
+        if (disc >= 0) {
+            Coord q = -0.5 * (B + (B < 0 ? -1 : 1) * std::sqrt(disc));
+            ts[n++] = q / A;
+            if (q != 0) ts[n++] = C / q;
+        }
+    }
+    for (unsigned i = 0; i < n; ++i) {
+        if (ts[i] > 0 && ts[i] < 1) {
+            ret.expandTo(valueAt(c, ts[i]));
+        }
+    }
+    return ret;
+}
+
 inline Coord subdivideArr(Coord t, Coord const *v, Coord *left, Coord *right, unsigned order) {
+    switch (order) {
+    case 1: return BezierKernel<1>::subdivide(v, t, left, right);
+    case 2: return BezierKernel<2>::subdivide(v, t, left, right);
+    case 3: return BezierKernel<3>::subdivide(v, t, left, right);
+    default: break;
+    }
+
 /*
  *  Bernstein : 
  *	Evaluate a Bernstein function at a particular parameter value
@@ -57,9 +279,7 @@ inline Coord subdivideArr(Coord t, Coord const *v, Coord *left, Coord *right, un
  */
 
     unsigned N = order+1;
-    std::valarray<Coord> row(N);
-    for (unsigned i = 0; i < N; i++)
-        row[i] = v[i];
+    BezierCoeffs row(v, N);
 
     // Triangle computation
     const double omt = (1-t);
@@ -113,14 +333,25 @@ inline T bernsteinValueAt(double t, T const *c_, unsigned n) {
     return (tmp + tn*t*c_[n]);
 }
 
+inline Coord bezier_value_at(Coord const *c, unsigned order, Coord t) {
+    switch (order) {
+    case 1: return BezierKernel<1>::valueAt(c, t);
+    case 2: return BezierKernel<2>::valueAt(c, t);
+    case 3: return BezierKernel<3>::valueAt(c, t);
+    default: return bernsteinValueAt(t, c, order);
+    }
+}
+
 class Bezier {
 private:
-    std::valarray<Coord> c_;
+    BezierCoeffs c_;
 
     friend Bezier portion(const Bezier & a, Coord from, Coord to);
 
     friend OptInterval bounds_fast(Bezier const & b);
 
+    friend OptInterval bounds_exact(Bezier const & b);
+
     friend Bezier derivative(const Bezier & a);
 
     friend class Bernstein;
@@ -141,9 +372,6 @@ public:
     Bezier() {}
     Bezier(const Bezier& b) :c_(b.c_) {}
     Bezier &operator=(Bezier const &other) {
-        if ( c_.size() != other.c_.size() ) {
-            c_.resize(other.c_.size());
-        }
         c_ = other.c_;
         return *this;
     }
@@ -215,28 +443,33 @@ public:
     inline Coord at1() const { return c_[order()]; }
 
     inline Coord valueAt(double t) const {
+        return bezier_value_at(c_.data(), order(), t);
+    }
+    inline Coord operator()(double t) const { return valueAt(t); }
+    /// Evaluate the polynomial and its first derivative without allocating memory.
+    Coord valueAndDerivative(Coord t, Coord &der) const {
         int n = order();
-        double u, bc, tn, tmp;
-        int i;
-        u = 1.0 - t;
-        bc = 1;
-        tn = 1;
-        tmp = c_[0]*u;
-        for(i=1; i<n; i++){
+        if (n == 0) {
+            der = 0;
+            return c_[0];
+        }
+        // the derivative has the coefficients n (c_[i+1] - c_[i]) of order n-1
+        double u = 1.0 - t, bc = 1, tn = 1;
+        double tmp = (c_[1] - c_[0])*u;
+        for(int i = 1; i < n-1; i++){
             tn = tn*t;
-            bc = bc*(n-i+1)/i;
-            tmp = (tmp + tn*bc*c_[i])*u;
+            bc = bc*(n-i)/i;
+            tmp = (tmp + tn*bc*(c_[i+1] - c_[i]))*u;
         }
-        return (tmp + tn*t*c_[n]);
+        der = n * (tmp + tn*t*(c_[n] - c_[n-1]));
+        return valueAt(t);
     }
-    inline Coord operator()(double t) const { return valueAt(t); }
 
     SBasis toSBasis() const;
 
     //Only mutator
     inline Coord &operator[](unsigned ix) { return c_[ix]; }
-    inline Coord const &operator[](unsigned ix) const { return const_cast<std::valarray<Coord>&>(c_)[ix]; }
-    //inline Coord const &operator[](unsigned ix) const { return c_[ix]; }
+    inline Coord const &operator[](unsigned ix) const { return c_[ix]; }
     inline void setPoint(unsigned ix, double val) { c_[ix] = val; }
 
     /**
@@ -250,10 +483,7 @@ public:
         std::vector<Coord> val_n_der(n_derivs + 1, Coord(0.0));
 
         // initialize temp storage variables
-        std::valarray<Coord> d_(order()+1);
-        for(unsigned i = 0; i < size(); i++) {
-            d_[i] = c_[i];
-        }
+        BezierCoeffs d_(c_);
 
         unsigned nn = n_derivs + 1;
         if(n_derivs > order()) {
@@ -261,7 +491,7 @@ public:
         }
         for(unsigned di = 0; di < nn; di++) {
             //val_n_der[di] = (subdivideArr(t, &d_[0], NULL, NULL, order() - di));
-            val_n_der[di] = bernsteinValueAt(t, &d_[0], order() - di);
+            val_n_der[di] = bezier_value_at(d_.data(), order() - di, t);
             for(unsigned i = 0; i < order() - di; i++) {
                 d_[i] = (order()-di)*(d_[i+1] - d_[i]);
             }
@@ -272,7 +502,7 @@ public:
 
     std::pair<Bezier, Bezier > subdivide(Coord t) const {
         Bezier a(Bezier::Order(*this)), b(Bezier::Order(*this));
-        subdivideArr(t, &const_cast<std::valarray<Coord>&>(c_)[0], &a.c_[0], &b.c_[0], order());
+        subdivideArr(t, c_.data(), a.c_.data(), b.c_.data(), order());
         return std::pair<Bezier, Bezier >(a, b);
     }
 
@@ -283,7 +513,7 @@ public:
     }
     std::vector<double> roots(Interval const ivl) const {
         std::vector<double> solutions;
-        find_bernstein_roots(&const_cast<std::valarray<Coord>&>(c_)[0], order(), solutions, 0, ivl.min(), ivl.max());
+        find_bernstein_roots(const_cast<Coord *>(c_.data()), order(), solutions, 0, ivl.min(), ivl.max());
         return solutions;
     }
 
@@ -302,6 +532,12 @@ public:
   
     Bezier elevate_degree() const {
         Bezier ed(Order(order()+1));
+        switch (order()) {
+        case 1: BezierKernel<1>::elevate(c_.data(), ed.c_.data()); return ed;
+        case 2: BezierKernel<2>::elevate(c_.data(), ed.c_.data()); return ed;
+        case 3: BezierKernel<3>::elevate(c_.data(), ed.c_.data()); return ed;
+        default: break;
+        }
         unsigned n = size();
         ed[0] = c_[0];
         ed[n] = c_[n-1];
@@ -414,17 +650,17 @@ inline Bezier reverse(const Bezier & a) {
 
 inline Bezier portion(const Bezier & a, double from, double to) {
     //TODO: implement better?
-    std::valarray<Coord> res(a.order() + 1);
+    Bezier res = Bezier(Bezier::Order(a));
     if(from == 0) {
         if(to == 1) { return Bezier(a); }
-        subdivideArr(to, &const_cast<Bezier&>(a).c_[0], &res[0], NULL, a.order());
-        return Bezier(&res[0], a.order());
-    }
-    subdivideArr(from, &const_cast<Bezier&>(a).c_[0], NULL, &res[0], a.order());
-    if(to == 1) return Bezier(&res[0], a.order());
-    std::valarray<Coord> res2(a.order()+1);
-    subdivideArr((to - from)/(1 - from), &res[0], &res2[0], NULL, a.order());
-    return Bezier(&res2[0], a.order());
+        subdivideArr(to, a.c_.data(), res.c_.data(), NULL, a.order());
+        return res;
+    }
+    subdivideArr(from, a.c_.data(), NULL, res.c_.data(), a.order());
+    if(to == 1) return res;
+    Bezier res2 = Bezier(Bezier::Order(a));
+    subdivideArr((to - from)/(1 - from), res.c_.data(), res2.c_.data(), NULL, a.order());
+    return res2;
 }
 
 // XXX Todo: how to handle differing orders
@@ -442,6 +678,11 @@ inline Bezier derivative(const Bezier & a) {
     //if(a.order() == 1) return Bezier(0.0);
     if(a.order() == 1) return Bezier(a.c_[1]-a.c_[0]);
     Bezier der(Bezier::Order(a.order()-1));
+    switch (a.order()) {
+    case 2: BezierKernel<2>::derivative(a.c_.data(), der.c_.data()); return der;
+    case 3: BezierKernel<3>::derivative(a.c_.data(), der.c_.data()); return der;
+    default: break;
+    }
 
     for(unsigned i = 0; i < a.order(); i++) {
         der.c_[i] = a.order()*(a.c_[i+1] - a.c_[i]);
@@ -460,13 +701,25 @@ inline Bezier integral(const Bezier & a) {
 }
 
 inline OptInterval bounds_fast(Bezier const & b) {
-    OptInterval ret = Interval::from_array(&const_cast<Bezier&>(b).c_[0], b.size());
+    OptInterval ret = Interval::from_array(b.c_.data(), b.size());
     return ret;
 }
 
-//TODO: better bounds exact
 inline OptInterval bounds_exact(Bezier const & b) {
-    return bounds_exact(b.toSBasis());
+    switch (b.order()) {
+    case 1: return BezierKernel<1>::bounds(b.c_.data());
+    case 2: return BezierKernel<2>::bounds(b.c_.data());
+    case 3: return BezierKernel<3>::bounds(b.c_.data());
+    default: return bounds_exact(b.toSBasis());
+    }
+}
+
+// higher orders go through the S-basis, like bounds_exact()
+template <unsigned order>
+inline Interval BezierKernel<order>::bounds(Coord const *c) {
+    Bezier b = Bezier(Bezier::Order(order));
+    std::copy(c, c + order + 1, &b[0]);
+    return *bounds_exact(b.toSBasis());
 }
 
 inline OptInterval bounds_local(Bezier const & b, OptInterval i) {
@@ -33,6 +33,7 @@
 #define LIB2GEOM_SEEN_CHOOSE_H
 
 #include <vector>
+#include <algorithm>
 
 namespace Geom {
 
@@ -41,32 +42,52 @@ namespace Geom {
 // row index becomes n2 = n/2, row2 = n2*(n2+1)/2, row = row2*2+(n&1)?n2:0
 // we could also leave off the ones
 
+/* The first rows of Pascal's triangle, built once and never modified afterwards,
+ * so that choose() can be called from several threads at once.  The table is
+ * summed up in unsigned long long, which holds every entry of the first 64 rows
+ * exactly, and converted to T on lookup; building it in T would overflow a small
+ * integer type even when only the first rows are asked for. */
+template <typename T>
+class PascalsTriangle {
+public:
+    enum { ROWS = 64 };
+
+    PascalsTriangle() {
+        // indexing is (0,0,), (1,0), (1,1), (2, 0)...
+        // to get (i, j) i*(i+1)/2 + j
+        _t.reserve(ROWS * (ROWS + 1) / 2);
+        _t.push_back(1);
+        for(unsigned n = 1; n < ROWS; n++) {
+            unsigned p = _t.size() - n;
+            _t.push_back(1);
+            for(unsigned i = 0; i < n-1; i++) {
+                _t.push_back(_t[p] + _t[p+1]);
+                p++;
+            }
+            _t.push_back(1);
+        }
+    }
+    T operator()(unsigned n, unsigned k) const { return T(_t[(n*(n+1))/2 + k]); }
+
+private:
+    std::vector<unsigned long long> _t;
+};
+
 template <typename T>
 T choose(unsigned n, unsigned k) {
-    static std::vector<T> pascals_triangle;
-    static unsigned rows_done = 0;
-    // indexing is (0,0,), (1,0), (1,1), (2, 0)...
-    // to get (i, j) i*(i+1)/2 + j
     if(/*k < 0 ||*/ k > n) return 0;
-    if(rows_done <= n) {// we haven't got there yet
-        if(rows_done == 0) {
-            pascals_triangle.push_back(1);
-            rows_done = 1;
-        }
-        while(rows_done <= n) {
-            unsigned p = pascals_triangle.size() - rows_done;
-            pascals_triangle.push_back(1);
-            for(unsigned i = 0; i < rows_done-1; i++) {
-                pascals_triangle.push_back(pascals_triangle[p]
-                                           + pascals_triangle[p+1]);
-		p++;
-            }
-            pascals_triangle.push_back(1);
-            rows_done ++;
+    static PascalsTriangle<T> const pascals_triangle;
+    if(n < PascalsTriangle<T>::ROWS) return pascals_triangle(n, k);
+
+    // rarely needed, so sum up the rows on the spot instead of caching them
+    std::vector<T> row(k+1, 0);
+    row[0] = 1;
+    for(unsigned i = 1; i <= n; i++) {
+        for(unsigned j = std::min(i, k); j > 0; j--) {
+            row[j] += row[j-1];
         }
     }
-    unsigned row = (n*(n+1))/2;
-    return pascals_triangle[row+k];
+    return row[k];
 }
 
 // Is it faster to store them or compute them on demand?
@@ -109,17 +109,15 @@ CrossingGraph create_crossing_graph(std::vector<Path> const &p, Crossings const
 struct NearF { bool operator()(Crossing a, Crossing b) { return are_near(a, b); } };
 */
 
+/* Orders crossings by their time on path ix: earliest first, or latest first
+ * when rev is set. */
 struct CrossingOrder {
     unsigned ix;
     bool rev;
     CrossingOrder(unsigned i, bool r = false) : ix(i), rev(r) {}
     bool operator()(Crossing a, Crossing b) {
-        if(rev) 
-            return (ix == a.a ? a.ta : a.tb) <
-                   (ix == b.a ? b.ta : b.tb);
-        else
-            return (ix == a.a ? a.ta : a.tb) >
-                   (ix == a.a ? a.ta : a.tb);
+        Coord ta = ix == a.a ? a.ta : a.tb, tb = ix == b.a ? b.ta : b.tb;
+        return rev ? ta > tb : ta < tb;
     }
 };
 
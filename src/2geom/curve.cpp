@@ -80,11 +80,39 @@ int CurveHelpers::root_winding(Curve const &c, Point p) {
     return wind;
 }
 
+void Curve::pointsAt(Coord const *ts, Point *out, size_t n) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = pointAt(ts[i]);
+    }
+}
+
+void Curve::valuesAt(Coord const *ts, Coord *out, size_t n, Dim2 d) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = valueAt(ts[i], d);
+    }
+}
+
 Coord Curve::nearestPoint(Point const& p, Coord a, Coord b) const
 {
     return nearest_point(p, toSBasis(), a, b);
 }
 
+Point Curve::pointAndDerivative(Coord t, Point &deriv) const
+{
+    std::vector<Point> pd = pointAndDerivatives(t, 1);
+    deriv = pd.size() > 1 ? pd[1] : Point(0, 0);
+    return pd[0];
+}
+
+void Curve::nearestPoints(Point const *ps, Coord *out, size_t n, Coord a, Coord b) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = nearestPoint(ps[i], a, b);
+    }
+}
+
 std::vector<Coord> Curve::allNearestPoints(Point const& p, Coord from, Coord to) const
 {
     return all_nearest_points(p, toSBasis(), from, to);
@@ -103,6 +103,22 @@ public:
      * @param d The dimension to evaluate
      * @return The specified coordinate of \f$\mathbf{C}(t)\f$ */
     virtual Coord valueAt(Coord t, Dim2 d) const { return pointAt(t)[d]; }
+    /** @brief Evaluate the curve at many time values.
+     * Gives the points that calling pointAt() for each value gives, up to rounding error,
+     * but without a virtual call per sample. Bezier curves of order up to 3 use vectorized
+     * code, which may differ from pointAt() in the last bits.
+     * @param ts Array of n time values
+     * @param out Array of n points that receives the results
+     * @param n Number of time values */
+    virtual void pointsAt(Coord const *ts, Point *out, size_t n) const;
+    /** @brief Evaluate one of the coordinates at many time values.
+     * The values match valueAt() up to rounding error.
+     * @see pointsAt()
+     * @param ts Array of n time values
+     * @param out Array of n values that receives the results
+     * @param n Number of time values
+     * @param d The dimension to evaluate */
+    virtual void valuesAt(Coord const *ts, Coord *out, size_t n, Dim2 d) const;
     /** @brief Evaluate the function at the specified time value. Allows curves to be used
      * as functors. */
     virtual Point operator() (Coord t)  const { return pointAt(t); }
@@ -115,6 +131,13 @@ public:
      * @return Vector of at most \f$n+1\f$ elements of the form \f$[\mathbf{C}(t),
         \mathbf{C}'(t), \mathbf{C}''(t), \ldots]\f$ */
     virtual std::vector<Point> pointAndDerivatives(Coord t, unsigned n) const = 0;
+    /** @brief Evaluate the curve and its first derivative.
+     * Unlike pointAndDerivatives(), this does not allocate memory for the curves
+     * that come with 2Geom.
+     * @param t Time value
+     * @param deriv Receives \f$\mathbf{C}'(t)\f$
+     * @return \f$\mathbf{C}(t)\f$ */
+    virtual Point pointAndDerivative(Coord t, Point &deriv) const;
     /// @}
 
     /// @name Change the curve's endpoints
@@ -210,6 +233,16 @@ public:
     Coord nearestPoint(Point const &p, Interval const &i) const {
         return nearestPoint(p, i.min(), i.max());
     }
+    /** @brief Compute the nearest time values for many query points.
+     * Gives the same results as calling nearestPoint() for each point. Quadratic and cubic
+     * Bezier curves prepare their distance polynomial once for all the points.
+     * @param ps Array of n query points
+     * @param out Array of n time values that receives the results
+     * @param n Number of query points
+     * @param a Minimum time value to consider
+     * @param b Maximum time value to consider */
+    virtual void nearestPoints(Point const *ps, Coord *out, size_t n,
+                               Coord a = 0, Coord b = 1) const;
     /** @brief Compute time values at which the curve comes closest to a specified point.
      * @param p Query point
      * @param a Minimum time value to consider
@@ -272,6 +305,8 @@ public:
      * multiplied by 2. */
     virtual int degreesOfFreedom() const { return 0;}
     /** @brief Test equality of two curves.
+     * Bezier curves, elliptical arcs and S-basis curves compare their defining
+     * parameters; other curves are only equal to themselves.
      * @return True if the curves are identical, false otherwise */
     virtual bool operator==(Curve const &c) const { return this == &c;}
     /// @}
@@ -96,6 +96,12 @@ class D2{
         boost::function_requires<FragmentConcept<T> >();
         return (*this)(t);
     }
+    Point valueAndDerivative(double t, Point &der) const {
+        Coord dx, dy;
+        Coord x = f[X].valueAndDerivative(t, dx), y = f[Y].valueAndDerivative(t, dy);
+        der = Point(dx, dy);
+        return Point(x, y);
+    }
     std::vector<Point > valueAndDerivatives(double t, unsigned n) const {
         std::vector<Coord> x = f[X].valueAndDerivatives(t, n),
                            y = f[Y].valueAndDerivatives(t, n); // always returns a vector of size n+1
@@ -39,6 +39,7 @@
 #include <2geom/sbasis-geometric.h>
 #include <2geom/bezier-curve.h>
 #include <2geom/poly.h>
+#include <2geom/quadrature.h>
 #include <2geom/transforms.h>
 #include <2geom/utils.h>
 
@@ -91,68 +92,132 @@ namespace Geom
  * @ingroup Curves
  */
 
+/* Bounds of the points Point::polar(angle) * m for the angles swept from the given one,
+ * which map to the points ip and fp. Each coordinate has two extremes on the whole
+ * ellipse, and it is enough to check which of them the sweep goes through. */
+static Rect ellipse_part_bounds(Affine const &m, Coord from, Coord span, bool sweep,
+                                Point const &ip, Point const &fp)
+{
+    Rect ret(ip, fp);
+    for (unsigned d = 0; d < 2; ++d) {
+        // the coordinate is m[d] cos(a) + m[d+2] sin(a) + m[d+4]
+        Coord extreme = std::atan2(m[d+2], m[d]);
+        for (unsigned k = 0; k < 2; ++k, extreme += M_PI) {
+            Coord dist = std::fmod(sweep ? extreme - from : from - extreme, 2*M_PI);
+            if (dist < 0) dist += 2*M_PI;
+            if (dist <= span) {
+                Coord s, c;
+                sincos(extreme, s, c);
+                ret[d].expandTo(m[d] * c + m[d+2] * s + m[d+4]);
+            }
+        }
+    }
+    return ret;
+}
+
 Rect EllipticalArc::boundsExact() const
 {
-    double extremes[4];
-    double sinrot, cosrot;
-    sincos(_rot_angle, sinrot, cosrot);
+    return ellipse_part_bounds(_unit_circle, initialAngle(), sweepAngle(), _sweep,
+                               initialPoint(), finalPoint());
+}
 
-    extremes[0] = std::atan2( -ray(Y) * sinrot, ray(X) * cosrot );
-    extremes[1] = extremes[0] + M_PI;
-    if ( extremes[0] < 0 ) extremes[0] += 2*M_PI;
-    extremes[2] = std::atan2( ray(Y) * cosrot, ray(X) * sinrot );
-    extremes[3] = extremes[2] + M_PI;
-    if ( extremes[2] < 0 ) extremes[2] += 2*M_PI;
-
-
-    double arc_extremes[4];
-    arc_extremes[0] = initialPoint()[X];
-    arc_extremes[1] = finalPoint()[X];
-    if ( arc_extremes[0] < arc_extremes[1] )
-        std::swap(arc_extremes[0], arc_extremes[1]);
-    arc_extremes[2] = initialPoint()[Y];
-    arc_extremes[3] = finalPoint()[Y];
-    if ( arc_extremes[2] < arc_extremes[3] )
-        std::swap(arc_extremes[2], arc_extremes[3]);
-
-    for (unsigned i = 0; i < 4; ++i) {
-        if (containsAngle(extremes[i])) {
-            arc_extremes[i] = valueAtAngle(extremes[i], (i >> 1) ? Y : X);
-        }
+OptRect EllipticalArc::boundsLocal(OptInterval const &i, unsigned int deg) const
+{
+    if (!i) return OptRect();
+    if (deg == 0 && i->min() == 0 && i->max() == 1) return boundsExact();
+
+    Coord from = angleAt(i->min());
+    Coord span = sweepAngle() * i->extent();
+    // the derivative of order deg is the ellipse centered at the origin, turned by
+    // deg quarter turns and scaled by the angular speed to the power of deg
+    Affine m = _unit_circle;
+    if (deg > 0) {
+        Coord speed = _sweep ? sweepAngle() : -sweepAngle();
+        m.setTranslation(Point(0, 0));
+        m *= Scale(std::pow(speed, (int) deg));
+        from += deg * M_PI/2;
     }
+    Coord to = _sweep ? from + span : from - span;
+    return ellipse_part_bounds(m, from, span, _sweep,
+                               Point::polar(from) * m, Point::polar(to) * m);
+}
 
-    return Rect( Point(arc_extremes[1], arc_extremes[3]) ,
-                 Point(arc_extremes[0], arc_extremes[2]) );
+int EllipticalArc::winding(Point const &p) const
+{
+    if (isDegenerate()) return Curve::winding(p);
+
+    // y = m[1] cos(a) + m[3] sin(a) + m[5] = r sin(a + phase) + m[5]
+    Affine const &m = _unit_circle;
+    Coord r = hypot(m[1], m[3]);
+    Coord phase = std::atan2(m[1], m[3]);
+    Coord s = (p[Y] - m[5]) / r;
+    // a ray that only touches the ellipse does not change the winding
+    if (!(std::fabs(s) < 1)) return 0;
+
+    // the ellipse goes up through the ray at the first solution and down at the second
+    Coord a = std::asin(s);
+    Coord solutions[2] = { a - phase, M_PI - a - phase };
+    int wind = 0;
+    for (unsigned k = 0; k < 2; ++k) {
+        // endpoints are handled by the caller, like in root_winding()
+        Coord t = map_to_01(solutions[k]);
+        if (!(t > 0 && t < 1)) continue;
+        if (valueAtAngle(solutions[k], X) <= p[X]) continue;
+        int dir = k == 0 ? 1 : -1;
+        wind += _sweep ? dir : -dir;
+    }
+    return wind;
 }
 
 
 Point EllipticalArc::pointAtAngle(Coord t) const
 {
-    Point ret = Point::polar(t) * unitCircleTransform();
-    return ret;
+    return Point::polar(t) * _unit_circle;
 }
 
 Coord EllipticalArc::valueAtAngle(Coord t, Dim2 d) const
 {
-    Coord sinrot, cosrot, cost, sint;
-    sincos(_rot_angle, sinrot, cosrot);
+    Coord sint, cost;
     sincos(t, sint, cost);
+    return _unit_circle[d] * cost + _unit_circle[d+2] * sint + _unit_circle[d+4];
+}
 
-    if ( d == X ) {
-        return    ray(X) * cosrot * cost
-                - ray(Y) * sinrot * sint
-                + center(X);
-    } else {
-        return    ray(X) * sinrot * cost
-                + ray(Y) * cosrot * sint
-                + center(Y);
-    }
+void EllipticalArc::_updateUnitCircle()
+{
+    _unit_circle = Scale(ray(X), ray(Y)) * Rotate(_rot_angle);
+    _unit_circle.setTranslation(center());
 }
 
-Affine EllipticalArc::unitCircleTransform() const
+/* Speed of a point going around the ellipse, |dP/dangle|. It does not depend on
+ * the rotation or the center. */
+struct EllipseSpeed {
+    Coord rx, ry;
+    EllipseSpeed(Coord x, Coord y) : rx(x), ry(y) {}
+    Coord operator()(Coord angle) const {
+        Coord s, c;
+        sincos(angle, s, c);
+        return hypot(rx * s, ry * c);
+    }
+};
+
+Coord EllipticalArc::length(Coord tolerance) const
 {
-    Affine ret = Scale(ray(X), ray(Y)) * Rotate(_rot_angle);
-    ret.setTranslation(center());
+    if (isDegenerate()) return Curve::length(tolerance);
+
+    Coord span = sweepAngle();
+    if (ray(X) == ray(Y)) {
+        return fabs(ray(X)) * span;
+    }
+    // the speed is symmetric, so the direction of the sweep does not matter
+    Coord from = initialAngle().radians0();
+    if (!_sweep) from -= span;
+    // quarter turns at most, so that no piece straddles two bulges of the speed
+    unsigned pieces = std::max(1, (int) ceil(span / M_PI_2));
+    Coord step = span / pieces, ret = 0;
+    EllipseSpeed speed(ray(X), ray(Y));
+    for (unsigned i = 0; i < pieces; ++i) {
+        ret += integrate_gauss(speed, from + i * step, from + (i + 1) * step, tolerance / pieces);
+    }
     return ret;
 }
 
@@ -263,9 +328,15 @@ std::vector<Coord> EllipticalArc::roots(Coord v, Dim2 d) const
         }
     }
 
+    // x = cx + rx cos(a) cos(rot) - ry sin(a) sin(rot)
+    // y = cy + rx cos(a) sin(rot) + ry sin(a) cos(rot)
     double rotx, roty;
-    sincos(_rot_angle, roty, rotx);
-    if (d == X) roty = -roty;
+    if (d == X) {
+        sincos(_rot_angle, roty, rotx);
+        roty = -roty;
+    } else {
+        sincos(_rot_angle, rotx, roty);
+    }
 
     double rxrotx = ray(X) * rotx;
     double c_v = center(d) - v;
@@ -322,30 +393,56 @@ std::vector<Coord> EllipticalArc::roots(Coord v, Dim2 d) const
 }
 
 
+bool EllipticalArc::operator==(Curve const &c) const
+{
+    if (this == &c) return true;
+    EllipticalArc const *other = dynamic_cast<EllipticalArc const *>(&c);
+    if (!other) return false;
+    return initialPoint() == other->initialPoint() && finalPoint() == other->finalPoint()
+        && center() == other->center() && ray(X) == other->ray(X) && ray(Y) == other->ray(Y)
+        && rotationAngle() == other->rotationAngle() && largeArc() == other->largeArc()
+        && sweep() == other->sweep();
+}
+
+
 // D(E(t,C),t) = E(t+PI/2,O), where C is the ellipse center
 // the derivative doesn't rotate the ellipse but there is a translation
 // of the parameter t by an angle of PI/2 so the ellipse points are shifted
 // of such an angle in the cw direction
 Curve *EllipticalArc::derivative() const
 {
+    // scaled by the angular speed, so that this is the derivative with respect to time
     EllipticalArc *result = static_cast<EllipticalArc*>(duplicate());
     result->_center[X] = result->_center[Y] = 0;
-    result->_start_angle += M_PI/2;
+    result->_rays *= sweepAngle();
+    Coord quarter = _sweep ? M_PI/2 : 3*M_PI/2;
+    result->_start_angle += quarter;
     if( !( result->_start_angle < 2*M_PI ) )
     {
         result->_start_angle -= 2*M_PI;
     }
-    result->_end_angle += M_PI/2;
+    result->_end_angle += quarter;
     if( !( result->_end_angle < 2*M_PI ) )
     {
         result->_end_angle -= 2*M_PI;
     }
+    result->_updateUnitCircle();
     result->_initial_point = result->pointAtAngle( result->initialAngle() );
     result->_final_point = result->pointAtAngle( result->finalAngle() );
     return result;
 }
 
 
+Point EllipticalArc::pointAndDerivative(Coord t, Point &deriv) const
+{
+    Coord angle = map_unit_interval_on_circular_arc(t, initialAngle(), finalAngle(), _sweep);
+    Coord speed = _sweep ? sweepAngle() : -sweepAngle();
+    // the derivative with respect to the angle is the point a quarter turn further on,
+    // relative to the center
+    deriv = (pointAtAngle(angle + M_PI/2) - _center) * speed;
+    return pointAtAngle(angle);
+}
+
 std::vector<Point>
 EllipticalArc::pointAndDerivatives(Coord t, unsigned int n) const
 {
@@ -354,8 +451,10 @@ EllipticalArc::pointAndDerivatives(Coord t, unsigned int n) const
     result.reserve(nn);
     double angle = map_unit_interval_on_circular_arc(t, initialAngle(),
                                                      finalAngle(), _sweep);
+    double point_angle = angle;
     std::auto_ptr<EllipticalArc> ea( static_cast<EllipticalArc*>(duplicate()) );
     ea->_center = Point(0,0);
+    ea->_updateUnitCircle();
     unsigned int m = std::min(nn, 4u);
     for ( unsigned int i = 0; i < m; ++i )
     {
@@ -375,7 +474,15 @@ EllipticalArc::pointAndDerivatives(Coord t, unsigned int n) const
         result.push_back( result[i] );
     }
     if ( !result.empty() ) // nn != 0
-        result[0] = pointAtAngle(angle);
+        result[0] = pointAtAngle(point_angle);
+    // so far these are derivatives with respect to the angle
+    Coord speed = _sweep ? sweepAngle() : -sweepAngle();
+    Coord factor = 1;
+    for ( unsigned int i = 1; i < result.size(); ++i )
+    {
+        factor *= speed;
+        result[i] *= factor;
+    }
     return result;
 }
 
@@ -400,6 +507,7 @@ Curve* EllipticalArc::portion(double f, double t) const
         arc->_rot_angle = _rot_angle;
         arc->_sweep = _sweep;
         arc->_large_arc = _large_arc;
+        arc->_updateUnitCircle();
         return arc;
     }
 
@@ -654,11 +762,17 @@ std::vector<double> EllipticalArc::allNearestPoints( Point const& p, double from
 }
 #endif
 
+void EllipticalArc::_updateCenterAndAngles(bool svg)
+{
+    _computeCenterAndAngles(svg);
+    _updateUnitCircle();
+}
+
 /*
  * NOTE: this implementation follows Standard SVG 1.1 implementation guidelines
  * for elliptical arc curves. See Appendix F.6.
  */
-void EllipticalArc::_updateCenterAndAngles(bool svg)
+void EllipticalArc::_computeCenterAndAngles(bool svg)
 {
     Point d = initialPoint() - finalPoint();
 
@@ -42,7 +42,7 @@
 #include <2geom/bezier-curve.h>
 #include <2geom/curve.h>
 #include <2geom/affine.h>
-#include <2geom/sbasis-curve.h>  // for non-native methods
+#include <2geom/sbasis-curve.h>
 #include <2geom/utils.h>
 
 namespace Geom 
@@ -60,6 +60,7 @@ public:
         , _center(0,0)
         , _rot_angle(0)
         , _large_arc(true)
+        , _unit_circle(Affine::identity())
     {}
     /** @brief Create a new elliptical arc.
      * @param ip Initial point of the arc
@@ -175,8 +176,9 @@ public:
     /** @brief Retrieve the unit circle transform.
      * Each ellipse can be interpreted as a translated, scaled and rotate unit circle.
      * This function returns the transform that maps the unit circle to the arc's ellipse.
+     * It is computed whenever the arc changes, so it costs nothing to retrieve.
      * @return Transform from unit circle to the arc's ellipse */
-    Affine unitCircleTransform() const;
+    Affine const &unitCircleTransform() const { return _unit_circle; }
     /// @}
 
     /** @brief Check whether the arc adheres to SVG 1.1 implementation guidelines */
@@ -212,11 +214,13 @@ public:
         return boundsExact();
     }
     virtual Rect boundsExact() const;
-    // TODO: native implementation of the following methods
-    virtual OptRect boundsLocal(OptInterval const &i, unsigned int deg) const {
-        return SBasisCurve(toSBasis()).boundsLocal(i, deg);
-    }
+    /** @brief Bounds of a part of the arc, or of its derivative of order deg. */
+    virtual OptRect boundsLocal(OptInterval const &i, unsigned int deg) const;
     virtual std::vector<double> roots(double v, Dim2 d) const;
+    /** @brief Winding number from the crossings of the arc with a horizontal ray. */
+    virtual int winding(Point const &p) const;
+    /** @brief Compute the arc length by adaptive quadrature; circular arcs use the closed form. */
+    virtual Coord length(Coord tolerance = 0.01) const;
 #ifdef HAVE_GSL
     virtual std::vector<double> allNearestPoints( Point const& p, double from = 0, double to = 1 ) const;
 #endif
@@ -227,13 +231,19 @@ public:
         return allNearestPoints(p, from, to).front();
     }
     virtual int degreesOfFreedom() const { return 7; }
+    virtual bool operator==(Curve const &c) const;
+    /** @brief The derivative with respect to the curve time.
+     * It is the ellipse of the arc centered at the origin, turned a quarter turn in the
+     * direction of the sweep and scaled by the sweep angle. */
     virtual Curve *derivative() const;
     virtual Curve *transformed(Affine const &m) const;
 
     /**
+    *  Derivatives are taken with respect to the curve time, not the angle.
     *  The size of the returned vector equals n+1.
     */
     virtual std::vector<Point> pointAndDerivatives(Coord t, unsigned int n) const;
+    virtual Point pointAndDerivative(Coord t, Point &deriv) const;
 
     virtual D2<SBasis> toSBasis() const;
     virtual double valueAt(Coord t, Dim2 d) const {
@@ -248,13 +258,16 @@ public:
 
 protected:
     void _updateCenterAndAngles(bool svg);
+    void _updateUnitCircle();
 
     Point _initial_point, _final_point;
     Point _rays, _center;
     Angle _rot_angle;
     bool _large_arc;
+    Affine _unit_circle;
 
 private:
+    void _computeCenterAndAngles(bool svg);
     Coord map_to_01(Coord angle) const; 
 }; // end class EllipticalArc
 
@@ -0,0 +1,227 @@
+/*
+ * PathVector with a spatial index of its curves
+ *
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/indexed-pathvector.h>
+#include <algorithm>
+
+namespace Geom {
+
+void IndexedPathVector::assign(PathVector const &pv)
+{
+    _pv = pv;
+    _curves.clear();
+
+    std::vector<RTree<unsigned>::Item> items;
+    for (unsigned i = 0; i < _pv.size(); ++i) {
+        Path const &path = _pv[i];
+        // the closing segment always counts for the fill, but for the outline only
+        // when the path is closed or consists of nothing else
+        for (unsigned j = 0; j < path.size_closed(); ++j) {
+            bool fill_only = j == path.size() && !path.closed() && !path.empty();
+            _curves.push_back(CurveRef(i, j, fill_only));
+            items.push_back(std::make_pair(path[j].boundsFast(), (unsigned) items.size()));
+        }
+    }
+    _tree.assign(items.begin(), items.end());
+}
+
+struct IndexedPathVector::NearestVisitor {
+    IndexedPathVector const &ipv;
+    Point p;
+    Coord best;
+    unsigned best_ix;
+    Coord best_t;
+
+    NearestVisitor(IndexedPathVector const &i, Point const &q)
+        : ipv(i), p(q), best(infinity()), best_ix(0), best_t(0) {}
+
+    bool operator()(Rect const &, unsigned ix, Coord box_dist) {
+        if (box_dist * box_dist > best) return false;
+        CurveRef const &c = ipv._curves[ix];
+        if (c.fill_only) return true;
+
+        Curve const &curve = ipv._curve(c);
+        Coord t = curve.nearestPoint(p);
+        Coord dsq = distanceSq(p, curve.pointAt(t));
+        // items are numbered in path order, so this picks the same curve as a linear scan
+        if (dsq < best || (dsq == best && ix < best_ix)) {
+            best = dsq;
+            best_ix = ix;
+            best_t = t;
+        }
+        return true;
+    }
+};
+
+boost::optional<PathVectorPosition>
+IndexedPathVector::nearestPoint(Point const &p, double *distance_squared) const
+{
+    boost::optional<PathVectorPosition> retval;
+    NearestVisitor v(*this, p);
+    _tree.visitNearest(p, v);
+
+    if (v.best != infinity()) {
+        CurveRef const &c = _curves[v.best_ix];
+        retval = PathVectorPosition(c.path_nr, c.curve_nr + v.best_t);
+    }
+    if (distance_squared) {
+        *distance_squared = v.best;
+    }
+    return retval;
+}
+
+struct IndexedPathVector::AllNearestVisitor {
+    IndexedPathVector const &ipv;
+    Point p;
+    Coord best;
+    std::vector<PathVectorPosition> found;
+
+    AllNearestVisitor(IndexedPathVector const &i, Point const &q)
+        : ipv(i), p(q), best(infinity()) {}
+
+    bool operator()(Rect const &, unsigned ix, Coord box_dist) {
+        if (box_dist * box_dist > best) return false;
+        CurveRef const &c = ipv._curves[ix];
+        if (c.fill_only) return true;
+
+        Curve const &curve = ipv._curve(c);
+        std::vector<Coord> ts = curve.allNearestPoints(p);
+        if (ts.empty()) return true;
+        Coord dsq = distanceSq(p, curve.pointAt(ts.front()));
+        if (dsq > best) return true;
+        if (dsq < best) {
+            best = dsq;
+            found.clear();
+        }
+        for (unsigned i = 0; i < ts.size(); ++i) {
+            found.push_back(PathVectorPosition(c.path_nr, c.curve_nr + ts[i]));
+        }
+        return true;
+    }
+};
+
+static bool position_less(PathVectorPosition const &a, PathVectorPosition const &b)
+{
+    return a.path_nr < b.path_nr || (a.path_nr == b.path_nr && a.t < b.t);
+}
+
+static bool position_equal(PathVectorPosition const &a, PathVectorPosition const &b)
+{
+    return a.path_nr == b.path_nr && a.t == b.t;
+}
+
+std::vector<PathVectorPosition>
+IndexedPathVector::allNearestPoints(Point const &p, double *distance_squared) const
+{
+    AllNearestVisitor v(*this, p);
+    _tree.visitNearest(p, v);
+
+    // the joint between two curves is found on both of them
+    std::sort(v.found.begin(), v.found.end(), position_less);
+    v.found.erase(std::unique(v.found.begin(), v.found.end(), position_equal), v.found.end());
+
+    if (distance_squared) {
+        *distance_squared = v.best;
+    }
+    return v.found;
+}
+
+/* Counts signed crossings of the ray going from the point in the +X direction.
+ * A point on the curve counts as above the ray only when it is strictly above,
+ * so crossings at shared endpoints are counted exactly once without looking at
+ * the neighbouring curves. The sign convention matches Geom::winding(). */
+struct IndexedPathVector::WindingVisitor {
+    IndexedPathVector const &ipv;
+    Point p;
+    int wind;
+
+    WindingVisitor(IndexedPathVector const &i, Point const &q)
+        : ipv(i), p(q), wind(0) {}
+
+    bool above(Coord y) const { return y > p[Y]; }
+
+    void cross(Curve const &c, Coord t, bool before, bool after) {
+        if (before != after && c.valueAt(t, X) > p[X]) {
+            wind += after ? 1 : -1;
+        }
+    }
+
+    bool operator()(Rect const &box, unsigned ix) {
+        Curve const &c = ipv._curve(ipv._curves[ix]);
+        bool initial = above(c.initialPoint()[Y]);
+        bool final = above(c.finalPoint()[Y]);
+
+        if (box[X].min() > p[X]) {
+            // all crossings are on the ray, so only the endpoints matter
+            wind += int(final) - int(initial);
+            return true;
+        }
+
+        std::vector<Coord> ts = c.roots(p[Y], Y);
+        std::sort(ts.begin(), ts.end());
+        Coord prev_t = 0;
+        bool prev = initial;
+        for (unsigned i = 0; i <= ts.size(); ++i) {
+            Coord t = i < ts.size() ? ts[i] : 1;
+            if (t <= prev_t || t > 1) continue;
+            bool interval = above(c.valueAt((prev_t + t) / 2, Y));
+            // the state may change where this piece begins
+            cross(c, prev_t, prev, interval);
+            prev = interval;
+            prev_t = t;
+        }
+        // and at the end from the last piece to the final point
+        cross(c, 1, prev, final);
+        return true;
+    }
+};
+
+int IndexedPathVector::winding(Point const &p) const
+{
+    OptRect b = _tree.bounds();
+    if (!b || p[X] > b->right()) return 0;
+
+    WindingVisitor v(*this, p);
+    Rect ray(Interval(p[X], b->right()), Interval(p[Y], p[Y]));
+    _tree.visit(ray, v);
+    return v.wind;
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,110 @@
+/**
+ * \file
+ * \brief PathVector with a spatial index of its curves
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_INDEXED_PATHVECTOR_H
+#define LIB2GEOM_SEEN_INDEXED_PATHVECTOR_H
+
+#include <vector>
+#include <2geom/pathvector.h>
+#include <2geom/rtree.h>
+
+namespace Geom {
+
+/**
+ * @brief Read-only PathVector with an R-tree of its curves.
+ *
+ * Building the index costs one boundsFast() call per curve. After that,
+ * nearest point queries only look at curves whose bounding boxes are closer
+ * than the best distance found so far, and winding queries only look at curves
+ * whose boxes touch the ray cast from the point, so both take roughly
+ * logarithmic time on large drawings.
+ *
+ * The index keeps its own copy of the paths; rebuild it when they change.
+ */
+class IndexedPathVector {
+public:
+    IndexedPathVector() {}
+    explicit IndexedPathVector(PathVector const &pv) { assign(pv); }
+
+    void assign(PathVector const &pv);
+
+    PathVector const &pathvector() const { return _pv; }
+    OptRect boundsFast() const { return _tree.bounds(); }
+
+    /** @brief Find the nearest point on the paths.
+     * Gives the same result as Geom::nearestPoint(PathVector const &, Point const &, double *).
+     * Ties are broken in favour of the earliest curve. */
+    boost::optional<PathVectorPosition> nearestPoint(Point const &p,
+                                                    double *distance_squared = NULL) const;
+    /** @brief Find all points on the paths at the smallest distance.
+     * The positions are sorted and contain no duplicates. */
+    std::vector<PathVectorPosition> allNearestPoints(Point const &p,
+                                                     double *distance_squared = NULL) const;
+
+    /** @brief Sum of the winding numbers of all paths around a point.
+     * Open paths are treated as closed, like Geom::winding(Path const &, Point). */
+    int winding(Point const &p) const;
+    bool contains(Point const &p, bool evenodd = true) const {
+        int w = winding(p);
+        return (evenodd ? w % 2 : w) != 0;
+    }
+
+private:
+    struct CurveRef {
+        unsigned path_nr;
+        unsigned curve_nr;
+        bool fill_only; // implicit closing segment of an open path
+        CurveRef(unsigned p, unsigned i, bool f) : path_nr(p), curve_nr(i), fill_only(f) {}
+    };
+    Curve const &_curve(CurveRef const &c) const { return _pv[c.path_nr][c.curve_nr]; }
+
+    struct NearestVisitor;
+    struct AllNearestVisitor;
+    struct WindingVisitor;
+
+    PathVector _pv;
+    std::vector<CurveRef> _curves;
+    RTree<unsigned> _tree;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_INDEXED_PATHVECTOR_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -61,7 +61,6 @@ double nearest_point( Point const& p,
     }
     if (c.isConstant()) return from;
     SBasis dd = dot(c - p, dc);
-    std::cout << dd << std::endl;
     std::vector<double> zeros = Geom::roots(dd);
 
     double closest = from;
@@ -69,6 +68,7 @@ double nearest_point( Point const& p,
     double distsq;
     for ( unsigned int i = 0; i < zeros.size(); ++i )
     {
+        if ( zeros[i] < from || zeros[i] > to ) continue;
         distsq = L2sq(c(zeros[i]) - p);
         if ( min_dist_sq > L2sq(c(zeros[i]) - p) )
         {
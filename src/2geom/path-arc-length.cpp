@@ -0,0 +1,230 @@
+/*
+ * Arc length lookup table for a path
+ *
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/path-arc-length.h>
+#include <2geom/quadrature.h>
+#include <2geom/math-utils.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Geom {
+
+// the deepest subdivision of a curve, reached only around cusps
+static const unsigned MAX_DEPTH = 20;
+
+struct PathArcLengthIndex::Speed {
+    Curve const &derivative;
+    Speed(Curve const &d) : derivative(d) {}
+    Coord operator()(Coord t) const { return L2(derivative.pointAt(t)); }
+};
+
+PathArcLengthIndex::PathArcLengthIndex(Path const &p, Coord tolerance)
+    : _path(p)
+    , _tolerance(tolerance)
+{
+    unsigned n = _path.size_default();
+    if (n == 0) return;
+
+    // half of the tolerance is spent on the table and half on refining queries
+    Coord curve_tolerance = 0.5 * tolerance / n;
+    _derivatives.reserve(n);
+    for (unsigned i = 0; i < n; ++i) {
+        _derivatives.push_back(boost::shared_ptr<Curve>(_path[i].derivative()));
+        Coord start = _samples.empty() ? 0 : _samples.back().s;
+        if (_path[i].isDegenerate()) {
+            // no length to sample, e.g. the closing segment of a path that returns to its start
+            _samples.push_back(Sample(start, 0, 0, i));
+            continue;
+        }
+        Speed speed(*_derivatives.back());
+        _samples.push_back(Sample(start, 0, 1 / speed(0), i));
+        _sample(speed, i, 0, 1, curve_tolerance, 0);
+    }
+}
+
+// time at the fraction u of the length between two samples, by cubic Hermite interpolation
+static Coord hermite(Coord u, Coord h, Coord t0, Coord d0, Coord t1, Coord d1)
+{
+    Coord v = 1 - u;
+    return v * v * ((1 + 2 * u) * t0 + u * h * d0) + u * u * ((1 + 2 * v) * t1 - v * h * d1);
+}
+
+/* Appends the end of every interval on which the quadrature rules agree and the time
+ * is interpolated well, together with the length up to there. Within such an interval
+ * the speed is smooth, so the queries can integrate it with a single rule. */
+void PathArcLengthIndex::_sample(Speed const &speed, unsigned curve, Coord from, Coord to,
+                                 Coord tolerance, unsigned depth)
+{
+    Coord g5, g3;
+    gauss_legendre_5_3(speed, from, to, g5, g3);
+    if (depth == MAX_DEPTH || std::fabs(g5 - g3) <= tolerance) {
+        Sample b(_samples.back().s + g5, to, 1 / speed(to), curve);
+        if (_interpolates(speed, _samples.back(), b)) {
+            _samples.push_back(b);
+            return;
+        }
+        // stopped at both ends, which splitting cannot change when the speed is zero throughout
+        if (depth == MAX_DEPTH || (!IS_FINITE(_samples.back().dtds) && !IS_FINITE(b.dtds))) {
+            b.refine = true;
+            _samples.push_back(b);
+            return;
+        }
+    }
+    Coord mid = (from + to) / 2;
+    _sample(speed, curve, from, mid, tolerance / 2, depth + 1);
+    _sample(speed, curve, mid, to, tolerance / 2, depth + 1);
+}
+
+// checks the interpolated times at a few lengths inside the interval
+bool PathArcLengthIndex::_interpolates(Speed const &speed, Sample const &a, Sample const &b) const
+{
+    if (!IS_FINITE(a.dtds) || !IS_FINITE(b.dtds)) return false;
+    Coord h = b.s - a.s;
+    for (unsigned i = 1; i < 4; ++i) {
+        Coord u = 0.25 * i;
+        Coord t = hermite(u, h, a.t, a.dtds, b.t, b.dtds);
+        if (!(t >= a.t && t <= b.t)) return false;
+        if (std::fabs(gauss_legendre_5(speed, a.t, t) - u * h) > 0.5 * _tolerance) return false;
+    }
+    return true;
+}
+
+unsigned PathArcLengthIndex::_curveAt(Coord s, Coord &t) const
+{
+    // first sample past s; the one before it is at or before s and on the same curve,
+    // because every curve starts with a sample at the length where the previous one ends
+    unsigned lo = 0, hi = _samples.size();
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        if (_samples[mid].s <= s) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == _samples.size()) {
+        t = 1;
+        return _samples.back().curve;
+    }
+    if (lo == 0) {
+        t = 0;
+        return 0;
+    }
+
+    Sample const &a = _samples[lo - 1], &b = _samples[lo];
+    Coord target = s - a.s;
+    if (!b.refine) {
+        t = hermite(target / (b.s - a.s), b.s - a.s, a.t, a.dtds, b.t, b.dtds);
+        t = std::min(std::max(t, a.t), b.t);
+        return b.curve;
+    }
+
+    Speed speed(*_derivatives[b.curve]);
+    Coord low = a.t, high = b.t;
+    Coord x = a.t + (b.t - a.t) * target / (b.s - a.s);
+    // Newton steps on the length from a, falling back to bisection when they leave the bracket
+    for (unsigned i = 0; i < 16; ++i) {
+        Coord f = gauss_legendre_5(speed, a.t, x) - target;
+        if (std::fabs(f) <= 0.5 * _tolerance) break;
+        if (f < 0) {
+            low = x;
+        } else {
+            high = x;
+        }
+        Coord v = speed(x);
+        Coord next = v > 0 ? x - f / v : low;
+        x = next > low && next < high ? next : (low + high) / 2;
+    }
+    t = x;
+    return b.curve;
+}
+
+Coord PathArcLengthIndex::timeAtLength(Coord s) const
+{
+    if (_samples.empty()) return 0;
+    Coord t;
+    unsigned i = _curveAt(s, t);
+    return i + t;
+}
+
+Coord PathArcLengthIndex::lengthAtTime(Coord t) const
+{
+    if (_samples.empty()) return 0;
+    unsigned n = _derivatives.size();
+    if (!(t > 0)) return 0;
+    if (t >= n) return length();
+
+    Coord k;
+    Coord lt = std::modf(t, &k);
+    unsigned curve = k;
+    // last sample at or before (curve, lt)
+    unsigned lo = 0, hi = _samples.size();
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        Sample const &m = _samples[mid];
+        if (m.curve < curve || (m.curve == curve && m.t <= lt)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    Sample const &a = _samples[lo - 1];
+    return a.s + gauss_legendre_5(Speed(*_derivatives[curve]), a.t, lt);
+}
+
+Point PathArcLengthIndex::pointAtLength(Coord s) const
+{
+    if (_samples.empty()) return _path.initialPoint();
+    Coord t;
+    unsigned i = _curveAt(s, t);
+    return _path[i].pointAt(t);
+}
+
+Point PathArcLengthIndex::unitTangentAtLength(Coord s) const
+{
+    if (_samples.empty()) return Point(0, 0);
+    Coord t;
+    unsigned i = _curveAt(s, t);
+    Point d = _derivatives[i]->pointAt(t);
+    if (!d.isZero()) return unit_vector(d);
+    return _path[i].unitTangentAt(t);
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,113 @@
+/**
+ * \file
+ * \brief Arc length lookup table for a path
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_PATH_ARC_LENGTH_H
+#define LIB2GEOM_SEEN_PATH_ARC_LENGTH_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <2geom/path.h>
+
+namespace Geom {
+
+/**
+ * @brief Read-only Path with a table for converting between arc length and time.
+ *
+ * Building the table integrates the speed of every curve by adaptive quadrature,
+ * and splits the curves until the time within each interval is interpolated well
+ * by a cubic in the length. A query then finds its interval by binary search and
+ * evaluates the cubic, so it takes logarithmic time and allocates nothing. Only
+ * the intervals next to cusps, where the speed drops to zero, are refined with
+ * Newton steps instead. The table is built an order of magnitude faster than
+ * arc_length_parametrization() and is suited to sampling the same path many times,
+ * as in dashing, markers or text on a path.
+ *
+ * Times are path times, as accepted by Path::pointAt(). Lengths outside of
+ * [0, length()] are clamped. The index keeps its own copy of the path;
+ * rebuild it when the path changes.
+ */
+class PathArcLengthIndex {
+public:
+    /** @brief Build the table.
+     * @param tolerance Maximum error of any length returned by or passed to the queries */
+    explicit PathArcLengthIndex(Path const &p, Coord tolerance = 0.01);
+
+    Path const &path() const { return _path; }
+    Coord tolerance() const { return _tolerance; }
+    /// Length of the whole path, including the closing segment of a closed path.
+    Coord length() const { return _samples.empty() ? 0 : _samples.back().s; }
+
+    /// Path time at which the path reaches the given length.
+    Coord timeAtLength(Coord s) const;
+    /// Length of the path from its start to the given path time.
+    Coord lengthAtTime(Coord t) const;
+    Point pointAtLength(Coord s) const;
+    /// Direction of the path at the given length; see Curve::unitTangentAt().
+    Point unitTangentAtLength(Coord s) const;
+    /// Number of entries in the table.
+    unsigned size() const { return _samples.size(); }
+
+private:
+    struct Sample {
+        Coord s;         // length from the start of the path
+        Coord t;         // time on the curve
+        Coord dtds;      // inverse of the speed
+        unsigned curve;
+        bool refine;     // whether the interval ending here needs Newton steps
+        Sample(Coord sv, Coord tv, Coord d, unsigned c)
+            : s(sv), t(tv), dtds(d), curve(c), refine(false) {}
+    };
+    struct Speed;
+
+    void _sample(Speed const &speed, unsigned curve, Coord from, Coord to, Coord tolerance,
+                 unsigned depth);
+    bool _interpolates(Speed const &speed, Sample const &a, Sample const &b) const;
+    unsigned _curveAt(Coord s, Coord &t) const;
+
+    Path _path;
+    Coord _tolerance;
+    std::vector<boost::shared_ptr<Curve> > _derivatives;
+    std::vector<Sample> _samples;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_PATH_ARC_LENGTH_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
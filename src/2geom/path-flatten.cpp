@@ -0,0 +1,241 @@
+/*
+ * Approximation of paths by polylines within a tolerance
+ *
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/path-flatten.h>
+#include <2geom/bezier-curve.h>
+#include <2geom/elliptical-arc.h>
+#include <2geom/sbasis-to-bezier.h>
+#include <2geom/exception.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Geom {
+
+// keeps absurdly small tolerances from overflowing the counts
+static const Coord MAX_PIECES = 1 << 24;
+
+static unsigned pieces(Coord x)
+{
+    if (!(x < MAX_PIECES)) return MAX_PIECES;
+    return std::max(1.0, std::ceil(x));
+}
+
+static void check_tolerance(Coord tolerance)
+{
+    if (!(tolerance > 0)) {
+        THROW_RANGEERROR("flattening tolerance must be positive");
+    }
+}
+
+// Wang's formula for the control points of a Bezier curve
+static unsigned wang_count(Point const *pts, unsigned order, Coord tolerance)
+{
+    if (order < 2) return 1;
+    Coord m = 0;
+    for (unsigned i = 0; i + 2 <= order; ++i) {
+        m = std::max(m, L2(pts[i] - 2 * pts[i+1] + pts[i+2]));
+    }
+    return pieces(std::sqrt(order * (order - 1) * m / (8 * tolerance)));
+}
+
+unsigned flatten_count(Curve const &c, Coord tolerance)
+{
+    check_tolerance(tolerance);
+    if (BezierCurve const *bez = dynamic_cast<BezierCurve const *>(&c)) {
+        unsigned order = bez->order();
+        if (order < 2) return 1;
+        Point pts[4];
+        if (order <= 3) {
+            for (unsigned i = 0; i <= order; ++i) pts[i] = (*bez)[i];
+            return wang_count(pts, order, tolerance);
+        }
+        std::vector<Point> all = bez->points();
+        return wang_count(&all[0], order, tolerance);
+    }
+    if (EllipticalArc const *arc = dynamic_cast<EllipticalArc const *>(&c)) {
+        // SVG arcs with a zero ray are straight lines
+        if (arc->isSVGCompliant() && arc->isDegenerate()) return 1;
+        Coord r = std::max(arc->ray(X), arc->ray(Y));
+        if (!(r > 0)) return 1;
+        Coord step = 2 * std::acos(std::max(1 - tolerance / r, -1.0));
+        return pieces(arc->sweepAngle() / step);
+    }
+    std::vector<Point> pts;
+    sbasis_to_bezier(pts, c.toSBasis());
+    if (pts.empty()) return 1;
+    return wang_count(&pts[0], pts.size() - 1, tolerance);
+}
+
+void flatten_points(Curve const &c, unsigned n, unsigned first, unsigned count, Point *out)
+{
+    Coord dt = 1.0 / n;
+    unsigned last = first + count;
+    // the final point is stored exactly, so that consecutive curves join up
+    unsigned inner = std::min(last, n - 1);
+    unsigned k = first + 1;
+
+    BezierCurve const *bez = dynamic_cast<BezierCurve const *>(&c);
+    unsigned order = bez ? bez->order() : 0;
+    if (order == 2 || order == 3) {
+        // power basis, evaluated by Horner's rule
+        Point p0 = (*bez)[0], p1 = (*bez)[1], p2 = (*bez)[2];
+        Point a, b, d;
+        if (order == 2) {
+            a = Point(0, 0);
+            b = p0 - 2 * p1 + p2;
+            d = 2 * (p1 - p0);
+        } else {
+            Point p3 = (*bez)[3];
+            a = p3 - p0 + 3 * (p1 - p2);
+            b = 3 * (p0 - 2 * p1 + p2);
+            d = 3 * (p1 - p0);
+        }
+        for (; k <= inner; ++k, ++out) {
+            Coord t = k * dt;
+            *out = ((a * t + b) * t + d) * t + p0;
+        }
+    } else if (EllipticalArc const *arc = bez ? NULL : dynamic_cast<EllipticalArc const *>(&c)) {
+        if (!(arc->isSVGCompliant() && arc->isDegenerate())) {
+            // turn a point of the unit circle by equal steps, starting afresh now and then
+            // so that rounding errors cannot pile up
+            Affine m = arc->unitCircleTransform();
+            Point turn = Point::polar(arc->sweepAngle() * (arc->sweep() ? dt : -dt));
+            Point u;
+            for (unsigned j = 0; k <= inner; ++k, ++j, ++out) {
+                if (j % 64 == 0) {
+                    u = Point::polar(arc->angleAt(k * dt));
+                } else {
+                    u = Point(u[X] * turn[X] - u[Y] * turn[Y], u[X] * turn[Y] + u[Y] * turn[X]);
+                }
+                *out = u * m;
+            }
+        }
+    } else if (order != 1) {
+        for (; k <= inner; ++k, ++out) {
+            *out = c.pointAt(k * dt);
+        }
+    }
+    if (last == n) {
+        *out = c.finalPoint();
+    }
+}
+
+unsigned flatten_count(Path const &p, Coord tolerance)
+{
+    unsigned count = 1;
+    for (Path::const_iterator it = p.begin(); it != p.end(); ++it) {
+        count += flatten_count(*it, tolerance);
+    }
+    if (p.closed() && !p.back_closed().isDegenerate()) {
+        ++count;
+    }
+    return count;
+}
+
+unsigned flatten(Path const &p, Coord tolerance, Point *out)
+{
+    Point *start = out;
+    *out++ = p.initialPoint();
+    for (Path::const_iterator it = p.begin(); it != p.end(); ++it) {
+        unsigned n = flatten_count(*it, tolerance);
+        flatten_points(*it, n, 0, n, out);
+        out += n;
+    }
+    if (p.closed() && !p.back_closed().isDegenerate()) {
+        *out++ = p.initialPoint();
+    }
+    return out - start;
+}
+
+void flatten(Path const &p, Coord tolerance, PolylineSink &sink)
+{
+    // curves with more pieces than this are passed to the sink in several batches
+    static const unsigned BATCH = 128;
+    Point buffer[BATCH];
+
+    sink.moveTo(p.initialPoint());
+    for (Path::const_iterator it = p.begin(); it != p.end(); ++it) {
+        unsigned n = flatten_count(*it, tolerance);
+        for (unsigned first = 0; first < n; first += BATCH) {
+            unsigned count = std::min(BATCH, n - first);
+            flatten_points(*it, n, first, count, buffer);
+            sink.lineTo(buffer, count);
+        }
+    }
+    if (p.closed()) {
+        sink.closePath();
+    }
+}
+
+void flatten(PathVector const &pv, Coord tolerance, PolylineSink &sink)
+{
+    for (unsigned i = 0; i < pv.size(); ++i) {
+        flatten(pv[i], tolerance, sink);
+    }
+}
+
+void flatten(PathVector const &pv, Coord tolerance,
+             std::vector<Point> &points, std::vector<unsigned> &offsets)
+{
+    check_tolerance(tolerance);
+    int n = pv.size();
+    offsets.assign(n + 1, 0);
+
+    // the tolerance is valid, so nothing below throws except on exhausted memory
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(n > 1)
+#endif
+    for (int i = 0; i < n; ++i) {
+        offsets[i + 1] = flatten_count(pv[i], tolerance);
+    }
+    for (int i = 0; i < n; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    points.resize(offsets[n]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(n > 1)
+#endif
+    for (int i = 0; i < n; ++i) {
+        flatten(pv[i], tolerance, &points[offsets[i]]);
+    }
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
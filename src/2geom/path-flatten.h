@@ -0,0 +1,109 @@
+/**
+ * \file
+ * \brief Approximation of paths by polylines within a tolerance
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_PATH_FLATTEN_H
+#define LIB2GEOM_SEEN_PATH_FLATTEN_H
+
+#include <vector>
+#include <2geom/pathvector.h>
+
+namespace Geom {
+
+/*
+ * Every curve is split into pieces of equal time, and the number of pieces is
+ * chosen beforehand so that no chord is further than the tolerance from its
+ * piece of the curve:
+ *
+ * - Bezier curves of order d use Wang's formula: n pieces are enough when
+ *   n^2 >= d (d - 1) / 8 * max |P[i] - 2 P[i+1] + P[i+2]| / tolerance.
+ * - Elliptical arcs take equal angular steps, each short enough for a circle
+ *   with the larger of the two rays. The ellipse is that circle squashed along
+ *   one axis, which does not move any point further from its chord.
+ * - Other curves are converted to Bezier form through their S-basis.
+ *
+ * The polylines always pass exactly through the ends of the curves.
+ */
+
+/** @brief Receives polylines from flatten().
+ * The points of a polyline arrive in batches; the array passed to lineTo() is reused
+ * once the call returns. */
+class PolylineSink {
+public:
+    /// Starts a new polyline at the given point.
+    virtual void moveTo(Point const &p) = 0;
+    /// Continues the current polyline through @a n points.
+    virtual void lineTo(Point const *points, unsigned n) = 0;
+    /// Ends the current polyline, which returns to its first point.
+    virtual void closePath() = 0;
+    virtual ~PolylineSink() {}
+};
+
+/** @brief Number of line segments that approximate a curve within a tolerance. */
+unsigned flatten_count(Curve const &c, Coord tolerance);
+
+/** @brief Ends of the line segments that approximate a curve.
+ * Writes the points at times k / n for k = first + 1 ... first + count, where
+ * first + count <= n. The point at time 1 is the final point of the curve. */
+void flatten_points(Curve const &c, unsigned n, unsigned first, unsigned count, Point *out);
+
+/** @brief Number of points in the polyline of a path, including its first point.
+ * The polyline of a closed path includes the closing segment and ends at the first point. */
+unsigned flatten_count(Path const &p, Coord tolerance);
+
+/** @brief Writes the polyline of a path into a buffer of flatten_count(p, tolerance) points.
+ * @return Number of points written */
+unsigned flatten(Path const &p, Coord tolerance, Point *out);
+
+/** @brief Streams the polyline of a path into a sink, without allocating memory. */
+void flatten(Path const &p, Coord tolerance, PolylineSink &sink);
+/** @brief Streams the polylines of all paths into a sink. */
+void flatten(PathVector const &pv, Coord tolerance, PolylineSink &sink);
+
+/** @brief Flattens all paths into one array.
+ * The points of path i are stored in [offsets[i], offsets[i+1]), so that @a offsets
+ * ends up with pv.size() + 1 entries. When the library is built with OpenMP, the
+ * paths are flattened in parallel; the result is the same either way. */
+void flatten(PathVector const &pv, Coord tolerance,
+             std::vector<Point> &points, std::vector<unsigned> &offsets);
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_PATH_FLATTEN_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -1,14 +1,11 @@
 #include <2geom/path-intersection.h>
 
 #include <2geom/ord.h>
+#include <2geom/basic-intersection.h>
 
 //for path_direction:
 #include <2geom/sbasis-geometric.h>
 #include <2geom/line.h>
-#ifdef HAVE_GSL
-#include <gsl/gsl_vector.h>
-#include <gsl/gsl_multiroots.h>
-#endif
 
 namespace Geom {
 
@@ -22,6 +19,10 @@ namespace Geom {
  * the curve specific winding function is called.
  */
 int winding(Path const &path, Point p) {
+  // the ray misses every curve
+  OptRect path_bounds = path.boundsFast();
+  if(!path_bounds || p[X] > path_bounds->right() || !(*path_bounds)[Y].contains(p[Y])) return 0;
+
   //start on a segment which is not a horizontal line with y = p[y]
   Path::const_iterator start;
   for(Path::const_iterator iter = path.begin(); ; ++iter) {
@@ -37,7 +38,7 @@ int winding(Path const &path, Point p) {
        ; ++iter, iter = (iter == path.end_closed()) ? path.begin() : iter )
   {
     cnt++;
-    if(cnt > path.size()) return wind;  //some bug makes this required
+    if(cnt > path.size_closed()) return wind;  // every curve, including the closing segment, has been visited
     starting = false;
     Rect bounds = (iter->boundsFast());
     Coord x = p[X], y = p[Y];
@@ -203,114 +204,6 @@ static double EpsilonOf(double value)
 }
 #endif
 
-#ifdef HAVE_GSL
-struct rparams {
-    Curve const &A;
-    Curve const &B;
-};
-
-static int
-intersect_polish_f (const gsl_vector * x, void *params,
-                    gsl_vector * f)
-{
-    const double x0 = gsl_vector_get (x, 0);
-    const double x1 = gsl_vector_get (x, 1);
-     
-    Geom::Point dx = ((struct rparams *) params)->A(x0) - 
-        ((struct rparams *) params)->B(x1);
-     
-    gsl_vector_set (f, 0, dx[0]);
-    gsl_vector_set (f, 1, dx[1]);
-     
-    return GSL_SUCCESS;
-}
-#endif
-
-static void 
-intersect_polish_root (Curve const &A, double &s, Curve const &B, double &t)
-{
-    std::vector<Point> as, bs;
-    as = A.pointAndDerivatives(s, 2);
-    bs = B.pointAndDerivatives(t, 2);
-    Point F = as[0] - bs[0];
-    double best = dot(F, F);
-    
-    for(int i = 0; i < 4; i++) {
-        
-        /**
-           we want to solve
-           J*(x1 - x0) = f(x0)
-           
-           |dA(s)[0]  -dB(t)[0]|  (X1 - X0) = A(s) - B(t)
-           |dA(s)[1]  -dB(t)[1]| 
-        **/
-
-        // We're using the standard transformation matricies, which is numerically rather poor.  Much better to solve the equation using elimination.
-
-        Affine jack(as[1][0], as[1][1],
-                    -bs[1][0], -bs[1][1],
-                    0, 0);
-        Point soln = (F)*jack.inverse();
-        double ns = s - soln[0];
-        double nt = t - soln[1];
-
-        if (ns<0) ns=0;
-        else if (ns>1) ns=1;
-        if (nt<0) nt=0;
-        else if (nt>1) nt=1;
-        
-        as = A.pointAndDerivatives(ns, 2);
-        bs = B.pointAndDerivatives(nt, 2);
-        F = as[0] - bs[0];
-        double trial = dot(F, F);
-        if (trial > best*0.1) // we have standards, you know
-            // At this point we could do a line search
-            break;
-        best = trial;
-        s = ns;
-        t = nt;
-    }
-
-#ifdef HAVE_GSL
-    if(0) { // the GSL version is more accurate, but taints this with GPL
-        int status;
-        size_t iter = 0;
-        const size_t n = 2;
-        struct rparams p = {A, B};
-        gsl_multiroot_function f = {&intersect_polish_f, n, &p};
-     
-        double x_init[2] = {s, t};
-        gsl_vector *x = gsl_vector_alloc (n);
-     
-        gsl_vector_set (x, 0, x_init[0]);
-        gsl_vector_set (x, 1, x_init[1]);
-     
-        const gsl_multiroot_fsolver_type *T = gsl_multiroot_fsolver_hybrids;
-        gsl_multiroot_fsolver *sol = gsl_multiroot_fsolver_alloc (T, 2);
-        gsl_multiroot_fsolver_set (sol, &f, x);
-     
-        do
-        {
-            iter++;
-            status = gsl_multiroot_fsolver_iterate (sol);
-     
-            if (status)   /* check if solver is stuck */
-                break;
-     
-            status =
-                gsl_multiroot_test_residual (sol->f, 1e-12);
-        }
-        while (status == GSL_CONTINUE && iter < 1000);
-    
-        s = gsl_vector_get (sol->x, 0);
-        t = gsl_vector_get (sol->x, 1);
-    
-        gsl_multiroot_fsolver_free (sol);
-        gsl_vector_free (x);
-    }
-#endif
-}
-
 /**
  * This uses the local bounds functions of curves to generically intersect two.
  * It passes in the curves, time intervals, and keeps track of depth, while
@@ -337,8 +230,7 @@ void pair_intersect(Curve const & A, double Al, double Ah,
                             tA, tB, c)) {
             tA = tA * (Ah - Al) + Al;
             tB = tB * (Bh - Bl) + Bl;
-            intersect_polish_root(A, tA,
-                                  B, tB);
+            polish_intersection(A, tA, B, tB);
             if(depth % 2)
                 ret.push_back(Crossing(tB, tA, c < 0));
             else
@@ -391,8 +283,7 @@ void mono_intersect(Curve const &A, double Al, double Ah,
                             tA, tB, c)) {
             tA = tA * (Ah - Al) + Al;
             tB = tB * (Bh - Bl) + Bl;
-            intersect_polish_root(A, tA,
-                                  B, tB);
+            polish_intersection(A, tA, B, tB);
             if(depth % 2)
                 ret.push_back(Crossing(tB, tA, c < 0));
             else
@@ -765,26 +656,69 @@ void flip_crossings(Crossings &crs) {
         crs[i] = Crossing(crs[i].tb, crs[i].ta, crs[i].b, crs[i].a, !crs[i].dir);
 }
 
+namespace {
+
+/* One path against itself or a pair of paths whose bounds overlap. */
+struct CrossingTask {
+    unsigned a, b;
+    bool failed;
+    Crossings result;
+    CrossingTask(unsigned i, unsigned j) : a(i), b(j), failed(false) {}
+
+    void run(std::vector<Path> const &p) {
+        if(a == b) {
+            result = self_crossings(p[a]);
+        } else {
+            result = SimpleCrosser().crossings(p[a], p[b]);
+        }
+        for(unsigned k = 0; k < result.size(); k++) { result[k].a = a; result[k].b = b; }
+    }
+};
+
+}
+
+/* The pairs found by the sweep are independent of each other, so when the library
+ * is built with OpenMP they are intersected in parallel. The results are merged
+ * afterwards in the same order as the pairs were found, which gives exactly the
+ * same CrossingSet as a single thread would. The bounds cached in the paths are
+ * published with a compare-and-swap, so the tasks can fill them in as they go. */
 CrossingSet crossings_among(std::vector<Path> const &p) {
     CrossingSet results(p.size(), Crossings());
     if(p.empty()) return results;
     
-    SimpleCrosser cc;
-    
     std::vector<std::vector<unsigned> > cull = sweep_bounds(bounds(p));
+    std::vector<CrossingTask> tasks;
     for(unsigned i = 0; i < cull.size(); i++) {
-        Crossings res = self_crossings(p[i]);
-        for(unsigned k = 0; k < res.size(); k++) { res[k].a = res[k].b = i; }
-        merge_crossings(results[i], res, i);
-        flip_crossings(res);
-        merge_crossings(results[i], res, i);
+        tasks.push_back(CrossingTask(i, i));
         for(unsigned jx = 0; jx < cull[i].size(); jx++) {
-            unsigned j = cull[i][jx];
-            
-            Crossings res = cc.crossings(p[i], p[j]);
-            for(unsigned k = 0; k < res.size(); k++) { res[k].a = i; res[k].b = j; }
-            merge_crossings(results[i], res, i);
-            merge_crossings(results[j], res, j);
+            tasks.push_back(CrossingTask(i, cull[i][jx]));
+        }
+    }
+
+    int n = tasks.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(n > 1)
+#endif
+    for(int x = 0; x < n; x++) {
+        // exceptions must not leave the parallel region
+        try {
+            tasks[x].run(p);
+        } catch(...) {
+            tasks[x].failed = true;
+        }
+    }
+
+    for(int x = 0; x < n; x++) {
+        CrossingTask &t = tasks[x];
+        // run it again here, so that the caller gets the same exception as before
+        if(t.failed) t.run(p);
+        if(t.a == t.b) {
+            merge_crossings(results[t.a], t.result, t.a);
+            flip_crossings(t.result);
+            merge_crossings(results[t.a], t.result, t.a);
+        } else {
+            merge_crossings(results[t.a], t.result, t.a);
+            merge_crossings(results[t.b], t.result, t.b);
         }
     }
     return results;
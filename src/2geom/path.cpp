@@ -36,6 +36,7 @@
 
 #include <2geom/path.h>
 #include <algorithm>
+#include <typeinfo>
 
 
 using namespace Geom::PathInternal;
@@ -43,32 +44,125 @@ using namespace Geom::PathInternal;
 namespace Geom
 {
 
+namespace PathInternal {
+
+CurveSlot::CurveSlot(Curve *c) : kind_(BOXED) {
+  // only exact types go inline; subclasses such as ClosingSegment must keep their identity
+  std::type_info const &type = typeid(*c);
+  if (type == typeid(LineSegment)) {
+    set(*static_cast<LineSegment *>(c));
+  } else if (type == typeid(QuadraticBezier)) {
+    set(*static_cast<QuadraticBezier *>(c));
+  } else if (type == typeid(CubicBezier)) {
+    set(*static_cast<CubicBezier *>(c));
+  } else {
+    boxed_.reset(c);
+    return;
+  }
+  delete c;
+}
+
+void CurveSlot::assign(CurveSlot const &other) {
+  switch (other.kind_) {
+    case LINE:
+      set(static_cast<LineSegment const &>(*other));
+      break;
+    case QUADRATIC:
+      set(static_cast<QuadraticBezier const &>(*other));
+      break;
+    case CUBIC:
+      set(static_cast<CubicBezier const &>(*other));
+      break;
+    default:
+      boxed_ = other.boxed_;
+      break;
+  }
+}
+
+boost::shared_ptr<Curve const> CurveSlot::ref() const {
+  if (kind_ == BOXED) return boxed_;
+  return boost::shared_ptr<Curve const>(get()->duplicate());
+}
+
+bool CurveSlot::operator==(CurveSlot const &other) const {
+  return *get() == *other.get();
+}
+
+} // end namespace PathInternal
+
+namespace {
+
+// stores value in slot unless another thread got there first, and returns the stored one
+template <typename T>
+T const *publish(boost::atomic<T const *> &slot, T const *value) {
+  T const *expected = NULL;
+  if (slot.compare_exchange_strong(expected, value, boost::memory_order_acq_rel)) {
+    return value;
+  }
+  delete value;
+  return expected;
+}
+
+} // end anonymous namespace
+
 OptRect Path::boundsFast() const {
+  BoundsCache &cache = *bounds_;
+  if (OptRect const *cached = cache.fast.load(boost::memory_order_acquire)) return *cached;
   OptRect bounds;
-  if (empty()) return bounds;
-  bounds = front().boundsFast();
-  const_iterator iter = begin();
-  // the closing path segment can be ignored, because it will always lie within the bbox of the rest of the path
-  if ( iter != end() ) {
-    for ( ++iter; iter != end() ; ++iter ) {
-      bounds.unionWith(iter->boundsFast());
+  if (!empty()) {
+    // the closing path segment can be ignored, because it will always lie within the bbox of the rest of the path
+    if (std::vector<Rect> const *curves = cache.curves.load(boost::memory_order_acquire)) {
+      bounds = (*curves)[0];
+      for (unsigned i = 1; i < size_open(); ++i) {
+        bounds.unionWith((*curves)[i]);
+      }
+    } else {
+      bounds = front().boundsFast();
+      for (const_iterator iter = ++begin(); iter != end(); ++iter) {
+        bounds.unionWith(iter->boundsFast());
+      }
     }
   }
-  return bounds;
+  return *publish(cache.fast, new OptRect(bounds));
 }
 
 OptRect Path::boundsExact() const {
+  BoundsCache &cache = *bounds_;
+  if (OptRect const *cached = cache.exact.load(boost::memory_order_acquire)) return *cached;
   OptRect bounds;
-  if (empty()) return bounds;
-  bounds = front().boundsExact();
-  const_iterator iter = begin();
-  // the closing path segment can be ignored, because it will always lie within the bbox of the rest of the path
-  if ( iter != end() ) {
-    for ( ++iter; iter != end() ; ++iter ) {
+  if (!empty()) {
+    bounds = front().boundsExact();
+    // the closing path segment can be ignored, because it will always lie within the bbox of the rest of the path
+    for (const_iterator iter = ++begin(); iter != end(); ++iter) {
       bounds.unionWith(iter->boundsExact());
     }
   }
-  return bounds;
+  return *publish(cache.exact, new OptRect(bounds));
+}
+
+std::vector<Rect> const &Path::curveBounds() const {
+  BoundsCache &cache = *bounds_;
+  if (std::vector<Rect> const *cached = cache.curves.load(boost::memory_order_acquire)) {
+    return *cached;
+  }
+  std::vector<Rect> *curves = new std::vector<Rect>();
+  curves->reserve(size_closed());
+  for (Sequence::const_iterator it = get_curves().begin(); it != get_curves().end(); ++it) {
+    curves->push_back((*it)->boundsFast());
+  }
+  return *publish(cache.curves, curves);
+}
+
+std::vector<Coord> Path::cumulativeLengths(Coord tolerance) const {
+  std::vector<Coord> ret;
+  ret.reserve(size_default() + 1);
+  Coord sum = 0;
+  ret.push_back(sum);
+  for (const_iterator it = begin(); it != end_default(); ++it) {
+    sum += it->length(tolerance);
+    ret.push_back(sum);
+  }
+  return ret;
 }
 
 template<typename iter>
@@ -85,7 +179,14 @@ Path &Path::operator*=(Affine const &m) {
   Sequence::iterator it;
   Point prev;
   for (it = get_curves().begin() ; it != last ; ++it) {
-    *it = boost::shared_ptr<Curve>((*it)->transformed(m));
+    if (it->is_inline()) {
+      BezierCurve &b = it->inline_bezier();
+      for (unsigned i = 0; i <= b.order(); ++i) {
+        b.setPoint(i, b[i] * m);
+      }
+    } else {
+      *it = CurveSlot((*it)->transformed(m));
+    }
     if ( it != get_curves().begin() && (*it)->initialPoint() != prev ) {
       THROW_CONTINUITYERROR();
     }
@@ -313,9 +414,10 @@ void Path::appendPortionTo(Path &ret, double from, double to) const {
     delete fromv;
   }
   if(from >= to) {
-    const_iterator ender = end();
-    if(ender->initialPoint() == ender->finalPoint()) ++ender;
-    ret.insert(ret.end(), ++fromi, ender, STITCH_DISCONTINUOUS);
+    // wrap around through the closing segment, unless it is degenerate
+    unsigned last = size_open();
+    if(back_closed().initialPoint() != back_closed().finalPoint()) ++last;
+    if(fi + 1 < last) ret.insert(ret.end(), ++fromi, inc(begin(), last), STITCH_DISCONTINUOUS);
     ret.insert(ret.end(), begin(), toi, STITCH_DISCONTINUOUS);
   } else {
     ret.insert(ret.end(), ++fromi, toi, STITCH_DISCONTINUOUS);
@@ -347,16 +449,20 @@ void Path::do_update(Sequence::iterator first_replaced,
 }
 
 void Path::do_append(Curve *c) {
-  boost::shared_ptr<Curve> curve(c);
+  CurveSlot curve(c);
+  check_append(*curve);
+  get_curves().insert(get_curves().end()-1, curve);
+  final_->setPoint(0, curve->finalPoint());
+}
+
+void Path::check_append(Curve const &curve) {
   if ( get_curves().front().get() == final_ ) {
-    final_->setPoint(1, curve->initialPoint());
+    final_->setPoint(1, curve.initialPoint());
   } else {
-    if (curve->initialPoint() != finalPoint()) {
+    if (curve.initialPoint() != finalPoint()) {
       THROW_CONTINUITYERROR();
     }
   }
-  get_curves().insert(get_curves().end()-1, curve);
-  final_->setPoint(0, curve->finalPoint());
 }
 
 void Path::stitch(Sequence::iterator first_replaced,
@@ -368,21 +474,21 @@ void Path::stitch(Sequence::iterator first_replaced,
       if ( (*first_replaced)->initialPoint() != source.front()->initialPoint() ) {
         Curve *stitch = new StitchSegment((*first_replaced)->initialPoint(),
                                           source.front()->initialPoint());
-        source.insert(source.begin(), boost::shared_ptr<Curve>(stitch));
+        source.insert(source.begin(), CurveSlot(stitch));
       }
     }
     if ( last_replaced != (get_curves().end()-1) ) {
       if ( (*last_replaced)->finalPoint() != source.back()->finalPoint() ) {
         Curve *stitch = new StitchSegment(source.back()->finalPoint(),
                                           (*last_replaced)->finalPoint());
-        source.insert(source.end(), boost::shared_ptr<Curve>(stitch));
+        source.insert(source.end(), CurveSlot(stitch));
       }
     }
   } else if ( first_replaced != last_replaced && first_replaced != get_curves().begin() && last_replaced != get_curves().end()-1) {
     if ( (*first_replaced)->initialPoint() != (*(last_replaced-1))->finalPoint() ) {
       Curve *stitch = new StitchSegment((*(last_replaced-1))->finalPoint(),
                                         (*first_replaced)->initialPoint());
-      source.insert(source.begin(), boost::shared_ptr<Curve>(stitch));
+      source.insert(source.begin(), CurveSlot(stitch));
     }
   }
 }
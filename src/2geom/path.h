@@ -37,7 +37,9 @@
 
 #include <iterator>
 #include <algorithm>
+#include <new>
 #include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
 #include <2geom/curve.h>
 #include <2geom/bezier-curve.h>
 
@@ -47,7 +49,96 @@ class Path;
 
 namespace PathInternal {
 
-typedef std::vector<boost::shared_ptr<Curve const> > Sequence;
+template <typename T> struct SlotKind { enum { value = 0 }; };
+template <> struct SlotKind<LineSegment> { enum { value = 1 }; };
+template <> struct SlotKind<QuadraticBezier> { enum { value = 2 }; };
+template <> struct SlotKind<CubicBezier> { enum { value = 3 }; };
+
+/*
+ * One curve of a path. Line segments and quadratic and cubic Beziers, which
+ * make up nearly all real paths, are stored by value inside the slot, so that
+ * the curves of a path lie next to each other in memory and need no reference
+ * count. Other curves, including subclasses of the inline types, are boxed in
+ * a shared pointer like before.
+ */
+class CurveSlot {
+public:
+  CurveSlot() : kind_(BOXED) {}
+  // n.b. takes ownership of curve object
+  explicit CurveSlot(Curve *c);
+  explicit CurveSlot(boost::shared_ptr<Curve const> const &c) : kind_(BOXED), boxed_(c) {}
+
+  /// Replace the curve with a copy of another, inline if its type allows it.
+  template <typename CurveType>
+  void set(CurveType const &c) {
+    destroy();
+    if (int(SlotKind<CurveType>::value) != int(BOXED)) {
+      new (storage_.bytes) CurveType(c);
+      kind_ = Kind(SlotKind<CurveType>::value);
+    } else {
+      boxed_.reset(new CurveType(c));
+    }
+  }
+
+  CurveSlot(CurveSlot const &other) : kind_(BOXED) { assign(other); }
+  CurveSlot &operator=(CurveSlot const &other) {
+    if (this != &other) {
+      destroy();
+      assign(other);
+    }
+    return *this;
+  }
+  ~CurveSlot() { destroy(); }
+
+  Curve const &operator*() const { return *get(); }
+  Curve const *operator->() const { return get(); }
+  Curve const *get() const {
+    return kind_ == BOXED ? boxed_.get() : inline_curve();
+  }
+
+  bool is_inline() const { return kind_ != BOXED; }
+  /// Whether the curve may be modified in place.
+  bool unique() const { return kind_ != BOXED || boxed_.unique(); }
+  /// Inline curves are Bezier curves, and can be modified through this.
+  BezierCurve &inline_bezier() { return *static_cast<BezierCurve *>(inline_curve()); }
+  /// Shared reference to the curve; inline curves are duplicated on every call.
+  boost::shared_ptr<Curve const> ref() const;
+
+  /// Curves are compared by value, see Curve::operator==().
+  bool operator==(CurveSlot const &other) const;
+  bool operator!=(CurveSlot const &other) const { return !(*this == other); }
+
+private:
+  enum Kind { BOXED = 0, LINE = 1, QUADRATIC = 2, CUBIC = 3 };
+
+  enum {
+    BEZIER_SIZE = sizeof(QuadraticBezier) > sizeof(CubicBezier)
+                ? sizeof(QuadraticBezier) : sizeof(CubicBezier),
+    STORAGE_SIZE = sizeof(LineSegment) > BEZIER_SIZE ? sizeof(LineSegment) : BEZIER_SIZE
+  };
+
+  Curve *inline_curve() const {
+    return reinterpret_cast<Curve *>(const_cast<char *>(storage_.bytes));
+  }
+  void assign(CurveSlot const &other);
+  void destroy() {
+    if (kind_ != BOXED) {
+      inline_curve()->~Curve();
+      kind_ = BOXED;
+    }
+    boxed_.reset();
+  }
+
+  Kind kind_;
+  boost::shared_ptr<Curve const> boxed_;
+  union {
+    char bytes[STORAGE_SIZE];
+    double align_double;
+    void *align_pointer;
+  } storage_;
+};
+
+typedef std::vector<CurveSlot> Sequence;
 
 template <typename C, typename P>
 class BaseIterator {
@@ -66,6 +157,7 @@ public:
 
   Curve const &operator*() const { return (*path)[index]; }
   Curve const *operator->() const { return &(*path)[index]; }
+  /// Inline curves are copied on every call, so the pointer identifies the curve only when boxed.
   boost::shared_ptr<Curve const> get_ref() const {
     return path->get_ref_at_index(index);
   }
@@ -149,6 +241,7 @@ private:
 class Path {
 public:
   typedef PathInternal::Sequence Sequence;
+  typedef PathInternal::CurveSlot CurveSlot;
   typedef PathInternal::Iterator iterator;
   typedef PathInternal::ConstIterator const_iterator;
   typedef Sequence::size_type size_type;
@@ -178,11 +271,12 @@ public:
   // Path(Path const &other) - use default copy constructor
 
   explicit Path(Point p=Point())
-  : curves_(boost::shared_ptr<Sequence>(new Sequence(1, boost::shared_ptr<Curve>()))),
+  : curves_(boost::shared_ptr<Sequence>(new Sequence(1, CurveSlot()))),
     final_(new ClosingSegment(p, p)),
-    closed_(false)
+    closed_(false),
+    bounds_(new BoundsCache())
   {
-    get_curves().back() = boost::shared_ptr<Curve>(final_);
+    get_curves().back() = CurveSlot(final_);
   }
 
   Path(const_iterator const &first,
@@ -190,7 +284,8 @@ public:
        bool closed=false)
   : curves_(boost::shared_ptr<Sequence>(new Sequence(seq_iter(first),
                                                      seq_iter(last)))),
-    closed_(closed)
+    closed_(closed),
+    bounds_(new BoundsCache())
   {
     if (!get_curves().empty()) {
       final_ = new ClosingSegment(get_curves().back()->finalPoint(),
@@ -198,7 +293,7 @@ public:
     } else {
       final_ = new ClosingSegment();
     }
-    get_curves().push_back(boost::shared_ptr<Curve>(final_));
+    get_curves().push_back(CurveSlot(final_));
   }
 
   virtual ~Path() {}
@@ -209,12 +304,16 @@ public:
     std::swap(other.curves_, curves_);
     std::swap(other.final_, final_);
     std::swap(other.closed_, closed_);
+    std::swap(other.bounds_, bounds_);
   }
 
   Curve const &operator[](unsigned i) const { return *get_curves()[i]; }
   Curve const &at_index(unsigned i) const { return *get_curves()[i]; }
+  /** @brief Shared reference to a curve.
+   * Line segments and quadratic and cubic Beziers are stored inline, and each call returns
+   * a new copy of them; other curves are shared with the path. */
   boost::shared_ptr<Curve const> get_ref_at_index(unsigned i) {
-    return get_curves()[i];
+    return get_curves()[i].ref();
   }
 
   Curve const &front() const { return *get_curves()[0]; }
@@ -252,8 +351,19 @@ public:
   bool closed() const { return closed_; }
   void close(bool closed=true) { closed_ = closed; }
 
+  /* The bounds are computed on first use and shared by copies of the path,
+   * until the path is modified. They may be requested from several threads at once. */
   OptRect boundsFast() const;
   OptRect boundsExact() const;
+  /** @brief Fast bounds of each curve, including the closing segment.
+   * The result has size_closed() entries and stays valid until the path is modified. */
+  std::vector<Rect> const &curveBounds() const;
+
+  /** @brief Lengths of the path up to the end of each curve.
+   * The result has size_default() + 1 entries: zero, then the running sum of
+   * the curve lengths, so the last entry is the length of the whole path.
+   * Each curve is measured natively with the given tolerance. */
+  std::vector<Coord> cumulativeLengths(Coord tolerance = 0.01) const;
 
   Piecewise<D2<SBasis> > toPwSb() const {
     Piecewise<D2<SBasis> > ret;
@@ -275,10 +385,14 @@ public:
     return ret;
   }
 
+  /// Paths are equal when they have equal curves, compared by value.
   bool operator==(Path const &other) const {
     if (this == &other) return true;
     if (closed_ != other.closed_) return false;
-    return get_curves() == other.get_curves();
+    if (curves_ == other.curves_) return true;
+    // the closing segment follows from the other curves
+    return size() == other.size() && initialPoint() == other.initialPoint()
+        && std::equal(get_curves().begin(), get_curves().end()-1, other.get_curves().begin());
   }
   bool operator!=(Path const &other) const {
     return !( *this == other );
@@ -385,11 +499,11 @@ public:
     for ( Sequence::iterator iter = ret.get_curves().begin() ;
           iter != ret.get_curves().end()-1 ; ++iter )
     {
-      *iter = boost::shared_ptr<Curve>((*iter)->reverse());
+      *iter = CurveSlot((*iter)->reverse());
     }
     std::reverse(ret.get_curves().begin(), ret.get_curves().end()-1);
     ret.final_ = static_cast<ClosingSegment *>(ret.final_->reverse());
-    ret.get_curves().back() = boost::shared_ptr<Curve>(ret.final_);
+    ret.get_curves().back() = CurveSlot(ret.final_);
     return ret;
   }
 
@@ -398,7 +512,7 @@ public:
   {
     unshare();
     Sequence::iterator seq_pos(seq_iter(pos));
-    Sequence source(1, boost::shared_ptr<Curve>(curve.duplicate()));
+    Sequence source(1, CurveSlot(curve.duplicate()));
     if (stitching) stitch(seq_pos, seq_pos, source);
     do_update(seq_pos, seq_pos, source.begin(), source.end());
   }
@@ -461,7 +575,7 @@ public:
   {
     unshare();
     Sequence::iterator seq_replaced(seq_iter(replaced));
-    Sequence source(1, boost::shared_ptr<Curve>(curve.duplicate()));
+    Sequence source(1, CurveSlot(curve.duplicate()));
     if (stitching) stitch(seq_replaced, seq_replaced+1, source);
     do_update(seq_replaced, seq_replaced+1, source.begin(), source.end());
   }
@@ -473,7 +587,7 @@ public:
     unshare();
     Sequence::iterator seq_first_replaced(seq_iter(first_replaced));
     Sequence::iterator seq_last_replaced(seq_iter(last_replaced));
-    Sequence source(1, boost::shared_ptr<Curve>(curve.duplicate()));
+    Sequence source(1, CurveSlot(curve.duplicate()));
     if (stitching) stitch(seq_first_replaced, seq_last_replaced, source);
     do_update(seq_first_replaced, seq_last_replaced,
               source.begin(), source.end());
@@ -519,10 +633,10 @@ public:
   {
 	  if ( empty() ) return;
           unshare();
-	  boost::shared_ptr<Curve> head(front().duplicate());
+	  Curve *head = front().duplicate();
 	  head->setInitial(p);
 	  Sequence::iterator replaced = get_curves().begin();
-	  Sequence source(1, head);
+	  Sequence source(1, CurveSlot(head));
 	  do_update(replaced, replaced + 1, source.begin(), source.end());
   }
 
@@ -530,10 +644,10 @@ public:
   {
 	  if ( empty() ) return;
           unshare();
-	  boost::shared_ptr<Curve> tail(back().duplicate());
+	  Curve *tail = back().duplicate();
 	  tail->setFinal(p);
 	  Sequence::iterator replaced = get_curves().end() - 2;
-	  Sequence source(1, tail);
+	  Sequence source(1, CurveSlot(tail));
 	  do_update(replaced, replaced + 1, source.begin(), source.end());
   }
 
@@ -567,40 +681,40 @@ public:
   template <typename CurveType, typename A>
   void appendNew(A a) {
     unshare();
-    do_append(new CurveType(finalPoint(), a));
+    do_append_copy(CurveType(finalPoint(), a));
   }
 
   template <typename CurveType, typename A, typename B>
   void appendNew(A a, B b) {
     unshare();
-    do_append(new CurveType(finalPoint(), a, b));
+    do_append_copy(CurveType(finalPoint(), a, b));
   }
 
   template <typename CurveType, typename A, typename B, typename C>
   void appendNew(A a, B b, C c) {
     unshare();
-    do_append(new CurveType(finalPoint(), a, b, c));
+    do_append_copy(CurveType(finalPoint(), a, b, c));
   }
 
   template <typename CurveType, typename A, typename B, typename C,
                                 typename D>
   void appendNew(A a, B b, C c, D d) {
     unshare();
-    do_append(new CurveType(finalPoint(), a, b, c, d));
+    do_append_copy(CurveType(finalPoint(), a, b, c, d));
   }
 
   template <typename CurveType, typename A, typename B, typename C,
                                 typename D, typename E>
   void appendNew(A a, B b, C c, D d, E e) {
     unshare();
-    do_append(new CurveType(finalPoint(), a, b, c, d, e));
+    do_append_copy(CurveType(finalPoint(), a, b, c, d, e));
   }
 
   template <typename CurveType, typename A, typename B, typename C,
                                 typename D, typename E, typename F>
   void appendNew(A a, B b, C c, D d, E e, F f) {
     unshare();
-    do_append(new CurveType(finalPoint(), a, b, c, d, e, f));
+    do_append_copy(CurveType(finalPoint(), a, b, c, d, e, f));
   }
 
   template <typename CurveType, typename A, typename B, typename C,
@@ -608,7 +722,7 @@ public:
                                 typename G>
   void appendNew(A a, B b, C c, D d, E e, F f, G g) {
     unshare();
-    do_append(new CurveType(finalPoint(), a, b, c, d, e, f, g));
+    do_append_copy(CurveType(finalPoint(), a, b, c, d, e, f, g));
   }
 
   template <typename CurveType, typename A, typename B, typename C,
@@ -616,7 +730,7 @@ public:
                                 typename G, typename H>
   void appendNew(A a, B b, C c, D d, E e, F f, G g, H h) {
     unshare();
-    do_append(new CurveType(finalPoint(), a, b, c, d, e, f, g, h));
+    do_append_copy(CurveType(finalPoint(), a, b, c, d, e, f, g, h));
   }
 
   template <typename CurveType, typename A, typename B, typename C,
@@ -624,7 +738,7 @@ public:
                                 typename G, typename H, typename I>
   void appendNew(A a, B b, C c, D d, E e, F f, G g, H h, I i) {
     unshare();
-    do_append(new CurveType(finalPoint(), a, b, c, d, e, f, g, h, i));
+    do_append_copy(CurveType(finalPoint(), a, b, c, d, e, f, g, h, i));
   }
 
 private:
@@ -639,12 +753,18 @@ private:
   Sequence const &get_curves() const { return *curves_; }
 
   void unshare() {
+    // every modification starts here
+    if (bounds_.unique()) {
+      bounds_->clear();
+    } else {
+      bounds_.reset(new BoundsCache());
+    }
     if (!curves_.unique()) {
       curves_ = boost::shared_ptr<Sequence>(new Sequence(*curves_));
     }
     if (!get_curves().back().unique()) {
       final_ = static_cast<ClosingSegment *>(final_->duplicate());
-      get_curves().back() = boost::shared_ptr<Curve>(final_);
+      get_curves().back() = CurveSlot(final_);
     }
   }
 
@@ -660,14 +780,41 @@ private:
   // n.b. takes ownership of curve object
   void do_append(Curve *curve);
 
+  // stores the curve inline when possible, without a heap copy
+  template <typename CurveType>
+  void do_append_copy(CurveType const &curve) {
+    check_append(curve);
+    get_curves().insert(get_curves().end()-1, CurveSlot())->set(curve);
+    final_->setPoint(0, curve.finalPoint());
+  }
+
+  void check_append(Curve const &curve);
+
   void check_continuity(Sequence::iterator first_replaced,
                         Sequence::iterator last_replaced,
                         Sequence::iterator first,
                         Sequence::iterator last);
 
+  /* Each entry is computed into a new object and published with a compare-and-swap,
+   * so that const methods can fill the cache from several threads without a lock.
+   * A thread that loses the race deletes its own copy; published entries never change
+   * until clear(), which is only called while modifying the path. */
+  struct BoundsCache {
+    boost::atomic<OptRect const *> fast, exact;
+    boost::atomic<std::vector<Rect> const *> curves;
+    BoundsCache() : fast(NULL), exact(NULL), curves(NULL) {}
+    ~BoundsCache() { clear(); }
+    void clear() {
+      delete fast.exchange(NULL);
+      delete exact.exchange(NULL);
+      delete curves.exchange(NULL);
+    }
+  };
+
   boost::shared_ptr<Sequence> curves_;
   ClosingSegment *final_;
   bool closed_;
+  boost::shared_ptr<BoundsCache> bounds_;
 };  // end class Path
 
 inline static Piecewise<D2<SBasis> > paths_to_pw(std::vector<Path> paths) {
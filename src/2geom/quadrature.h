@@ -0,0 +1,102 @@
+/**
+ * \file
+ * \brief Adaptive Gauss-Legendre quadrature
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_QUADRATURE_H
+#define LIB2GEOM_SEEN_QUADRATURE_H
+
+#include <cmath>
+#include <2geom/coord.h>
+
+namespace Geom {
+
+/** @brief Five point Gauss-Legendre rule on one interval.
+ * Exact for polynomials up to degree nine. */
+template <typename F>
+Coord gauss_legendre_5(F const &f, Coord from, Coord to)
+{
+    Coord mid = (from + to) / 2, half = (to - from) / 2;
+    return half * (0.5688888888888889 * f(mid)
+                 + 0.4786286704993665 * (f(mid - half * 0.5384693101056831) + f(mid + half * 0.5384693101056831))
+                 + 0.2369268850561891 * (f(mid - half * 0.9061798459386640) + f(mid + half * 0.9061798459386640)));
+}
+
+/** @brief Five and three point Gauss-Legendre rules on one interval.
+ * The rules share the midpoint, so this costs seven evaluations. The difference of the
+ * two results bounds the error of the five point one for smooth functions. */
+template <typename F>
+void gauss_legendre_5_3(F const &f, Coord from, Coord to, Coord &g5, Coord &g3)
+{
+    static const Coord n5a = 0.5384693101056831, n5b = 0.9061798459386640;
+    static const Coord w5m = 0.5688888888888889, w5a = 0.4786286704993665, w5b = 0.2369268850561891;
+    static const Coord n3 = 0.7745966692414834;
+
+    Coord mid = (from + to) / 2, half = (to - from) / 2;
+    Coord fm = f(mid);
+    g5 = w5m * fm
+       + w5a * (f(mid - half * n5a) + f(mid + half * n5a))
+       + w5b * (f(mid - half * n5b) + f(mid + half * n5b));
+    g3 = (8 * fm + 5 * (f(mid - half * n3) + f(mid + half * n3))) / 9;
+    g5 *= half;
+    g3 *= half;
+}
+
+/** @brief Integrate a function over an interval by adaptive Gauss-Legendre quadrature.
+ * Each interval is integrated with gauss_legendre_5_3(). Intervals whose error estimate
+ * exceeds their share of the tolerance are halved, at most @a depth times. The function
+ * is called as f(x) and should be smooth on the interval. The error estimate can miss
+ * a kink inside an interval, so split the integral at known kinks beforehand.
+ * @param tolerance Maximum allowed absolute error */
+template <typename F>
+Coord integrate_gauss(F const &f, Coord from, Coord to, Coord tolerance, unsigned depth = 20)
+{
+    Coord g5, g3;
+    gauss_legendre_5_3(f, from, to, g5, g3);
+    if (depth == 0 || std::fabs(g5 - g3) <= tolerance) {
+        return g5;
+    }
+    Coord mid = (from + to) / 2;
+    return integrate_gauss(f, from, mid, tolerance / 2, depth - 1)
+         + integrate_gauss(f, mid, to, tolerance / 2, depth - 1);
+}
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_QUADRATURE_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
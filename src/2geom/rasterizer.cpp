@@ -0,0 +1,213 @@
+/*
+ * Scanline rasterization of path vectors into pixel buffers
+ *
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/rasterizer.h>
+#include <2geom/path-flatten.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Geom {
+
+struct Rasterizer::TopOrder {
+    bool operator()(Edge const &a, Edge const &b) const { return a.y0 < b.y0; }
+};
+
+Rasterizer::Rasterizer(PathVector const &pv, Coord tolerance)
+{
+    std::vector<Point> pts;
+    std::vector<unsigned> offsets;
+    flatten(pv, tolerance, pts, offsets);
+
+    for (unsigned i = 0; i < pv.size(); ++i) {
+        unsigned first = offsets[i], last = offsets[i+1] - 1;
+        // every polyline gets a closing edge, so that open paths are filled as closed
+        for (unsigned k = first; k <= last; ++k) {
+            Point a = pts[k], b = pts[k == last ? first : k + 1];
+            if (a[Y] == b[Y]) continue;
+            Edge e;
+            e.dir = a[Y] > b[Y] ? 1 : -1;
+            if (e.dir > 0) std::swap(a, b);
+            e.x0 = a[X];
+            e.y0 = a[Y];
+            e.y1 = b[Y];
+            e.dxdy = (b[X] - a[X]) / (b[Y] - a[Y]);
+            _edges.push_back(e);
+        }
+    }
+    std::sort(_edges.begin(), _edges.end(), TopOrder());
+}
+
+void Rasterizer::winding(IntRect const &area, int *out) const
+{
+    int w = area.width(), h = area.height();
+    if (w <= 0 || h <= 0) return;
+
+    std::vector<unsigned> active;
+    std::vector<int> acc(w + 1);
+    unsigned next = 0;
+    for (int i = 0; i < h; ++i, out += w) {
+        // an edge crosses the row when its top is at or above the centers and its bottom
+        // is below them, so that a vertex shared by two edges is counted once
+        Coord yc = area.top() + i + 0.5;
+        for (; next < _edges.size() && _edges[next].y0 <= yc; ++next) {
+            if (_edges[next].y1 > yc) active.push_back(next);
+        }
+        for (unsigned j = 0; j < active.size();) {
+            if (_edges[active[j]].y1 <= yc) {
+                active[j] = active.back();
+                active.pop_back();
+            } else {
+                ++j;
+            }
+        }
+
+        // every edge counts for the centers to its right
+        std::fill(acc.begin(), acc.end(), 0);
+        for (unsigned j = 0; j < active.size(); ++j) {
+            Edge const &e = _edges[active[j]];
+            Coord x = e.xAt(yc) - area.left() - 0.5;
+            x = std::min(std::max(x, -1.0), Coord(w - 1));
+            acc[int(std::floor(x)) + 1] += e.dir;
+        }
+        int wind = 0;
+        for (int j = 0; j < w; ++j) {
+            wind += acc[j];
+            out[j] = wind;
+        }
+    }
+}
+
+// the integral of clamp(s, 0, 1) from 0 to u
+static inline Coord ramp_integral(Coord u)
+{
+    if (u <= 0) return 0;
+    if (u < 1) return 0.5 * u * u;
+    return u - 0.5;
+}
+
+/* Adds the differences between consecutive cells of the area that a line from xa to xb,
+ * with 0 <= xa <= xb, covers towards the right within a strip of height d. */
+static void accumulate_span(Coord *acc, Coord xa, Coord xb, Coord d)
+{
+    int c0 = int(xa), c1 = int(xb);
+    if (c0 == c1) {
+        Coord cover = c0 + 1 - 0.5 * (xa + xb);
+        acc[c0] += d * cover;
+        acc[c0 + 1] += d * (1 - cover);
+        return;
+    }
+    Coord dx = xb - xa;
+    Coord prev = 0;
+    for (int c = c0; c <= c1; ++c) {
+        Coord cover = (ramp_integral(c + 1 - xa) - ramp_integral(c + 1 - xb)) / dx;
+        acc[c] += d * (cover - prev);
+        prev = cover;
+    }
+    acc[c1 + 1] += d * (1 - prev);
+}
+
+// clips the line to [0, w] before accumulating it; whatever lies left of the area covers it all
+static void accumulate_line(Coord *acc, int w, Coord xa, Coord xb, Coord d)
+{
+    if (xa > xb) std::swap(xa, xb);
+    if (xb <= 0) {
+        acc[0] += d;
+        return;
+    }
+    if (xa >= w) return;
+    if (xa < 0) {
+        Coord left = d * -xa / (xb - xa);
+        acc[0] += left;
+        d -= left;
+        xa = 0;
+    }
+    if (xb > w) {
+        d *= (w - xa) / (xb - xa);
+        xb = w;
+    }
+    accumulate_span(acc, xa, xb, d);
+}
+
+void Rasterizer::coverage(IntRect const &area, Coord *out, bool evenodd) const
+{
+    int w = area.width(), h = area.height();
+    if (w <= 0 || h <= 0) return;
+
+    std::vector<unsigned> active;
+    std::vector<Coord> acc(w + 2);
+    unsigned next = 0;
+    for (int i = 0; i < h; ++i, out += w) {
+        Coord top = area.top() + i, bottom = top + 1;
+        for (; next < _edges.size() && _edges[next].y0 < bottom; ++next) {
+            if (_edges[next].y1 > top) active.push_back(next);
+        }
+        for (unsigned j = 0; j < active.size();) {
+            if (_edges[active[j]].y1 <= top) {
+                active[j] = active.back();
+                active.pop_back();
+            } else {
+                ++j;
+            }
+        }
+
+        std::fill(acc.begin(), acc.end(), 0.0);
+        for (unsigned j = 0; j < active.size(); ++j) {
+            Edge const &e = _edges[active[j]];
+            Coord ya = std::max(e.y0, top), yb = std::min(e.y1, bottom);
+            accumulate_line(&acc[0], w, e.xAt(ya) - area.left(), e.xAt(yb) - area.left(),
+                            e.dir * (yb - ya));
+        }
+
+        // the running sum is the signed area of the fill within each pixel
+        Coord wind = 0;
+        for (int j = 0; j < w; ++j) {
+            wind += acc[j];
+            Coord a = std::fabs(wind);
+            if (evenodd) {
+                a = std::fmod(a, 2.0);
+                out[j] = a > 1 ? 2 - a : a;
+            } else {
+                out[j] = std::min(a, 1.0);
+            }
+        }
+    }
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
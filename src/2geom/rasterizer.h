@@ -0,0 +1,96 @@
+/**
+ * \file
+ * \brief Scanline rasterization of path vectors into pixel buffers
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_RASTERIZER_H
+#define LIB2GEOM_SEEN_RASTERIZER_H
+
+#include <vector>
+#include <2geom/pathvector.h>
+#include <2geom/int-rect.h>
+
+namespace Geom {
+
+/**
+ * @brief Fill of a path vector sampled on a pixel grid.
+ *
+ * The paths are flattened once, with flatten(), into edges sorted by their top.
+ * Each call then sweeps the rows of the requested area, keeping a table of the
+ * edges that cross the current row, so it costs time proportional to the number
+ * of pixels plus the number of edge crossings, instead of pixels times curves
+ * for repeated winding() calls. This makes it cheap to rasterize many tiles of
+ * one drawing.
+ *
+ * Path coordinates are pixel coordinates: pixel (x, y) is the unit square with
+ * its top left corner at (x, y). Buffers are filled row by row, starting at the
+ * top left corner of the area, and must hold area.width() * area.height() values.
+ * Open paths are filled as if they were closed, like in winding().
+ */
+class Rasterizer {
+public:
+    /** @brief Flattens the paths.
+     * @param tolerance Largest distance of the flattened edges from the curves, in pixels */
+    explicit Rasterizer(PathVector const &pv, Coord tolerance = 0.1);
+
+    /** @brief Winding numbers at the pixel centers.
+     * The result is the same as the sum of winding() over all paths at each center,
+     * up to the flattening tolerance. */
+    void winding(IntRect const &area, int *out) const;
+
+    /** @brief Fraction of each pixel covered by the fill, computed analytically.
+     * Overlapping edges of opposite directions inside one pixel cancel out, so the
+     * coverage of such pixels is approximate. */
+    void coverage(IntRect const &area, Coord *out, bool evenodd = true) const;
+
+private:
+    struct Edge {
+        Coord x0, y0, y1; // top end and bottom of the edge
+        Coord dxdy;
+        int dir;          // +1 for edges going up, -1 for edges going down
+        Coord xAt(Coord y) const { return x0 + (y - y0) * dxdy; }
+    };
+    struct TopOrder;
+
+    std::vector<Edge> _edges;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_RASTERIZER_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
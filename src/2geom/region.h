@@ -48,7 +48,7 @@ class Region {
     friend Shape shape_boolean(bool rev, Shape const & a, Shape const & b, CrossingSet const & crs);
 
     Path boundary;
-    mutable OptRect box;
+    OptRect box;
     bool fill;
   public:
     Region() : fill(true) {}
@@ -65,8 +65,8 @@ class Region {
     
     operator Path() const { return boundary; }
     Rect boundsFast() const {
-        if(!box) box = boundary.boundsFast();  /// \todo this doesn't look right at all...
-        return *box;
+        // the bounds of the boundary are cached by the path itself
+        return box ? *box : *boundary.boundsFast();
     }
     
     bool contains(Point const &p) const {
@@ -0,0 +1,544 @@
+/**
+ * \file
+ * \brief R-tree spatial index over rectangles
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_RTREE_H
+#define LIB2GEOM_SEEN_RTREE_H
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <2geom/rect.h>
+
+namespace Geom {
+
+/**
+ * @brief Spatial index of values with rectangular bounds.
+ *
+ * The tree can be bulk loaded with the Sort-Tile-Recursive algorithm, which
+ * gives nearly full nodes with little overlap, and then updated with insert()
+ * and erase(), which use Guttman's quadratic split and condense-tree.
+ *
+ * Nodes live in a single array and refer to each other by index. Every node stores
+ * the bounding boxes of its children next to the child indices, so a query only
+ * touches the nodes it actually descends into.
+ *
+ * Values need not be unique, but erase() removes only one matching value.
+ * @ingroup Utilities
+ */
+template <typename T>
+class RTree {
+public:
+    typedef T value_type;
+    typedef std::pair<Rect, T> Item;
+
+    /// Maximum and minimum number of children of a non-root node.
+    enum { NODE_CAPACITY = 16, NODE_MINIMUM = 6 };
+
+    RTree() { clear(); }
+    /// Bulk load the index from a range of Items.
+    template <typename Iter>
+    RTree(Iter first, Iter last) { assign(first, last); }
+
+    /// Replace the contents of the index with a range of Items.
+    template <typename Iter>
+    void assign(Iter first, Iter last) {
+        clear();
+        std::vector<Entry> entries;
+        for (; first != last; ++first) {
+            entries.push_back(Entry(first->first, _newValue(first->second)));
+        }
+        _size = entries.size();
+        if (entries.empty()) return;
+        _nodes.clear();
+
+        unsigned level = 0;
+        do {
+            entries = _pack(entries, level++);
+        } while (entries.size() > 1);
+        _root = entries.front().child;
+    }
+
+    void clear() {
+        _nodes.assign(1, Node(0));
+        _values.clear();
+        _free_nodes.clear();
+        _free_values.clear();
+        _root = 0;
+        _size = 0;
+    }
+
+    unsigned size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    /// Number of levels of nodes, including the leaves.
+    unsigned height() const { return _nodes[_root].level + 1; }
+    OptRect bounds() const { return _nodeBounds(_root); }
+
+    void insert(Rect const &r, T const &value) {
+        _insert(r, _newValue(value), 0);
+        ++_size;
+    }
+    void insert(Item const &item) { insert(item.first, item.second); }
+
+    /** @brief Remove a value with the given bounds.
+     * @return True if a matching value was found */
+    bool erase(Rect const &r, T const &value) {
+        std::vector<PathStep> path;
+        unsigned slot;
+        if (!_find(_root, r, value, path, slot)) return false;
+
+        unsigned leaf = path.empty() ? _root : _nodes[path.back().node].children[path.back().slot];
+        _free_values.push_back(_nodes[leaf].children[slot]);
+        _removeChild(leaf, slot);
+        --_size;
+        _condense(leaf, path);
+        return true;
+    }
+
+    /** @brief Visit all values whose bounds intersect the given area.
+     * The visitor is called as <tt>v(Rect const &bounds, T const &value)</tt> and should
+     * return false to stop the query.
+     * @return False if the visitor stopped the query */
+    template <typename Visitor>
+    bool visit(Rect const &area, Visitor &v) const {
+        if (_nodes[_root].count == 0) return true;
+        // nodes have at least NODE_MINIMUM children, so the tree is never deeper than 32 levels
+        unsigned stack[NODE_CAPACITY * 32];
+        unsigned depth = 0;
+        stack[depth++] = _root;
+        while (depth > 0) {
+            Node const &n = _nodes[stack[--depth]];
+            for (unsigned i = 0; i < n.count; ++i) {
+                if (!area.intersects(n.boxes[i])) continue;
+                if (n.level == 0) {
+                    if (!v(n.boxes[i], _values[n.children[i]])) return false;
+                } else {
+                    stack[depth++] = n.children[i];
+                }
+            }
+        }
+        return true;
+    }
+
+    /// Append all values whose bounds intersect the given area.
+    void query(Rect const &area, std::vector<T> &out) const {
+        Collector c(out);
+        visit(area, c);
+    }
+
+    /** @brief Visit values in order of increasing distance between their bounds and a point.
+     * The visitor is called as <tt>v(Rect const &bounds, T const &value, Coord distance)</tt>
+     * and should return false once it has seen enough values. When the bounds are
+     * only an approximation of the values, keep visiting while the box distance is
+     * below the best exact distance found so far.
+     * @return False if the visitor stopped the search */
+    template <typename Visitor>
+    bool visitNearest(Point const &p, Visitor &v) const {
+        std::priority_queue<Candidate> queue;
+        if (_nodes[_root].count != 0) {
+            queue.push(Candidate(0, _root, false));
+        }
+        while (!queue.empty()) {
+            Candidate c = queue.top();
+            queue.pop();
+            Node const &n = _nodes[c.node];
+            if (c.is_value) {
+                Rect const &box = n.boxes[c.slot];
+                if (!v(box, _values[n.children[c.slot]], std::sqrt(c.dist))) return false;
+                continue;
+            }
+            for (unsigned i = 0; i < n.count; ++i) {
+                Coord d = distanceSq(p, n.boxes[i]);
+                if (n.level == 0) {
+                    queue.push(Candidate(d, c.node, true, i));
+                } else {
+                    queue.push(Candidate(d, n.children[i], false));
+                }
+            }
+        }
+        return true;
+    }
+
+    /// Append the k values whose bounds are nearest to the point, closest first.
+    void nearest(Point const &p, unsigned k, std::vector<T> &out) const {
+        if (k == 0) return;
+        NearestCollector c(out, k);
+        visitNearest(p, c);
+    }
+
+private:
+    struct Node {
+        Rect boxes[NODE_CAPACITY];
+        unsigned children[NODE_CAPACITY];
+        unsigned count;
+        unsigned level; // 0 for leaves, whose children index _values
+        explicit Node(unsigned l) : count(0), level(l) {}
+    };
+    struct Entry {
+        Rect box;
+        unsigned child;
+        Entry() : child(0) {}
+        Entry(Rect const &b, unsigned c) : box(b), child(c) {}
+    };
+    struct PathStep {
+        unsigned node;
+        unsigned slot;
+        PathStep(unsigned n, unsigned s) : node(n), slot(s) {}
+    };
+    struct Candidate {
+        Coord dist;
+        unsigned node;
+        unsigned slot;
+        bool is_value;
+        Candidate(Coord d, unsigned n, bool v, unsigned s = 0)
+            : dist(d), node(n), slot(s), is_value(v) {}
+        // priority_queue is a max-heap; values go before nodes at equal distance
+        bool operator<(Candidate const &o) const {
+            if (dist != o.dist) return dist > o.dist;
+            return is_value < o.is_value;
+        }
+    };
+    struct Collector {
+        std::vector<T> &out;
+        Collector(std::vector<T> &o) : out(o) {}
+        bool operator()(Rect const &, T const &value) {
+            out.push_back(value);
+            return true;
+        }
+    };
+    struct NearestCollector {
+        std::vector<T> &out;
+        unsigned left;
+        NearestCollector(std::vector<T> &o, unsigned k) : out(o), left(k) {}
+        bool operator()(Rect const &, T const &value, Coord) {
+            out.push_back(value);
+            return --left > 0;
+        }
+    };
+    struct CenterLess {
+        Dim2 d;
+        CenterLess(Dim2 dim) : d(dim) {}
+        bool operator()(Entry const &a, Entry const &b) const {
+            return a.box[d].middle() < b.box[d].middle();
+        }
+    };
+
+    unsigned _newValue(T const &value) {
+        if (_free_values.empty()) {
+            _values.push_back(value);
+            return _values.size() - 1;
+        }
+        unsigned ix = _free_values.back();
+        _free_values.pop_back();
+        _values[ix] = value;
+        return ix;
+    }
+    unsigned _newNode(unsigned level) {
+        if (_free_nodes.empty()) {
+            _nodes.push_back(Node(level));
+            return _nodes.size() - 1;
+        }
+        unsigned ix = _free_nodes.back();
+        _free_nodes.pop_back();
+        _nodes[ix] = Node(level);
+        return ix;
+    }
+
+    OptRect _nodeBounds(unsigned ix) const {
+        Node const &n = _nodes[ix];
+        if (n.count == 0) return OptRect();
+        Rect r = n.boxes[0];
+        for (unsigned i = 1; i < n.count; ++i) {
+            r.unionWith(n.boxes[i]);
+        }
+        return r;
+    }
+
+    /* Sort-Tile-Recursive packing of one level: sort by X, cut into vertical
+     * slices, sort each slice by Y and cut it into nodes. Entries are spread
+     * evenly so that no node ends up nearly empty. */
+    std::vector<Entry> _pack(std::vector<Entry> &entries, unsigned level) {
+        std::vector<Entry> parents;
+        unsigned n = entries.size();
+        unsigned node_count = (n + NODE_CAPACITY - 1) / NODE_CAPACITY;
+        unsigned slice_count = std::ceil(std::sqrt((double) node_count));
+
+        std::sort(entries.begin(), entries.end(), CenterLess(X));
+        for (unsigned s = 0; s < slice_count; ++s) {
+            unsigned first = (unsigned long long) n * s / slice_count;
+            unsigned last = (unsigned long long) n * (s + 1) / slice_count;
+            std::sort(entries.begin() + first, entries.begin() + last, CenterLess(Y));
+
+            unsigned len = last - first;
+            unsigned nodes = (len + NODE_CAPACITY - 1) / NODE_CAPACITY;
+            for (unsigned k = 0; k < nodes; ++k) {
+                unsigned a = first + (unsigned long long) len * k / nodes;
+                unsigned b = first + (unsigned long long) len * (k + 1) / nodes;
+                unsigned ix = _newNode(level);
+                Node &node = _nodes[ix];
+                for (unsigned i = a; i < b; ++i) {
+                    node.boxes[node.count] = entries[i].box;
+                    node.children[node.count++] = entries[i].child;
+                }
+                parents.push_back(Entry(*_nodeBounds(ix), ix));
+            }
+        }
+        return parents;
+    }
+
+    unsigned _chooseSubtree(unsigned ix, Rect const &r) const {
+        Node const &n = _nodes[ix];
+        unsigned best = 0;
+        Coord best_growth = 0, best_area = 0;
+        for (unsigned i = 0; i < n.count; ++i) {
+            Rect u = n.boxes[i];
+            u.unionWith(r);
+            Coord area = n.boxes[i].area();
+            Coord growth = u.area() - area;
+            if (i == 0 || growth < best_growth || (growth == best_growth && area < best_area)) {
+                best = i;
+                best_growth = growth;
+                best_area = area;
+            }
+        }
+        return best;
+    }
+
+    // Insert a child at the given level, splitting nodes on the way back up.
+    void _insert(Rect const &r, unsigned child, unsigned level) {
+        std::vector<PathStep> path;
+        unsigned n = _root;
+        while (_nodes[n].level > level) {
+            unsigned slot = _chooseSubtree(n, r);
+            path.push_back(PathStep(n, slot));
+            _nodes[n].boxes[slot].unionWith(r);
+            n = _nodes[n].children[slot];
+        }
+
+        unsigned split = _addChild(n, r, child);
+        while (split != NONE) {
+            if (path.empty()) {
+                unsigned root = _newNode(_nodes[n].level + 1);
+                _addChild(root, *_nodeBounds(n), n);
+                _addChild(root, *_nodeBounds(split), split);
+                _root = root;
+                return;
+            }
+            PathStep up = path.back();
+            path.pop_back();
+            _nodes[up.node].boxes[up.slot] = *_nodeBounds(n);
+            split = _addChild(up.node, *_nodeBounds(split), split);
+            n = up.node;
+        }
+    }
+
+    /* Add a child to a node. If the node is full, split it with Guttman's
+     * quadratic algorithm and return the index of the new sibling. */
+    unsigned _addChild(unsigned ix, Rect const &r, unsigned child) {
+        if (_nodes[ix].count < NODE_CAPACITY) {
+            Node &n = _nodes[ix];
+            n.boxes[n.count] = r;
+            n.children[n.count++] = child;
+            return NONE;
+        }
+
+        Entry all[NODE_CAPACITY + 1];
+        for (unsigned i = 0; i < NODE_CAPACITY; ++i) {
+            all[i] = Entry(_nodes[ix].boxes[i], _nodes[ix].children[i]);
+        }
+        all[NODE_CAPACITY] = Entry(r, child);
+        unsigned const total = NODE_CAPACITY + 1;
+
+        // pick the two seeds that would waste the most area if put together
+        unsigned seed_a = 0, seed_b = 1;
+        Coord worst = -1;
+        for (unsigned i = 0; i < total; ++i) {
+            for (unsigned j = i + 1; j < total; ++j) {
+                Rect u = all[i].box;
+                u.unionWith(all[j].box);
+                Coord waste = u.area() - all[i].box.area() - all[j].box.area();
+                if (waste > worst) {
+                    worst = waste;
+                    seed_a = i;
+                    seed_b = j;
+                }
+            }
+        }
+
+        unsigned sibling = _newNode(_nodes[ix].level);
+        unsigned groups[2] = { ix, sibling };
+        Rect group_bounds[2] = { all[seed_a].box, all[seed_b].box };
+        bool assigned[NODE_CAPACITY + 1] = {};
+        assigned[seed_a] = assigned[seed_b] = true;
+        _nodes[ix].count = 0;
+        _addChild(ix, all[seed_a].box, all[seed_a].child);
+        _addChild(sibling, all[seed_b].box, all[seed_b].child);
+
+        for (unsigned left = total - 2; left > 0; --left) {
+            // if one group needs all remaining entries to reach the minimum, give them to it
+            for (unsigned g = 0; g < 2; ++g) {
+                if (_nodes[groups[g]].count + left == NODE_MINIMUM) {
+                    for (unsigned i = 0; i < total; ++i) {
+                        if (assigned[i]) continue;
+                        assigned[i] = true;
+                        _addChild(groups[g], all[i].box, all[i].child);
+                    }
+                    return sibling;
+                }
+            }
+
+            // pick the entry with the strongest preference for one group
+            unsigned next = 0;
+            Coord growth[2] = {0, 0};
+            Coord best_diff = -1;
+            for (unsigned i = 0; i < total; ++i) {
+                if (assigned[i]) continue;
+                Coord g[2];
+                for (unsigned k = 0; k < 2; ++k) {
+                    Rect u = group_bounds[k];
+                    u.unionWith(all[i].box);
+                    g[k] = u.area() - group_bounds[k].area();
+                }
+                Coord diff = std::fabs(g[0] - g[1]);
+                if (diff > best_diff) {
+                    best_diff = diff;
+                    next = i;
+                    growth[0] = g[0];
+                    growth[1] = g[1];
+                }
+            }
+
+            unsigned g;
+            if (growth[0] != growth[1]) {
+                g = growth[0] < growth[1] ? 0 : 1;
+            } else if (group_bounds[0].area() != group_bounds[1].area()) {
+                g = group_bounds[0].area() < group_bounds[1].area() ? 0 : 1;
+            } else {
+                g = _nodes[groups[0]].count <= _nodes[groups[1]].count ? 0 : 1;
+            }
+            assigned[next] = true;
+            group_bounds[g].unionWith(all[next].box);
+            _addChild(groups[g], all[next].box, all[next].child);
+        }
+        return sibling;
+    }
+
+    void _removeChild(unsigned ix, unsigned slot) {
+        Node &n = _nodes[ix];
+        --n.count;
+        n.boxes[slot] = n.boxes[n.count];
+        n.children[slot] = n.children[n.count];
+    }
+
+    // Find the leaf slot holding a value, recording the path of internal nodes to it.
+    bool _find(unsigned ix, Rect const &r, T const &value,
+               std::vector<PathStep> &path, unsigned &slot) const
+    {
+        Node const &n = _nodes[ix];
+        for (unsigned i = 0; i < n.count; ++i) {
+            if (n.level == 0) {
+                if (n.boxes[i] == r && _values[n.children[i]] == value) {
+                    slot = i;
+                    return true;
+                }
+            } else if (n.boxes[i].contains(r)) {
+                path.push_back(PathStep(ix, i));
+                if (_find(n.children[i], r, value, path, slot)) return true;
+                path.pop_back();
+            }
+        }
+        return false;
+    }
+
+    // Collect the values stored below a node and free its subtree.
+    void _release(unsigned ix, std::vector<Entry> &values) {
+        Node const &n = _nodes[ix];
+        for (unsigned i = 0; i < n.count; ++i) {
+            if (n.level == 0) {
+                values.push_back(Entry(n.boxes[i], n.children[i]));
+            } else {
+                _release(n.children[i], values);
+            }
+        }
+        _free_nodes.push_back(ix);
+    }
+
+    /* Walk back up from a leaf that lost a child. Underfull nodes are removed
+     * and their values reinserted; the other ancestors get tightened boxes. */
+    void _condense(unsigned n, std::vector<PathStep> &path) {
+        std::vector<Entry> orphans;
+        while (!path.empty()) {
+            PathStep up = path.back();
+            path.pop_back();
+            if (_nodes[n].count < NODE_MINIMUM) {
+                _removeChild(up.node, up.slot);
+                _release(n, orphans);
+            } else {
+                _nodes[up.node].boxes[up.slot] = *_nodeBounds(n);
+            }
+            n = up.node;
+        }
+        if (_nodes[_root].count == 0) {
+            _nodes[_root].level = 0;
+        }
+        for (unsigned i = 0; i < orphans.size(); ++i) {
+            _insert(orphans[i].box, orphans[i].child, 0);
+        }
+        while (_nodes[_root].level > 0 && _nodes[_root].count == 1) {
+            _free_nodes.push_back(_root);
+            _root = _nodes[_root].children[0];
+        }
+    }
+
+    static unsigned const NONE = ~0u;
+
+    std::vector<Node> _nodes;
+    std::vector<T> _values;
+    std::vector<unsigned> _free_nodes;
+    std::vector<unsigned> _free_values;
+    unsigned _root;
+    unsigned _size;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_RTREE_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
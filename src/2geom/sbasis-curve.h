@@ -92,6 +92,9 @@ public:
     virtual std::vector<Point> pointAndDerivatives(Coord t, unsigned n) const {
         return inner.valueAndDerivatives(t, n);
     }
+    virtual Point pointAndDerivative(Coord t, Point &deriv) const {
+        return inner.valueAndDerivative(t, deriv);
+    }
     virtual Coord valueAt(Coord t, Dim2 d) const { return inner[d].valueAt(t); }
     virtual void setInitial(Point const &v) {
         for (unsigned d = 0; d < 2; d++) { inner[d][0][0] = v[d]; }
@@ -125,6 +128,11 @@ public:
     virtual int degreesOfFreedom() const {
         return inner[0].degreesOfFreedom() + inner[1].degreesOfFreedom();
     }
+    virtual bool operator==(Curve const &c) const {
+        if (this == &c) return true;
+        SBasisCurve const *other = dynamic_cast<SBasisCurve const *>(&c);
+        return other && inner == other->inner;
+    }
 #endif
 };
 
@@ -246,15 +246,21 @@ SBasis multiply(SBasis const &a, SBasis const &b) {
 }
 #else
 
-/** Compute the pointwise product of a and b adding c (Exact)
- \param a,b,c sbasis functions
- \returns sbasis equal to a*b+c
+/** Compute the pointwise product of a and b and add it to c (Exact)
+ \param c sbasis function that receives the result
+ \param a,b sbasis functions
 
-The added term is almost free
+The added term is almost free. Reuses the storage of c.
 */
-SBasis multiply_add(SBasis const &a, SBasis const &b, SBasis c) {
+void multiply_add_into(SBasis &c, SBasis const &a, SBasis const &b) {
+    if(&c == &a || &c == &b) {
+        SBasis tmp(c);
+        multiply_add_into(tmp, a, b);
+        c.swap(tmp);
+        return;
+    }
     if(a.isZero() || b.isZero())
-        return c;
+        return;
     c.resize(a.size() + b.size(), Linear(0,0));
     for(unsigned j = 0; j < b.size(); j++) {
         for(unsigned i = j; i < a.size()+j; i++) {
@@ -270,28 +276,62 @@ SBasis multiply_add(SBasis const &a, SBasis const &b, SBasis c) {
     }
     c.normalize();
     //assert(!(0 == c.back()[0] && 0 == c.back()[1]));
+}
+
+/** Compute the pointwise product of a and b adding c (Exact)
+ \param a,b,c sbasis functions
+ \returns sbasis equal to a*b+c
+
+The added term is almost free
+*/
+SBasis multiply_add(SBasis const &a, SBasis const &b, SBasis c) {
+    multiply_add_into(c, a, b);
     return c;
 }
 
+/** Compute the pointwise product of a and b into c (Exact)
+ \param c sbasis function that receives the result
+ \param a,b sbasis functions
+
+Reuses the storage of c.
+*/
+void multiply_into(SBasis &c, SBasis const &a, SBasis const &b) {
+    if(&c == &a || &c == &b) {
+        SBasis tmp;
+        multiply_into(tmp, a, b);
+        c.swap(tmp);
+        return;
+    }
+    c.clear();
+    c.resize(a.size() + b.size(), Linear(0,0));
+    multiply_add_into(c, a, b);
+}
+
 /** Compute the pointwise product of a and b (Exact)
  \param a,b sbasis functions
  \returns sbasis equal to a*b
 
 */
 SBasis multiply(SBasis const &a, SBasis const &b) {
-    SBasis c(a.size() + b.size(), Linear(0,0));
-    if(a.isZero() || b.isZero())
-        return c;
-    return multiply_add(a, b, c);
+    SBasis c;
+    multiply_into(c, a, b);
+    return c;
 }
 #endif 
-/** Compute the integral of a (Exact)
- \param a sbasis functions
- \returns sbasis integral(a)
+/** Compute the integral of c into a (Exact)
+ \param a sbasis function that receives the result
+ \param c sbasis function
 
+Reuses the storage of a.
 */
-SBasis integral(SBasis const &c) {
-    SBasis a;
+void integral_into(SBasis &a, SBasis const &c) {
+    if(&a == &c) {
+        SBasis tmp;
+        integral_into(tmp, c);
+        a.swap(tmp);
+        return;
+    }
+    a.clear();
     a.resize(c.size() + 1, Linear(0,0));
     a[0] = Linear(0,0);
 
@@ -306,19 +346,36 @@ SBasis integral(SBasis const &c) {
         a[k][1] += aTri/2;
     }
     a.normalize();
-    return a;
 }
 
-/** Compute the derivative of a (Exact)
+/** Compute the integral of a (Exact)
  \param a sbasis functions
- \returns sbasis da/dt
+ \returns sbasis integral(a)
 
 */
-SBasis derivative(SBasis const &a) {
-    SBasis c;
+SBasis integral(SBasis const &c) {
+    SBasis a;
+    integral_into(a, c);
+    return a;
+}
+
+/** Compute the derivative of a into c (Exact)
+ \param c sbasis function that receives the result
+ \param a sbasis function
+
+Reuses the storage of c.
+*/
+void derivative_into(SBasis &c, SBasis const &a) {
+    if(&c == &a) {
+        SBasis tmp;
+        derivative_into(tmp, a);
+        c.swap(tmp);
+        return;
+    }
+    c.clear();
     c.resize(a.size(), Linear(0,0));
     if(a.isZero())
-        return c;
+        return;
 
     for(unsigned k = 0; k < a.size()-1; k++) {
         double d = (2*k+1)*(a[k][1] - a[k][0]);
@@ -334,7 +391,16 @@ SBasis derivative(SBasis const &a) {
         c[k][0] = d;
         c[k][1] = d;
     }
+}
+
+/** Compute the derivative of a (Exact)
+ \param a sbasis functions
+ \returns sbasis da/dt
 
+*/
+SBasis derivative(SBasis const &a) {
+    SBasis c;
+    derivative_into(c, a);
     return c;
 }
 
@@ -433,6 +499,32 @@ SBasis divide(SBasis const &a, SBasis const &b, int k) {
     return c;
 }
 
+/** Compute  a composed with b into r
+ \param r sbasis function that receives the result
+ \param a,b sbasis functions
+
+ r = a0 + s(a1 + s(a2 +...  where s = (1-u)u; ak =(1 - u)a^0_k + ua^1_k
+ The intermediate terms are kept in two buffers that are reused for each coefficient of a.
+*/
+void compose_into(SBasis &r, SBasis const &a, SBasis const &b) {
+    if(&r == &a || &r == &b) {
+        SBasis tmp;
+        compose_into(tmp, a, b);
+        r.swap(tmp);
+        return;
+    }
+    SBasis s;
+    multiply_into(s, SBasis(Linear(1,1))-b, b);
+    SBasis t;
+    r.clear();
+
+    for(int i = a.size()-1; i >= 0; i--) {
+        t = SBasis(Linear(a[i][0])) - b*a[i][0] + b*a[i][1];
+        multiply_add_into(t, r, s);
+        r.swap(t);
+    }
+}
+
 /** Compute  a composed with b
  \param a,b sbasis functions
  \returns sbasis a(b(t))
@@ -440,12 +532,8 @@ SBasis divide(SBasis const &a, SBasis const &b, int k) {
  return a0 + s(a1 + s(a2 +...  where s = (1-u)u; ak =(1 - u)a^0_k + ua^1_k
 */
 SBasis compose(SBasis const &a, SBasis const &b) {
-    SBasis s = multiply((SBasis(Linear(1,1))-b), b);
     SBasis r;
-
-    for(int i = a.size()-1; i >= 0; i--) {
-        r = multiply_add(r, s, SBasis(Linear(a[i][0])) - b*a[i][0] + b*a[i][1]);
-    }
+    compose_into(r, a, b);
     return r;
 }
 
@@ -456,12 +544,8 @@ SBasis compose(SBasis const &a, SBasis const &b) {
  return a0 + s(a1 + s(a2 +...  where s = (1-u)u; ak =(1 - u)a^0_k + ua^1_k
 */
 SBasis compose(SBasis const &a, SBasis const &b, unsigned k) {
-    SBasis s = multiply((SBasis(Linear(1,1))-b), b);
     SBasis r;
-
-    for(int i = a.size()-1; i >= 0; i--) {
-        r = multiply_add(r, s, SBasis(Linear(a[i][0])) - b*a[i][0] + b*a[i][1]);
-    }
+    compose_into(r, a, b);
     r.truncate(k);
     return r;
 }
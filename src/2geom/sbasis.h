@@ -40,6 +40,7 @@
 
 #include <2geom/linear.h>
 #include <2geom/interval.h>
+#include <2geom/small-vector.h>
 #include <2geom/utils.h>
 #include <2geom/exception.h>
 
@@ -66,16 +67,18 @@ namespace Geom{
 /**
 * \brief S-power basis function class
 *
-* An empty SBasis is identically 0. */
+* An empty SBasis is identically 0.
+* Up to 8 terms are stored without heap allocation. */
 class SBasis{
-    std::vector<Linear> d;
+    typedef SmallVector<Linear, 8> Storage;
+    Storage d;
     void push_back(Linear const&l) { d.push_back(l); }
 
 public:
     // As part of our migration away from SBasis isa vector we provide this minimal set of vector interface methods.
     size_t size() const {return d.size();}
-    typedef std::vector<Linear>::iterator iterator;
-    typedef std::vector<Linear>::const_iterator const_iterator;
+    typedef Storage::iterator iterator;
+    typedef Storage::const_iterator const_iterator;
     Linear operator[](unsigned i) const {
         return d[i];
     }
@@ -92,13 +95,14 @@ public:
     void resize(unsigned n, Linear const& l) { d.resize(n, l);}
     void reserve(unsigned n) { d.reserve(n);}
     void clear() {d.clear();}
-    void insert(iterator before, const_iterator src_begin, const_iterator src_end) { d.insert(std::vector<Linear>::iterator(before), src_begin, src_end);}
+    void insert(iterator before, const_iterator src_begin, const_iterator src_end) { d.insert(before, src_begin, src_end);}
     //void insert(Linear* aa, Linear* bb, Linear* cc} { d.insert(aa, bb, cc);}
     Linear& at(unsigned i) { return d.at(i);}
     //void insert(Linear* before, int& n, Linear const &l) { d.insert(std::vector<Linear>::iterator(before), n, l);}
     bool operator==(SBasis const&B) const { return d == B.d;}
     bool operator!=(SBasis const&B) const { return d != B.d;}
-    operator std::vector<Linear>() { return d;}
+    operator std::vector<Linear>() { return std::vector<Linear>(d.begin(), d.end());}
+    void swap(SBasis &other) { d.swap(other.d); }
 
     
     SBasis() {}
@@ -112,7 +116,7 @@ public:
         d(a.d)
     {}
     SBasis(std::vector<Linear> const & ls) :
-        d(ls)
+        d(ls.begin(), ls.end())
     {}
     SBasis(Linear const & bo) {
         push_back(bo);
@@ -160,8 +164,20 @@ public:
         }
         return (1-t)*p0 + t*p1;
     }
-    //double valueAndDerivative(double t, double &der) const {
-    //}
+    double valueAndDerivative(double t, double &der) const {
+        double s = t*(1-t);
+        double p0 = 0, p1 = 0, d0 = 0, d1 = 0;
+        for(unsigned k = size(); k > 0; k--) {
+            const Linear &lin = (*this)[k-1];
+            // d0 and d1 are the derivatives of p0 and p1 with respect to s
+            d0 = d0*s + p0;
+            d1 = d1*s + p1;
+            p0 = p0*s + lin[0];
+            p1 = p1*s + lin[1];
+        }
+        der = p1 - p0 + ((1-t)*d0 + t*d1) * (1 - 2*t);
+        return (1-t)*p0 + t*p1;
+    }
     double operator()(double t) const {
         return valueAt(t);
     }
@@ -304,6 +320,14 @@ SBasis multiply_add(SBasis const &a, SBasis const &b, SBasis c);
 SBasis integral(SBasis const &c);
 SBasis derivative(SBasis const &a);
 
+// In-place versions of the above, which store the result in their first argument
+// and reuse its storage. The result may alias the operands.
+void multiply_into(SBasis &c, SBasis const &a, SBasis const &b);
+// c += a*b
+void multiply_add_into(SBasis &c, SBasis const &a, SBasis const &b);
+void integral_into(SBasis &a, SBasis const &c);
+void derivative_into(SBasis &c, SBasis const &a);
+
 SBasis sqrt(SBasis const &a, int k);
 
 // return a kth order approx to 1/a)
@@ -315,7 +339,7 @@ inline SBasis operator*(SBasis const & a, SBasis const & b) {
 }
 
 inline SBasis& operator*=(SBasis& a, SBasis const & b) {
-    a = multiply(a, b);
+    multiply_into(a, a, b);
     return a;
 }
 
@@ -338,6 +362,7 @@ valuation(SBasis const &a, double tol=0){
 // a(b(t))
 SBasis compose(SBasis const &a, SBasis const &b);
 SBasis compose(SBasis const &a, SBasis const &b, unsigned k);
+void compose_into(SBasis &r, SBasis const &a, SBasis const &b);
 SBasis inverse(SBasis a, int k);
 //compose_inverse(f,g)=compose(f,inverse(g)), but is numerically more stable in some good cases...
 //TODO: requires g(0)=0 & g(1)=1 atm. generalization should be obvious.
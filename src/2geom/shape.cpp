@@ -298,6 +298,164 @@ Shape boolop(Shape const &a, Shape const &b, unsigned flags) {
     return Shape();
 }
 
+static OptRect shape_bounds(Shape const &s) {
+    OptRect ret;
+    for(unsigned i = 0; i < s.size(); i++)
+        ret.unionWith(s[i].boundsFast());
+    return ret;
+}
+
+static bool all_filled(std::vector<Shape> const &shapes) {
+    for(unsigned i = 0; i < shapes.size(); i++)
+        if(!shapes[i].isFill()) return false;
+    return true;
+}
+
+/* Combines two shapes for union_all() or intersect_all(). Filled shapes whose bounds
+ * do not overlap cannot cross, so their union is just both sets of regions. */
+static Shape combine_pair(Shape const &a, Shape const &b, bool rev) {
+    if(a.isFill() && b.isFill()) {
+        OptRect ab = shape_bounds(a), bb = shape_bounds(b);
+        if(!ab || !bb || !ab->intersects(*bb)) {
+            if(rev) return Shape();
+            Regions content = a.getContent();
+            for(unsigned i = 0; i < b.size(); i++)
+                content.push_back(b[i]);
+            return Shape(content, true);
+        }
+    }
+    return shape_boolean(rev, a, b);
+}
+
+/* Reduces every group of shapes to a single shape by combining neighbours of the same
+ * group pairwise, so that each shape takes part in a logarithmic number of booleans
+ * instead of a linear one. The pairs of a round are independent, so when the library
+ * is built with OpenMP they run in parallel. */
+static void reduce_groups(std::vector<Shape> &shapes, std::vector<unsigned> &groups, bool rev) {
+    // the tasks share the bounds cached in the paths, so fill them in before
+    for(unsigned i = 0; i < shapes.size(); i++) {
+        for(unsigned j = 0; j < shapes[i].size(); j++) {
+            shapes[i][j].boundsFast();
+            Path(shapes[i][j]).curveBounds();
+        }
+    }
+    while(true) {
+        std::vector<unsigned> pairs;
+        for(unsigned i = 0; i + 1 < shapes.size(); i++) {
+            if(groups[i] == groups[i + 1]) {
+                pairs.push_back(i);
+                i++;
+            }
+        }
+        if(pairs.empty()) return;
+
+        int n = pairs.size();
+        std::vector<Shape> results(n);
+        std::vector<char> failed(n, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(n > 1)
+#endif
+        for(int x = 0; x < n; x++) {
+            // exceptions must not leave the parallel region
+            try {
+                results[x] = combine_pair(shapes[pairs[x]], shapes[pairs[x] + 1], rev);
+            } catch(...) {
+                failed[x] = 1;
+            }
+        }
+
+        std::vector<Shape> next;
+        std::vector<unsigned> next_groups;
+        unsigned x = 0;
+        for(unsigned i = 0; i < shapes.size(); i++) {
+            if(x < pairs.size() && pairs[x] == i) {
+                // run it again here, so that the caller gets the same exception as before
+                if(failed[x]) results[x] = combine_pair(shapes[i], shapes[i + 1], rev);
+                next.push_back(results[x]);
+                i++;
+                x++;
+            } else {
+                next.push_back(shapes[i]);
+            }
+            next_groups.push_back(groups[i]);
+        }
+        shapes.swap(next);
+        groups.swap(next_groups);
+    }
+}
+
+/* Filled shapes are first split into groups whose bounds overlap, transitively; the
+ * groups are reduced separately and their regions put together at the end. */
+Shape union_all(std::vector<Shape> const &shapes) {
+    if(shapes.empty()) return Shape();
+    std::vector<Shape> work;
+    std::vector<unsigned> groups;
+    if(!all_filled(shapes)) {
+        work = shapes;
+        groups.assign(shapes.size(), 0);
+    } else {
+        std::vector<Rect> bounds;
+        std::vector<unsigned> nonempty;
+        for(unsigned i = 0; i < shapes.size(); i++) {
+            OptRect b = shape_bounds(shapes[i]);
+            if(!b) continue;
+            bounds.push_back(*b);
+            nonempty.push_back(i);
+        }
+        // union-find over the overlapping pairs
+        std::vector<unsigned> parent(bounds.size());
+        for(unsigned i = 0; i < parent.size(); i++) parent[i] = i;
+        std::vector<std::vector<unsigned> > overlaps = sweep_bounds(bounds);
+        for(unsigned i = 0; i < overlaps.size(); i++) {
+            for(unsigned j = 0; j < overlaps[i].size(); j++) {
+                unsigned a = i, b = overlaps[i][j];
+                while(parent[a] != a) a = parent[a] = parent[parent[a]];
+                while(parent[b] != b) b = parent[b] = parent[parent[b]];
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+        // the members of a group keep their order, which is the order of the sequential fold
+        std::vector<std::vector<unsigned> > members(bounds.size());
+        for(unsigned i = 0; i < parent.size(); i++) {
+            unsigned root = i;
+            while(parent[root] != root) root = parent[root];
+            members[root].push_back(nonempty[i]);
+        }
+        for(unsigned g = 0; g < members.size(); g++) {
+            for(unsigned i = 0; i < members[g].size(); i++) {
+                work.push_back(shapes[members[g][i]]);
+                groups.push_back(g);
+            }
+        }
+        if(work.empty()) return Shape();
+    }
+
+    reduce_groups(work, groups, false);
+    if(work.size() == 1) return work[0];
+    Regions content;
+    for(unsigned i = 0; i < work.size(); i++) {
+        for(unsigned j = 0; j < work[i].size(); j++)
+            content.push_back(work[i][j]);
+    }
+    return Shape(content, true);
+}
+
+Shape intersect_all(std::vector<Shape> const &shapes) {
+    if(shapes.empty()) return Shape(false);
+    if(all_filled(shapes)) {
+        // boxes that overlap pairwise have a common point, so this is empty exactly when
+        // two of the shapes are apart
+        OptRect common = shape_bounds(shapes[0]);
+        for(unsigned i = 1; i < shapes.size() && common; i++)
+            common.intersectWith(shape_bounds(shapes[i]));
+        if(!common) return Shape();
+    }
+    std::vector<Shape> work(shapes);
+    std::vector<unsigned> groups(shapes.size(), 0);
+    reduce_groups(work, groups, true);
+    return work[0];
+}
+
 int paths_winding(std::vector<Path> const &ps, Point p) {
     int ret = 0;
     for(unsigned i = 0; i < ps.size(); i++)
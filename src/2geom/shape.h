@@ -65,7 +65,7 @@ enum {
 
 class Shape {
     Regions content;
-    mutable bool fill;
+    bool fill;
     //friend Shape shape_region_boolean(bool rev, Shape const & a, Region const & b);
     friend CrossingSet crossings_between(Shape const &a, Shape const &b);
     friend Shape shape_boolean(bool rev, Shape const &, Shape const &, CrossingSet const &);
@@ -100,7 +100,7 @@ class Shape {
 
   private:
     std::vector<unsigned> containment_list(Point p) const;
-    void update_fill() const {
+    void update_fill() {
         unsigned ix = outer_index(content);
         if(ix < size())
             fill = content[ix].fill;
@@ -124,6 +124,15 @@ unsigned crossing_along(double t, unsigned ix, unsigned jx, bool dir, Crossings
 Shape boolop(Shape const &, Shape const &, unsigned flags);
 Shape boolop(Shape const &, Shape const &, unsigned flags, CrossingSet &);
 
+/** @brief Union of many shapes, the same as folding them with boolop(BOOLOP_UNION).
+ * The shapes are combined in pairs, round by round, in parallel when the library
+ * is built with OpenMP. Filled shapes whose bounds do not overlap are not
+ * intersected at all; their regions are simply put together. */
+Shape union_all(std::vector<Shape> const &shapes);
+/** @brief Intersection of many shapes, the same as folding them with boolop(BOOLOP_INTERSECT).
+ * The intersection of no shapes is the whole plane, Shape(false). */
+Shape intersect_all(std::vector<Shape> const &shapes);
+
 Shape sanitize(std::vector<Path> const &ps);
 
 Shape stopgap_cleaner(std::vector<Path> const &ps);
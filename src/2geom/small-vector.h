@@ -0,0 +1,213 @@
+/**
+ * \file
+ * \brief Vector with inline storage for a few elements
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_SMALL_VECTOR_H
+#define LIB2GEOM_SEEN_SMALL_VECTOR_H
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+namespace Geom {
+
+/**
+ * @brief Vector that keeps up to N elements inside the object.
+ *
+ * Behaves like a minimal std::vector, but only goes to the heap when it grows beyond
+ * N elements. Short-lived vectors of a handful of elements, like the coefficients of
+ * a typical SBasis, can then be created and copied without touching the allocator.
+ * Heap storage is kept when the vector shrinks, so a reused vector stops allocating
+ * once it has reached its largest size.
+ *
+ * Only for types with a trivial destructor whose copies can be made by assignment,
+ * such as Linear.
+ */
+template <typename T, unsigned N>
+class SmallVector {
+public:
+    typedef T value_type;
+    typedef T *iterator;
+    typedef T const *const_iterator;
+    typedef std::size_t size_type;
+
+    SmallVector() : _data(_inline()), _size(0), _capacity(N) {}
+    explicit SmallVector(size_type n, T const &v = T())
+        : _data(_inline()), _size(0), _capacity(N)
+    {
+        resize(n, v);
+    }
+    template <typename Iter>
+    SmallVector(Iter first, Iter last)
+        : _data(_inline()), _size(0), _capacity(N)
+    {
+        insert(end(), first, last);
+    }
+    SmallVector(SmallVector const &other)
+        : _data(_inline()), _size(0), _capacity(N)
+    {
+        reserve(other._size);
+        std::uninitialized_copy(other.begin(), other.end(), _data);
+        _size = other._size;
+    }
+    SmallVector &operator=(SmallVector const &other) {
+        if (this != &other) {
+            reserve(other._size);
+            std::copy(other.begin(), other.end(), _data);
+            _size = other._size;
+        }
+        return *this;
+    }
+    ~SmallVector() {
+        if (_data != _inline()) delete [] reinterpret_cast<char *>(_data);
+    }
+
+    size_type size() const { return _size; }
+    size_type capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+
+    iterator begin() { return _data; }
+    iterator end() { return _data + _size; }
+    const_iterator begin() const { return _data; }
+    const_iterator end() const { return _data + _size; }
+
+    T &operator[](size_type i) { return _data[i]; }
+    T const &operator[](size_type i) const { return _data[i]; }
+    T &at(size_type i) {
+        if (i >= _size) throw std::out_of_range("SmallVector::at");
+        return _data[i];
+    }
+    T const &at(size_type i) const {
+        if (i >= _size) throw std::out_of_range("SmallVector::at");
+        return _data[i];
+    }
+    T &back() { return _data[_size - 1]; }
+    T const &back() const { return _data[_size - 1]; }
+
+    void reserve(size_type n) {
+        if (n <= _capacity) return;
+        size_type cap = std::max(n, 2 * (size_type) _capacity);
+        T *data = reinterpret_cast<T *>(new char[cap * sizeof(T)]);
+        std::uninitialized_copy(begin(), end(), data);
+        if (_data != _inline()) delete [] reinterpret_cast<char *>(_data);
+        _data = data;
+        _capacity = cap;
+    }
+    void resize(size_type n, T const &v = T()) {
+        reserve(n);
+        if (n > _size) std::uninitialized_fill(end(), _data + n, v);
+        _size = n;
+    }
+    void clear() { _size = 0; }
+    void push_back(T const &v) {
+        if (_size == _capacity) {
+            // v might be one of our own elements
+            T copy(v);
+            reserve(_size + 1);
+            new (end()) T(copy);
+        } else {
+            new (end()) T(v);
+        }
+        ++_size;
+    }
+    void pop_back() { --_size; }
+
+    template <typename Iter>
+    void insert(iterator pos, Iter first, Iter last) {
+        size_type n = std::distance(first, last);
+        if (n == 0) return;
+        size_type ix = pos - begin();
+        reserve(_size + n);
+        pos = begin() + ix;
+        // the elements are trivially destructible, so overwriting them in place is fine
+        std::copy_backward(pos, end(), end() + n);
+        for (; first != last; ++first, ++pos) {
+            new (pos) T(*first);
+        }
+        _size += n;
+    }
+
+    /// Exchange contents without allocating.
+    void swap(SmallVector &other) {
+        bool here = _data == _inline(), there = other._data == other._inline();
+        if (!here && !there) {
+            std::swap(_data, other._data);
+        } else if (here && there) {
+            SmallVector *small = _size < other._size ? this : &other;
+            SmallVector *large = small == this ? &other : this;
+            std::swap_ranges(small->begin(), small->end(), large->begin());
+            std::uninitialized_copy(large->begin() + small->_size, large->end(), small->end());
+        } else {
+            // move the inline elements into the unused inline buffer of the other vector
+            SmallVector *small = here ? this : &other;
+            SmallVector *large = here ? &other : this;
+            std::uninitialized_copy(small->begin(), small->end(), large->_inline());
+            small->_data = large->_data;
+            large->_data = large->_inline();
+        }
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    bool operator==(SmallVector const &other) const {
+        return _size == other._size && std::equal(begin(), end(), other.begin());
+    }
+    bool operator!=(SmallVector const &other) const { return !(*this == other); }
+
+private:
+    T *_inline() { return reinterpret_cast<T *>(_storage.bytes); }
+    T const *_inline() const { return reinterpret_cast<T const *>(_storage.bytes); }
+
+    T *_data;
+    unsigned _size;
+    unsigned _capacity;
+    union {
+        char bytes[N * sizeof(T)];
+        double align_double;
+        void *align_pointer;
+    } _storage;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_SMALL_VECTOR_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
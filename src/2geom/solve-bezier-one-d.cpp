@@ -25,6 +25,8 @@ static int SGN(t x) { return (x > 0 ? 1 : (x < 0 ? -1 : 0)); }
 /**
  * This function is called _a lot_.  We have included various manual memory management stuff to reduce the amount of mallocing that goes on.  In the future it is possible that this will hurt performance.
  **/
+// solve-bezier.cpp has another class of this name, so keep this one local
+namespace {
 class Bernsteins{
 public:
     static const size_t MAX_DEPTH = 22;
@@ -46,7 +48,7 @@ public:
     unsigned
     control_poly_flat_enough(double const *V);
 
-    double horner(const double *b, double t);
+    double horner(const double *b, double t, size_t lo, size_t hi);
 
 
     void
@@ -54,6 +56,7 @@ public:
                          unsigned depth,  /* The depth of the recursion */
                          double left_t, double right_t);
 };
+}
 /*
  *  find_bernstein_roots : Given an equation in Bernstein-Bernstein form, find all
  *    of the roots in the open interval (0, 1).  Return the number of roots found.
@@ -125,17 +128,24 @@ void Bernsteins::find_bernstein_roots(double const *w, /* The control points  */
         }
 
 
+        /* A root exactly at an end, such as a subdivision point, has already been
+         * reported. Divide it out, which keeps the signs inside the interval, so that
+         * the ends bracket the remaining root. */
+        size_t lo = 0, hi = degree;
+        while (w[lo] == 0) ++lo;
+        while (w[hi] == 0) --hi;
+
         double s = 0, t = 1;
         double e = 1e-10;
         int side = 0;
-        double r, fr, fs = w[0], ft = w[degree];
+        double r, fr, fs = bc[lo] * w[lo], ft = bc[hi] * w[hi];
 
         for (size_t n = 0; n < 100; ++n)
         {
             r = (fs*t - ft*s) / (fs - ft);
             if (fabs(t-s) < e * fabs(t+s))  break;
 
-            fr = horner(w, r);
+            fr = horner(w, r, lo, hi);
 
             if (fr * ft > 0)
             {
@@ -160,7 +170,9 @@ void Bernsteins::find_bernstein_roots(double const *w, /* The control points  */
 //    double Left[N], /* New left and right  */
 //           Right[N];    /* control polygons  */
     //const double t = 0.5;
-    double* LR = new double[2*N];
+    // low degrees, such as the distance polynomials of cubics, fit on the stack
+    double stack_lr[2*8];
+    double* LR = N <= 8 ? stack_lr : new double[2*N];
     double* Left = LR;
     double* Right = LR + N;
 
@@ -189,23 +201,24 @@ void Bernsteins::find_bernstein_roots(double const *w, /* The control points  */
     }
 
     find_bernstein_roots(Right, depth+1, mid_t, right_t);
-    delete[] LR;
+    if (LR != stack_lr) delete[] LR;
 }
 
 
 // suggested by Sederberg.
-double Bernsteins::horner(const double *b, double t)
+// Evaluates the polynomial with the coefficients outside [lo, hi] divided out, which are zero.
+double Bernsteins::horner(const double *b, double t, size_t lo, size_t hi)
 {
     double u, tn, tmp;
     u = 1.0 - t;
     tn = 1.0;
-    tmp = b[0] * u;
-    for(size_t i = 1; i < degree; ++i)
+    tmp = bc[lo] * b[lo] * u;
+    for(size_t i = lo + 1; i < hi; ++i)
     {
         tn *= t;
         tmp = (tmp + tn*bc[i]*b[i]) * u;
     }
-    return (tmp + tn*t*b[degree]);
+    return (tmp + tn*t*bc[hi]*b[hi]);
 }
 
 
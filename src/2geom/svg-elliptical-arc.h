@@ -86,6 +86,10 @@ public:
         if (isDegenerate()) return chord().pointAndDerivatives(t, n);
         return EllipticalArc::pointAndDerivatives(t, n);
     }
+    virtual Point pointAndDerivative(Coord t, Point &deriv) const {
+        if (isDegenerate()) return chord().pointAndDerivative(t, deriv);
+        return EllipticalArc::pointAndDerivative(t, deriv);
+    }
     virtual Rect boundsExact() const {
         if (isDegenerate()) return chord().boundsExact();
         return EllipticalArc::boundsExact();
@@ -104,6 +108,10 @@ public:
         if (isDegenerate()) return chord().roots(v, d);
         return EllipticalArc::roots(v, d);
     }
+    virtual int winding(Point const &p) const {
+        if (isDegenerate()) return chord().winding(p);
+        return EllipticalArc::winding(p);
+    }
 #ifdef HAVE_GSL
     virtual std::vector<Coord> allNearestPoints( Point const& p, double from = 0, double to = 1 ) const {
         if (isDegenerate()) {
@@ -118,6 +126,10 @@ public:
         if (isDegenerate()) return chord().toSBasis();
         return EllipticalArc::toSBasis();
     }
+    virtual Coord length(Coord tolerance = 0.01) const {
+        if (isDegenerate()) return chord().length(tolerance);
+        return EllipticalArc::length(tolerance);
+    }
     virtual bool isSVGCompliant() const { return true; }
     // TODO move SVG-specific behavior here.
 //protected:
@@ -33,6 +33,7 @@
 
 
 #include <cmath>
+#include <cfloat>
 #include <vector>
 #include <glib.h>
 
@@ -44,103 +45,78 @@ namespace Geom {
 
 namespace {
 
-class Parser {
-public:
-    Parser(SVGPathSink &sink) : _absolute(false), _sink(sink) {}
-
-    void parse(char const *str) throw(SVGPathParseError);
-
-private:
-    bool _absolute;
-    Point _current;
-    Point _initial;
-    Point _cubic_tangent;
-    Point _quad_tangent;
-    std::vector<double> _params;
-    SVGPathSink &_sink;
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
 
-    void _reset() {
-        _absolute = false;
-        _current = _initial = Point(0, 0);
-        _quad_tangent = _cubic_tangent = Point(0, 0);
-        _params.clear();
+/* Converts a number matched by the grammar, which may be followed by more path data.
+ * Numbers with at most 19 significant digits that fit in the 53 bits of a double
+ * are converted with a single multiplication or division by an exactly representable
+ * power of ten. Both operands are exact then, so the result is correctly rounded
+ * (Clinger's fast path). Returns false for the rare numbers that need strtod. */
+bool scan_number(char const *p, char const *end, double &value)
+{
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+    // excess precision would round twice
+    return false;
+#endif
+    static double const powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = *p == '-';
+        ++p;
     }
 
-    void _push(double value) {
-        _params.push_back(value);
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    for (; p != end && is_digit(*p); ++p) {
+        if (digits == 19) return false;
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa != 0) ++digits;
     }
-
-    double _pop() {
-        double value = _params.back();
-        _params.pop_back();
-        return value;
+    if (p != end && *p == '.') {
+        for (++p; p != end && is_digit(*p); ++p) {
+            if (digits == 19) return false;
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa != 0) ++digits;
+            --exponent;
+        }
     }
-
-    bool _pop_flag() {
-        return _pop() != 0.0;
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negative_exponent = false;
+        if (*p == '+' || *p == '-') {
+            negative_exponent = *p == '-';
+            ++p;
+        }
+        int e = 0;
+        for (; p != end && is_digit(*p); ++p) {
+            if (e < 10000) e = e * 10 + (*p - '0');
+        }
+        exponent += negative_exponent ? -e : e;
     }
 
-    double _pop_coord(Geom::Dim2 axis) {
-        if (_absolute) {
-            return _pop();
+    double v = mantissa;
+    if (mantissa != 0) {
+        if (mantissa > (1ULL << 53) || exponent < -22 || exponent > 22) return false;
+        if (exponent < 0) {
+            v /= powers_of_ten[-exponent];
         } else {
-            return _pop() + _current[axis];
+            v *= powers_of_ten[exponent];
         }
     }
+    value = negative ? -v : v;
+    return true;
+}
 
-    Point _pop_point() {
-        double y = _pop_coord(Geom::Y);
-        double x = _pop_coord(Geom::X);
-        return Point(x, y);
-    }
-
-    void _moveTo(Point p) {
-        _quad_tangent = _cubic_tangent = _current = _initial = p;
-        _sink.moveTo(p);
-    }
-    
-    void _hlineTo(Point p) {
-        _quad_tangent = _cubic_tangent = _current = p;
-        _sink.hlineTo(p[Geom::X]);
-    }
-    
-    void _vlineTo(Point p) {
-        _quad_tangent = _cubic_tangent = _current = p;
-        _sink.vlineTo(p[Geom::Y]);
-    }
-
-    void _lineTo(Point p) {
-        _quad_tangent = _cubic_tangent = _current = p;
-        _sink.lineTo(p);
-    }
-
-    void _curveTo(Point c0, Point c1, Point p) {
-        _quad_tangent = _current = p;
-        _cubic_tangent = p + ( p - c1 );
-        _sink.curveTo(c0, c1, p);
-    }
-
-    void _quadTo(Point c, Point p) {
-        _cubic_tangent = _current = p;
-        _quad_tangent = p + ( p - c );
-        _sink.quadTo(c, p);
-    }
-
-    void _arcTo(double rx, double ry, double angle,
-                bool large_arc, bool sweep, Point p)
-    {
-        _quad_tangent = _cubic_tangent = _current = p;
-        _sink.arcTo(rx, ry, angle, large_arc, sweep, p);
-    }
-
-    void _closePath() {
-        _quad_tangent = _cubic_tangent = _current = _initial;
-        _sink.closePath();
-    }
-};
+}
 
 
-#line 144 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.cpp"
+#line 120 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.cpp"
 static const char _svg_path_actions[] = {
 	0, 1, 0, 1, 1, 1, 2, 1, 
 	3, 1, 4, 1, 5, 1, 15, 1, 
@@ -1145,25 +1121,158 @@ static const int svg_path_first_final = 270;
 
 static const int svg_path_en_main = 1;
 
-#line 144 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 120 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 
 
-void Parser::parse(char const *str)
-throw(SVGPathParseError)
+SVGPathParser::SVGPathParser(SVGPathSink &sink)
+    : _absolute(false), _state(0), _sink(sink)
 {
-    char const *p = str;
-    char const *start = NULL;
-    int cs;
+    reset();
+}
 
-    _reset();
+void SVGPathParser::reset() {
+    _absolute = false;
+    _current = _initial = Point(0, 0);
+    _quad_tangent = _cubic_tangent = Point(0, 0);
+    _params.clear();
+    _number.clear();
 
+    int cs;
     
-#line 1162 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.cpp"
+#line 1143 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.cpp"
 	{
 	cs = svg_path_start;
 	}
 
-#line 1167 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.cpp"
+#line 136 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+
+    _state = cs;
+}
+
+void SVGPathParser::feed(char const *data, size_t len)
+throw(SVGPathParseError)
+{
+    _parse(data, data + len, false);
+}
+
+void SVGPathParser::finish()
+throw(SVGPathParseError)
+{
+    // the grammar ends at a null character
+    char const end = 0;
+    _parse(&end, &end + 1, true);
+    _sink.finish();
+}
+
+void SVGPathParser::parse(char const *str)
+throw(SVGPathParseError)
+{
+    reset();
+    feed(str, strlen(str));
+    finish();
+}
+
+void SVGPathParser::_push(double value) {
+    _params.push_back(value);
+}
+
+void SVGPathParser::_push_number(char const *start, char const *end) {
+    if (!_number.empty()) {
+        // the beginning of the number was in the previous piece of input
+        _number.append(start, end);
+        start = _number.data();
+        end = start + _number.size();
+    }
+    double value;
+    if (!scan_number(start, end, value)) {
+        if (_number.empty()) {
+            _number.assign(start, end);
+        }
+        value = g_ascii_strtod(_number.c_str(), NULL);
+    }
+    _number.clear();
+    _push(value);
+}
+
+double SVGPathParser::_pop() {
+    double value = _params.back();
+    _params.pop_back();
+    return value;
+}
+
+bool SVGPathParser::_pop_flag() {
+    return _pop() != 0.0;
+}
+
+double SVGPathParser::_pop_coord(Geom::Dim2 axis) {
+    if (_absolute) {
+        return _pop();
+    } else {
+        return _pop() + _current[axis];
+    }
+}
+
+Point SVGPathParser::_pop_point() {
+    double y = _pop_coord(Geom::Y);
+    double x = _pop_coord(Geom::X);
+    return Point(x, y);
+}
+
+void SVGPathParser::_moveTo(Point p) {
+    _quad_tangent = _cubic_tangent = _current = _initial = p;
+    _sink.moveTo(p);
+}
+
+void SVGPathParser::_hlineTo(Point p) {
+    _quad_tangent = _cubic_tangent = _current = p;
+    _sink.hlineTo(p[Geom::X]);
+}
+
+void SVGPathParser::_vlineTo(Point p) {
+    _quad_tangent = _cubic_tangent = _current = p;
+    _sink.vlineTo(p[Geom::Y]);
+}
+
+void SVGPathParser::_lineTo(Point p) {
+    _quad_tangent = _cubic_tangent = _current = p;
+    _sink.lineTo(p);
+}
+
+void SVGPathParser::_curveTo(Point c0, Point c1, Point p) {
+    _quad_tangent = _current = p;
+    _cubic_tangent = p + ( p - c1 );
+    _sink.curveTo(c0, c1, p);
+}
+
+void SVGPathParser::_quadTo(Point c, Point p) {
+    _cubic_tangent = _current = p;
+    _quad_tangent = p + ( p - c );
+    _sink.quadTo(c, p);
+}
+
+void SVGPathParser::_arcTo(double rx, double ry, double angle,
+                           bool large_arc, bool sweep, Point p)
+{
+    _quad_tangent = _cubic_tangent = _current = p;
+    _sink.arcTo(rx, ry, angle, large_arc, sweep, p);
+}
+
+void SVGPathParser::_closePath() {
+    _quad_tangent = _cubic_tangent = _current = _initial;
+    _sink.closePath();
+}
+
+void SVGPathParser::_parse(char const *str, char const *strend, bool finish)
+throw(SVGPathParseError)
+{
+    char const *p = str;
+    char const *pe = strend;
+    // we are in the middle of a number if the previous piece ended with one
+    char const *start = _number.empty() ? NULL : p;
+    int cs = _state;
+
+    
+#line 1276 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.cpp"
 	{
 	int _klen;
 	unsigned int _trans;
@@ -1171,6 +1280,8 @@ throw(SVGPathParseError)
 	unsigned int _nacts;
 	const char *_keys;
 
+	if ( p == pe )
+		goto _out;
 	if ( cs == 0 )
 		goto _out;
 _resume:
@@ -1236,70 +1347,68 @@ _match:
 		switch ( *_acts++ )
 		{
 	case 0:
-#line 156 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 263 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             start = p;
         }
 	break;
 	case 1:
-#line 160 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 267 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
-            char const *end=p;
-            std::string buf(start, end);
-            _push(g_ascii_strtod(buf.c_str(), NULL));
+            _push_number(start, p);
             start = NULL;
         }
 	break;
 	case 2:
-#line 167 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 272 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _push(1.0);
         }
 	break;
 	case 3:
-#line 171 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 276 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _push(0.0);
         }
 	break;
 	case 4:
-#line 175 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 280 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _absolute = true;
         }
 	break;
 	case 5:
-#line 179 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 284 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _absolute = false;
         }
 	break;
 	case 6:
-#line 183 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 288 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _moveTo(_pop_point());
         }
 	break;
 	case 7:
-#line 187 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 292 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _lineTo(_pop_point());
         }
 	break;
 	case 8:
-#line 191 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 296 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _hlineTo(Point(_pop_coord(X), _current[Y]));
         }
 	break;
 	case 9:
-#line 195 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 300 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _vlineTo(Point(_current[X], _pop_coord(Y)));
         }
 	break;
 	case 10:
-#line 199 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 304 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             Point p = _pop_point();
             Point c1 = _pop_point();
@@ -1308,7 +1417,7 @@ _match:
         }
 	break;
 	case 11:
-#line 206 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 311 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             Point p = _pop_point();
             Point c1 = _pop_point();
@@ -1316,7 +1425,7 @@ _match:
         }
 	break;
 	case 12:
-#line 212 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 317 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             Point p = _pop_point();
             Point c = _pop_point();
@@ -1324,14 +1433,14 @@ _match:
         }
 	break;
 	case 13:
-#line 218 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 323 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             Point p = _pop_point();
             _quadTo(_quad_tangent, p);
         }
 	break;
 	case 14:
-#line 223 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 328 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             Point point = _pop_point();
             bool sweep = _pop_flag();
@@ -1344,42 +1453,44 @@ _match:
         }
 	break;
 	case 15:
-#line 234 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 339 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{
             _closePath();
         }
 	break;
 	case 16:
-#line 370 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 475 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 	{goto _out;}
 	break;
-#line 1357 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.cpp"
+#line 1466 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.cpp"
 		}
 	}
 
 _again:
 	if ( cs == 0 )
 		goto _out;
-	p += 1;
-	goto _resume;
+	if ( ++p != pe )
+		goto _resume;
 	_out: {}
 	}
-#line 380 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
+#line 483 "/opt/shared/work/programming/eclipse/eclipse_3.4/lib2geom/src/2geom/svg-path-parser.rl"
 
 
-    if ( cs < svg_path_first_final ) {
+    _state = cs;
+    if (finish ? cs < svg_path_first_final : cs == 0) {
         throw SVGPathParseError();
     }
-}
-
+    if (start) {
+        // keep the part of the number seen so far for the next call
+        _number.append(start, pe);
+    }
 }
 
 void parse_svg_path(char const *str, SVGPathSink &sink)
 throw(SVGPathParseError)
 {
-    Parser parser(sink);
+    SVGPathParser parser(sink);
     parser.parse(str);
-    sink.finish();
 }
 
 }
@@ -1393,4 +1504,4 @@ throw(SVGPathParseError)
   fill-column:99
   End:
 */
-// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:encoding=utf-8:textwidth=99 :
@@ -33,6 +33,9 @@
 #ifndef SEEN_SVG_PATH_PARSER_H
 #define SEEN_SVG_PATH_PARSER_H
 
+#include <cstdio>
+#include <cstring>
+#include <string>
 #include <vector>
 #include <iterator>
 #include <stdexcept>
@@ -42,6 +45,59 @@
 
 namespace Geom {
 
+/** @brief Incremental parser of SVG path data.
+ *
+ * The path data can be fed in pieces split at arbitrary places, even in the middle
+ * of a number, and the commands are sent to the sink as soon as they are complete.
+ * The input is read in place; only a number split between two pieces is copied,
+ * so a large memory-mapped file can be parsed without reading it into a buffer. */
+class SVGPathParser {
+public:
+    explicit SVGPathParser(SVGPathSink &sink);
+
+    /// Discard the state left by previous input and start a new path string.
+    void reset();
+    /// Parse the next piece of path data, which need not be null-terminated.
+    void feed(char const *data, size_t len) throw(SVGPathParseError);
+    void feed(std::string const &data) throw(SVGPathParseError) {
+        feed(data.data(), data.size());
+    }
+    /// Signal the end of the path data and finish the sink.
+    void finish() throw(SVGPathParseError);
+    /// Parse a complete null-terminated path string.
+    void parse(char const *str) throw(SVGPathParseError);
+
+private:
+    bool _absolute;
+    Point _current;
+    Point _initial;
+    Point _cubic_tangent;
+    Point _quad_tangent;
+    std::vector<double> _params;
+    std::string _number;
+    int _state;
+    SVGPathSink &_sink;
+
+    void _parse(char const *str, char const *strend, bool finish) throw(SVGPathParseError);
+
+    void _push(double value);
+    void _push_number(char const *start, char const *end);
+    double _pop();
+    bool _pop_flag();
+    double _pop_coord(Geom::Dim2 axis);
+    Point _pop_point();
+
+    void _moveTo(Point p);
+    void _hlineTo(Point p);
+    void _vlineTo(Point p);
+    void _lineTo(Point p);
+    void _curveTo(Point c0, Point c1, Point p);
+    void _quadTo(Point c, Point p);
+    void _arcTo(double rx, double ry, double angle,
+                bool large_arc, bool sweep, Point p);
+    void _closePath();
+};
+
 void parse_svg_path(char const *str, SVGPathSink &sink) throw(SVGPathParseError);
 
 inline std::vector<Path> parse_svg_path(char const *str) throw(SVGPathParseError) {
@@ -56,10 +112,24 @@ inline std::vector<Path> parse_svg_path(char const *str) throw(SVGPathParseError
     return subpaths;
 }
 
+/// Read the path data on the next line of the file, however long it is.
 inline std::vector<Path> read_svgd_f(FILE * fi) throw(SVGPathParseError) {
+    typedef std::vector<Path> Subpaths;
+    typedef std::back_insert_iterator<Subpaths> Inserter;
+
+    Subpaths subpaths;
+    Inserter iter(subpaths);
+    SVGPathGenerator<Inserter> generator(iter);
+    SVGPathParser parser(generator);
+
     char input[1024 * 10];
-    fgets(input, 1024 * 10, fi);
-    return parse_svg_path(input);
+    while(fgets(input, sizeof(input), fi)) {
+        size_t len = strlen(input);
+        parser.feed(input, len);
+        if(len > 0 && input[len - 1] == '\n') break;
+    }
+    parser.finish();
+    return subpaths;
 }
 
 inline std::vector<Path> read_svgd(char const * name) throw(SVGPathParseError) {
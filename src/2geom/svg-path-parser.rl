@@ -32,6 +32,7 @@
 
 
 #include <cmath>
+#include <cfloat>
 #include <vector>
 #include <glib.h>
 
@@ -43,114 +44,220 @@ namespace Geom {
 
 namespace {
 
-class Parser {
-public:
-    Parser(SVGPathSink &sink) : _absolute(false), _sink(sink) {}
-
-    void parse(char const *str) throw(SVGPathParseError);
-
-private:
-    bool _absolute;
-    Point _current;
-    Point _initial;
-    Point _cubic_tangent;
-    Point _quad_tangent;
-    std::vector<double> _params;
-    SVGPathSink &_sink;
-
-    void _reset() {
-        _absolute = false;
-        _current = _initial = Point(0, 0);
-        _quad_tangent = _cubic_tangent = Point(0, 0);
-        _params.clear();
-    }
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
 
-    void _push(double value) {
-        _params.push_back(value);
+/* Converts a number matched by the grammar, which may be followed by more path data.
+ * Numbers with at most 19 significant digits that fit in the 53 bits of a double
+ * are converted with a single multiplication or division by an exactly representable
+ * power of ten. Both operands are exact then, so the result is correctly rounded
+ * (Clinger's fast path). Returns false for the rare numbers that need strtod. */
+bool scan_number(char const *p, char const *end, double &value)
+{
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+    // excess precision would round twice
+    return false;
+#endif
+    static double const powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    bool negative = false;
+    if (*p == '+' || *p == '-') {
+        negative = *p == '-';
+        ++p;
     }
 
-    double _pop() {
-        double value = _params.back();
-        _params.pop_back();
-        return value;
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    for (; p != end && is_digit(*p); ++p) {
+        if (digits == 19) return false;
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa != 0) ++digits;
     }
-
-    bool _pop_flag() {
-        return _pop() != 0.0;
+    if (p != end && *p == '.') {
+        for (++p; p != end && is_digit(*p); ++p) {
+            if (digits == 19) return false;
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa != 0) ++digits;
+            --exponent;
+        }
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negative_exponent = false;
+        if (*p == '+' || *p == '-') {
+            negative_exponent = *p == '-';
+            ++p;
+        }
+        int e = 0;
+        for (; p != end && is_digit(*p); ++p) {
+            if (e < 10000) e = e * 10 + (*p - '0');
+        }
+        exponent += negative_exponent ? -e : e;
     }
 
-    double _pop_coord(Geom::Dim2 axis) {
-        if (_absolute) {
-            return _pop();
+    double v = mantissa;
+    if (mantissa != 0) {
+        if (mantissa > (1ULL << 53) || exponent < -22 || exponent > 22) return false;
+        if (exponent < 0) {
+            v /= powers_of_ten[-exponent];
         } else {
-            return _pop() + _current[axis];
+            v *= powers_of_ten[exponent];
         }
     }
+    value = negative ? -v : v;
+    return true;
+}
 
-    Point _pop_point() {
-        double y = _pop_coord(Geom::Y);
-        double x = _pop_coord(Geom::X);
-        return Point(x, y);
-    }
+}
 
-    void _moveTo(Point p) {
-        _quad_tangent = _cubic_tangent = _current = _initial = p;
-        _sink.moveTo(p);
-    }
-    
-    void _hlineTo(Point p) {
-        _quad_tangent = _cubic_tangent = _current = p;
-        _sink.hlineTo(p[Geom::X]);
+%%{
+    machine svg_path;
+    write data noerror;
+}%%
+
+SVGPathParser::SVGPathParser(SVGPathSink &sink)
+    : _absolute(false), _state(0), _sink(sink)
+{
+    reset();
+}
+
+void SVGPathParser::reset() {
+    _absolute = false;
+    _current = _initial = Point(0, 0);
+    _quad_tangent = _cubic_tangent = Point(0, 0);
+    _params.clear();
+    _number.clear();
+
+    int cs;
+    %% write init;
+    _state = cs;
+}
+
+void SVGPathParser::feed(char const *data, size_t len)
+throw(SVGPathParseError)
+{
+    _parse(data, data + len, false);
+}
+
+void SVGPathParser::finish()
+throw(SVGPathParseError)
+{
+    // the grammar ends at a null character
+    char const end = 0;
+    _parse(&end, &end + 1, true);
+    _sink.finish();
+}
+
+void SVGPathParser::parse(char const *str)
+throw(SVGPathParseError)
+{
+    reset();
+    feed(str, strlen(str));
+    finish();
+}
+
+void SVGPathParser::_push(double value) {
+    _params.push_back(value);
+}
+
+void SVGPathParser::_push_number(char const *start, char const *end) {
+    if (!_number.empty()) {
+        // the beginning of the number was in the previous piece of input
+        _number.append(start, end);
+        start = _number.data();
+        end = start + _number.size();
     }
-    
-    void _vlineTo(Point p) {
-        _quad_tangent = _cubic_tangent = _current = p;
-        _sink.vlineTo(p[Geom::Y]);
+    double value;
+    if (!scan_number(start, end, value)) {
+        if (_number.empty()) {
+            _number.assign(start, end);
+        }
+        value = g_ascii_strtod(_number.c_str(), NULL);
     }
+    _number.clear();
+    _push(value);
+}
 
-    void _lineTo(Point p) {
-        _quad_tangent = _cubic_tangent = _current = p;
-        _sink.lineTo(p);
-    }
+double SVGPathParser::_pop() {
+    double value = _params.back();
+    _params.pop_back();
+    return value;
+}
 
-    void _curveTo(Point c0, Point c1, Point p) {
-        _quad_tangent = _current = p;
-        _cubic_tangent = p + ( p - c1 );
-        _sink.curveTo(c0, c1, p);
-    }
+bool SVGPathParser::_pop_flag() {
+    return _pop() != 0.0;
+}
 
-    void _quadTo(Point c, Point p) {
-        _cubic_tangent = _current = p;
-        _quad_tangent = p + ( p - c );
-        _sink.quadTo(c, p);
+double SVGPathParser::_pop_coord(Geom::Dim2 axis) {
+    if (_absolute) {
+        return _pop();
+    } else {
+        return _pop() + _current[axis];
     }
+}
 
-    void _arcTo(double rx, double ry, double angle,
-                bool large_arc, bool sweep, Point p)
-    {
-        _quad_tangent = _cubic_tangent = _current = p;
-        _sink.arcTo(rx, ry, angle, large_arc, sweep, p);
-    }
+Point SVGPathParser::_pop_point() {
+    double y = _pop_coord(Geom::Y);
+    double x = _pop_coord(Geom::X);
+    return Point(x, y);
+}
 
-    void _closePath() {
-        _quad_tangent = _cubic_tangent = _current = _initial;
-        _sink.closePath();
-    }
-};
+void SVGPathParser::_moveTo(Point p) {
+    _quad_tangent = _cubic_tangent = _current = _initial = p;
+    _sink.moveTo(p);
+}
 
-%%{
-    machine svg_path;
-    write data noerror;
-}%%
+void SVGPathParser::_hlineTo(Point p) {
+    _quad_tangent = _cubic_tangent = _current = p;
+    _sink.hlineTo(p[Geom::X]);
+}
 
-void Parser::parse(char const *str)
+void SVGPathParser::_vlineTo(Point p) {
+    _quad_tangent = _cubic_tangent = _current = p;
+    _sink.vlineTo(p[Geom::Y]);
+}
+
+void SVGPathParser::_lineTo(Point p) {
+    _quad_tangent = _cubic_tangent = _current = p;
+    _sink.lineTo(p);
+}
+
+void SVGPathParser::_curveTo(Point c0, Point c1, Point p) {
+    _quad_tangent = _current = p;
+    _cubic_tangent = p + ( p - c1 );
+    _sink.curveTo(c0, c1, p);
+}
+
+void SVGPathParser::_quadTo(Point c, Point p) {
+    _cubic_tangent = _current = p;
+    _quad_tangent = p + ( p - c );
+    _sink.quadTo(c, p);
+}
+
+void SVGPathParser::_arcTo(double rx, double ry, double angle,
+                           bool large_arc, bool sweep, Point p)
+{
+    _quad_tangent = _cubic_tangent = _current = p;
+    _sink.arcTo(rx, ry, angle, large_arc, sweep, p);
+}
+
+void SVGPathParser::_closePath() {
+    _quad_tangent = _cubic_tangent = _current = _initial;
+    _sink.closePath();
+}
+
+void SVGPathParser::_parse(char const *str, char const *strend, bool finish)
 throw(SVGPathParseError)
 {
     char const *p = str;
-    char const *start = NULL;
-    int cs;
-
-    _reset();
+    char const *pe = strend;
+    // we are in the middle of a number if the previous piece ended with one
+    char const *start = _number.empty() ? NULL : p;
+    int cs = _state;
 
     %%{
         action start_number {
@@ -158,9 +265,7 @@ throw(SVGPathParseError)
         }
 
         action push_number {
-            char const *end=p;
-            std::string buf(start, end);
-            _push(g_ascii_strtod(buf.c_str(), NULL));
+            _push_number(start, p);
             start = NULL;
         }
 
@@ -374,24 +479,24 @@ throw(SVGPathParseError)
 
         main := svg_path;
 
-        # Inintialize and execute.
-        write init;
-        write exec noend;
+        write exec;
     }%%
 
-    if ( cs < svg_path_first_final ) {
+    _state = cs;
+    if (finish ? cs < svg_path_first_final : cs == 0) {
         throw SVGPathParseError();
     }
-}
-
+    if (start) {
+        // keep the part of the number seen so far for the next call
+        _number.append(start, pe);
+    }
 }
 
 void parse_svg_path(char const *str, SVGPathSink &sink)
 throw(SVGPathParseError)
 {
-    Parser parser(sink);
+    SVGPathParser parser(sink);
     parser.parse(str);
-    sink.finish();
 }
 
 }
@@ -1,9 +1,14 @@
 #include <2geom/sweep.h>
 
 #include <algorithm>
+#include <limits>
 
 namespace Geom {
 
+/* Below this many rectangles the plain list of open rectangles is faster
+ * than maintaining the interval tree. */
+static const unsigned SWEEP_TREE_THRESHOLD = 64;
+
 /**
  * \brief Make a list of pairs of self intersections in a list of Rects.
  * 
@@ -12,9 +17,43 @@ namespace Geom {
  *
  * [(A = rs[i], B = rs[j]) for i,J in enumerate(pairs) for j in J]
  * then A.left <= B.left
+ *
+ * Small inputs are handled by sweep_bounds_scan(), larger ones by sweep_bounds_tree().
+ * Both return identical results.
  */
-
 std::vector<std::vector<unsigned> > sweep_bounds(std::vector<Rect> rs, Dim2 d) {
+    if(rs.size() < SWEEP_TREE_THRESHOLD) return sweep_bounds_scan(rs, d);
+    return sweep_bounds_tree(rs, d);
+}
+
+/**
+ * \brief Make a list of pairs of red-blue intersections between two lists of Rects.
+ * 
+ * \param a: vector of Rect.
+ * \param b: vector of Rect.
+ * \param d: dimension to scan along
+ *
+ * [(A = rs[i], B = rs[j]) for i,J in enumerate(pairs) for j in J]
+ * then A.left <= B.left, A in a, B in b
+ *
+ * Small inputs are handled by sweep_bounds_scan(), larger ones by sweep_bounds_tree().
+ * Both return identical results.
+ */
+std::vector<std::vector<unsigned> > sweep_bounds(std::vector<Rect> a, std::vector<Rect> b, Dim2 d) {
+    if(a.size() < SWEEP_TREE_THRESHOLD && b.size() < SWEEP_TREE_THRESHOLD) {
+        return sweep_bounds_scan(a, b, d);
+    }
+    return sweep_bounds_tree(a, b, d);
+}
+
+/**
+ * \brief Self intersections of a list of Rects, keeping the open Rects in a plain list.
+ *
+ * Every newly opened Rect is tested against all open ones, so this is quadratic
+ * when many Rects overlap along the sweep dimension.
+ * \see sweep_bounds()
+ */
+std::vector<std::vector<unsigned> > sweep_bounds_scan(std::vector<Rect> const &rs, Dim2 d) {
     std::vector<Event> events; events.reserve(rs.size()*2);
     std::vector<std::vector<unsigned> > pairs(rs.size());
 
@@ -45,16 +84,10 @@ std::vector<std::vector<unsigned> > sweep_bounds(std::vector<Rect> rs, Dim2 d) {
 }
 
 /**
- * \brief Make a list of pairs of red-blue intersections between two lists of Rects.
- * 
- * \param a: vector of Rect.
- * \param b: vector of Rect.
- * \param d: dimension to scan along
- *
- * [(A = rs[i], B = rs[j]) for i,J in enumerate(pairs) for j in J]
- * then A.left <= B.left, A in a, B in b
+ * \brief Red-blue intersections of two lists of Rects, keeping the open Rects in plain lists.
+ * \see sweep_bounds()
  */
-std::vector<std::vector<unsigned> > sweep_bounds(std::vector<Rect> a, std::vector<Rect> b, Dim2 d) {
+std::vector<std::vector<unsigned> > sweep_bounds_scan(std::vector<Rect> const &a, std::vector<Rect> const &b, Dim2 d) {
     std::vector<std::vector<unsigned> > pairs(a.size());
     if(a.empty() || b.empty()) return pairs;
     std::vector<Event> events[2];
@@ -106,11 +139,192 @@ std::vector<std::vector<unsigned> > sweep_bounds(std::vector<Rect> a, std::vecto
         }
         i[n]++;
 	if(i[n]>=events[n].size()) {break;}
-        n = (events[!n][i[!n]] < events[n][i[n]]) ? !n : n;
+        if(i[!n] < events[!n].size() && events[!n][i[!n]] < events[n][i[n]]) n = !n;
     }}
     return pairs;
 }
 
+namespace {
+
+/* The Rects that are open at the current sweep position, ordered by their lower
+ * bound in the other dimension. The set is an implicit balanced binary tree laid
+ * out in a flat array: leaves hold the Rects in that order, and every node stores
+ * the largest upper bound among the open Rects below it (-infinity if none are
+ * open). Opening and closing update one root path; a query visits only subtrees
+ * that contain an overlapping Rect, so it costs O((k+1) log n) for k results. */
+class ActiveIntervals {
+public:
+    ActiveIntervals(std::vector<Rect> const &rs, Dim2 d)
+        : _rs(rs)
+        , _d(d)
+        , _order(rs.size())
+        , _slot(rs.size())
+        , _lower(rs.size())
+        , _opened(rs.size(), 0)
+        , _serial(0)
+    {
+        for(unsigned i = 0; i < _order.size(); i++) _order[i] = i;
+        std::sort(_order.begin(), _order.end(), LowerLess(rs, d));
+        for(unsigned i = 0; i < _order.size(); i++) {
+            _slot[_order[i]] = i;
+            _lower[i] = rs[_order[i]][d].min();
+        }
+        _leaves = 1;
+        while(_leaves < rs.size()) _leaves *= 2;
+        _upper.assign(2*_leaves, -std::numeric_limits<Coord>::infinity());
+    }
+
+    void open(unsigned ix) {
+        _opened[ix] = ++_serial;
+        _update(ix, _rs[ix][_d].max());
+    }
+    void close(unsigned ix) {
+        _update(ix, -std::numeric_limits<Coord>::infinity());
+    }
+    /// Append the indices of all open Rects that intersect iv to out, in the order they were opened.
+    void overlapping(Interval const &iv, std::vector<unsigned> &out) const {
+        std::size_t start = out.size();
+        unsigned end = std::upper_bound(_lower.begin(), _lower.end(), iv.max()) - _lower.begin();
+        _collect(1, 0, _leaves, end, iv.min(), out);
+        std::sort(out.begin() + start, out.end(), OpenedLess(_opened));
+    }
+
+private:
+    struct LowerLess {
+        std::vector<Rect> const &rs;
+        Dim2 d;
+        LowerLess(std::vector<Rect> const &r, Dim2 dim) : rs(r), d(dim) {}
+        bool operator()(unsigned i, unsigned j) const {
+            return rs[i][d].min() < rs[j][d].min();
+        }
+    };
+    struct OpenedLess {
+        std::vector<unsigned> const &opened;
+        OpenedLess(std::vector<unsigned> const &o) : opened(o) {}
+        bool operator()(unsigned i, unsigned j) const {
+            return opened[i] < opened[j];
+        }
+    };
+
+    void _update(unsigned ix, Coord upper) {
+        unsigned node = _leaves + _slot[ix];
+        _upper[node] = upper;
+        for(node /= 2; node > 0; node /= 2) {
+            _upper[node] = std::max(_upper[2*node], _upper[2*node + 1]);
+        }
+    }
+    void _collect(unsigned node, unsigned first, unsigned last, unsigned end,
+                  Coord lower, std::vector<unsigned> &out) const
+    {
+        if(first >= end || _upper[node] < lower) return;
+        if(last - first == 1) {
+            out.push_back(_order[first]);
+            return;
+        }
+        unsigned mid = first + (last - first) / 2;
+        _collect(2*node, first, mid, end, lower, out);
+        _collect(2*node + 1, mid, last, end, lower, out);
+    }
+
+    std::vector<Rect> const &_rs;
+    Dim2 _d;
+    std::vector<unsigned> _order;  // Rect indices sorted by lower bound
+    std::vector<unsigned> _slot;   // inverse of _order
+    std::vector<Coord> _lower;     // lower bounds in sorted order
+    std::vector<Coord> _upper;     // tree of largest open upper bounds
+    std::vector<unsigned> _opened; // when each Rect was last opened
+    unsigned _serial;
+    unsigned _leaves;
+};
+
+} // anonymous namespace
+
+/**
+ * \brief Self intersections of a list of Rects, keeping the open Rects in an interval tree.
+ *
+ * Runs in O((n+k) log n) time for n Rects and k overlapping pairs. The result is
+ * identical to that of sweep_bounds_scan().
+ * \see sweep_bounds()
+ */
+std::vector<std::vector<unsigned> > sweep_bounds_tree(std::vector<Rect> const &rs, Dim2 d) {
+    std::vector<Event> events; events.reserve(rs.size()*2);
+    std::vector<std::vector<unsigned> > pairs(rs.size());
+
+    for(unsigned i = 0; i < rs.size(); i++) {
+        events.push_back(Event(rs[i][d][0], i, false));
+        events.push_back(Event(rs[i][d][1], i, true));
+    }
+    std::sort(events.begin(), events.end());
+
+    Dim2 o = (Dim2)(1-d);
+    ActiveIntervals open(rs, o);
+    std::vector<unsigned> hits;
+    for(unsigned i = 0; i < events.size(); i++) {
+        unsigned ix = events[i].ix;
+        if(events[i].closing) {
+            open.close(ix);
+        } else {
+            hits.clear();
+            open.overlapping(rs[ix][o], hits);
+            for(unsigned j = 0; j < hits.size(); j++) {
+                pairs[hits[j]].push_back(ix);
+            }
+            open.open(ix);
+        }
+    }
+    return pairs;
+}
+
+/**
+ * \brief Red-blue intersections of two lists of Rects, keeping the open Rects in interval trees.
+ *
+ * Runs in O((n+k) log n) time. The result is identical to that of sweep_bounds_scan().
+ * \see sweep_bounds()
+ */
+std::vector<std::vector<unsigned> > sweep_bounds_tree(std::vector<Rect> const &a, std::vector<Rect> const &b, Dim2 d) {
+    std::vector<std::vector<unsigned> > pairs(a.size());
+    if(a.empty() || b.empty()) return pairs;
+    std::vector<Event> events[2];
+
+    for(unsigned n = 0; n < 2; n++) {
+        std::vector<Rect> const &rs = n ? b : a;
+        events[n].reserve(rs.size()*2);
+        for(unsigned i = 0; i < rs.size(); i++) {
+            events[n].push_back(Event(rs[i][d][0], i, false));
+            events[n].push_back(Event(rs[i][d][1], i, true));
+        }
+        std::sort(events[n].begin(), events[n].end());
+    }
+
+    Dim2 o = (Dim2)(1-d);
+    ActiveIntervals open_a(a, o), open_b(b, o);
+    std::vector<unsigned> hits;
+    bool n = events[1].front() < events[0].front();
+    unsigned i[] = {0,0};
+    while(i[n] < events[n].size()) {
+        unsigned ix = events[n][i[n]].ix;
+        if(events[n][i[n]].closing) {
+            (n ? open_b : open_a).close(ix);
+        } else if(n) {
+            //opening a B, add to all open a
+            hits.clear();
+            open_a.overlapping(b[ix][o], hits);
+            for(unsigned j = 0; j < hits.size(); j++) {
+                pairs[hits[j]].push_back(ix);
+            }
+            open_b.open(ix);
+        } else {
+            //opening an A, add all open b
+            open_b.overlapping(a[ix][o], pairs[ix]);
+            open_a.open(ix);
+        }
+        i[n]++;
+        if(i[n] >= events[n].size()) break;
+        if(i[!n] < events[!n].size() && events[!n][i[!n]] < events[n][i[n]]) n = !n;
+    }
+    return pairs;
+}
+
 //Fake cull, until the switch to the real sweep is made.
 std::vector<std::vector<unsigned> > fake_cull(unsigned a, unsigned b) {
     std::vector<std::vector<unsigned> > ret;
@@ -61,6 +61,18 @@ sweep_bounds(std::vector<Rect>, Dim2 dim = X);
 std::vector<std::vector<unsigned> >
 sweep_bounds(std::vector<Rect>, std::vector<Rect>, Dim2 dim = X);
 
+std::vector<std::vector<unsigned> >
+sweep_bounds_scan(std::vector<Rect> const &, Dim2 dim = X);
+
+std::vector<std::vector<unsigned> >
+sweep_bounds_scan(std::vector<Rect> const &, std::vector<Rect> const &, Dim2 dim = X);
+
+std::vector<std::vector<unsigned> >
+sweep_bounds_tree(std::vector<Rect> const &, Dim2 dim = X);
+
+std::vector<std::vector<unsigned> >
+sweep_bounds_tree(std::vector<Rect> const &, std::vector<Rect> const &, Dim2 dim = X);
+
 std::vector<std::vector<unsigned> > fake_cull(unsigned a, unsigned b);
 
 }
@@ -0,0 +1,755 @@
+/*
+ * Benchmark suite for the main operations of the library, with JSON output
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/basic-intersection.h>
+#include <2geom/bezier-curve.h>
+#include <2geom/indexed-pathvector.h>
+#include <2geom/path-intersection.h>
+#include <2geom/piecewise.h>
+#include <2geom/rtree.h>
+#include <2geom/sbasis.h>
+#include <2geom/shape.h>
+#include <2geom/svg-elliptical-arc.h>
+#include <2geom/svg-path-parser.h>
+#include <2geom/sweep.h>
+#include <2geom/transforms.h>
+#include "testing.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <getopt.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef LIB2GEOM_VERSION
+#define LIB2GEOM_VERSION "unknown"
+#endif
+
+using namespace Geom;
+
+/* Every allocation of the program, the library included, goes through these,
+ * so that the benchmarks can report allocations per operation. */
+static unsigned long alloc_count = 0;
+static unsigned long alloc_bytes = 0;
+
+#if __cplusplus >= 201103L
+#define BENCH_THROW_BAD_ALLOC
+#define BENCH_NOTHROW noexcept
+#else
+#define BENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define BENCH_NOTHROW throw()
+#endif
+
+void *operator new(std::size_t size) BENCH_THROW_BAD_ALLOC {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    alloc_count++;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    alloc_bytes += size;
+    void *p = std::malloc(size ? size : 1);
+    if(!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) BENCH_NOTHROW {
+    std::free(p);
+}
+
+#if __cplusplus >= 201402L
+// C++14 calls this one when the size is known
+void operator delete(void *p, std::size_t) BENCH_NOTHROW {
+    std::free(p);
+}
+#endif
+
+static double now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// results go here so that the compiler cannot drop the work
+static volatile double sink;
+
+/* The inputs of all benchmarks, made once with a fixed seed. */
+struct Data {
+    std::vector<CubicBezier> cubics;
+    std::vector<Bezier> cubic_xs;   // X coordinates of the cubics, of runtime order
+    std::vector<SVGEllipticalArc> arcs;
+    std::vector<Point> points;
+    std::vector<Coord> times;
+    Path path;                   // 200 curves of all kinds
+    PathVector paths;            // 50 closed paths in the same box
+    PathVector rounded_arcs;     // 20 overlapping rounded rectangles with arcs at the corners
+    PathVector rounded_cubics;   // the same with cubic corners
+    IndexedPathVector indexed;
+    std::vector<std::vector<Point> > bezier_points;
+    std::vector<std::pair<unsigned, unsigned> > bezier_pairs;
+    std::vector<CubicBezier> crossing_cubics; // each crosses cubics[i] once at time 0.5
+    std::vector<std::pair<Coord, Coord> > rough_crossings;
+    Shape star_a, star_b;
+    std::vector<Shape> footprints;
+    std::string svg;
+    unsigned svg_segments;
+    SBasis sb_a, sb_b, sb_inner;
+    Piecewise<SBasis> pw_a, pw_b;
+    std::vector<RTree<unsigned>::Item> items;
+    std::vector<Rect> rects;
+    RTree<unsigned> tree;
+};
+
+static Path random_path(Point const &o, Coord size, unsigned curves) {
+    Path p(o);
+    for(unsigned j = 0; j < curves; j++) {
+        Point a = o + size * Point(uniform(), uniform());
+        Point b = o + size * Point(uniform(), uniform());
+        Point c = o + size * Point(uniform(), uniform());
+        switch(j % 4) {
+        case 0:
+            p.appendNew<LineSegment>(a);
+            break;
+        case 1:
+            p.appendNew<QuadraticBezier>(a, b);
+            break;
+        case 2:
+            p.appendNew<CubicBezier>(a, b, c);
+            break;
+        default:
+            p.appendNew<SVGEllipticalArc>(size * 0.5, size * 0.5 * (0.2 + uniform()),
+                                          uniform() * M_PI, false, true, a);
+            break;
+        }
+    }
+    p.close();
+    return p;
+}
+
+/* A rounded rectangle, with quarter circles at the corners, or their usual cubic
+ * approximations. */
+static Path rounded_rect(Rect const &r, Coord radius, bool arcs) {
+    Path p(Point(r.left() + radius, r.top()));
+    for(unsigned i = 0; i < 4; i++) {
+        Point corner = r.corner((i + 1) % 4);
+        Point along = (r.corner((i + 2) % 4) - corner) * (radius / distance(r.corner((i + 2) % 4), corner));
+        Point before = corner + rot90(along);
+        Point after = corner + along;
+        p.appendNew<LineSegment>(before);
+        if(arcs) {
+            p.appendNew<SVGEllipticalArc>(radius, radius, 0, false, true, after);
+        } else {
+            p.appendNew<CubicBezier>(lerp(0.5523, before, corner), lerp(0.5523, after, corner), after);
+        }
+    }
+    p.close();
+    return p;
+}
+
+static Shape polygon(Point const &c, Coord r, unsigned corners, Coord dent) {
+    Path p(c + Point(r, 0));
+    for(unsigned i = 1; i < corners; i++) {
+        Coord rr = i % 2 ? r * dent : r;
+        p.appendNew<LineSegment>(c + rr * Point::polar(2 * M_PI * i / corners));
+    }
+    p.close();
+    return Shape(Region(p).asFill());
+}
+
+static void make_data(Data &d) {
+    std::srand(0);
+    for(unsigned i = 0; i < 1000; i++) {
+        Point o(uniform() * 1000, uniform() * 1000);
+        d.cubics.push_back(CubicBezier(o, o + Point(uniform() * 100, uniform() * 100),
+                                       o + Point(uniform() * 100, uniform() * 100),
+                                       o + Point(uniform() * 100, uniform() * 100)));
+        d.arcs.push_back(SVGEllipticalArc(o, 20 + uniform() * 50, 10 + uniform() * 50,
+                                          uniform() * M_PI, uniform() < 0.5, uniform() < 0.5,
+                                          o + Point(uniform() * 80, uniform() * 80)));
+        d.points.push_back(Point(uniform() * 1100, uniform() * 1100));
+        d.times.push_back(uniform());
+    }
+    d.path = random_path(Point(0, 0), 1000, 200);
+    for(unsigned i = 0; i < 50; i++) {
+        d.paths.push_back(random_path(Point(uniform() * 800, uniform() * 800), 200, 12));
+    }
+    d.indexed.assign(d.paths);
+    for(unsigned i = 0; i < 20; i++) {
+        Point o(uniform() * 150, uniform() * 150);
+        Rect r(o, o + Point(30 + uniform() * 40, 30 + uniform() * 40));
+        Coord radius = 5 + uniform() * 10;
+        d.rounded_arcs.push_back(rounded_rect(r, radius, true));
+        d.rounded_cubics.push_back(rounded_rect(r, radius, false));
+    }
+
+    for(unsigned i = 0; i < 1000; i++) {
+        d.bezier_points.push_back(d.cubics[i].points());
+        d.cubic_xs.push_back(Bezier(d.cubics[i][0][X], d.cubics[i][1][X],
+                                    d.cubics[i][2][X], d.cubics[i][3][X]));
+        d.bezier_pairs.push_back(std::make_pair(i, (i * 7 + 1) % 1000));
+
+        // an estimate off by about 1e-4, as left by subdivision
+        Coord t = 0.1 + 0.8 * uniform();
+        Point p = d.cubics[i].pointAt(t);
+        Point v(uniform() * 40 - 20, uniform() * 40 - 20), w(uniform() * 10, uniform() * 10);
+        d.crossing_cubics.push_back(CubicBezier(p - v, p - v / 3 + w, p + v / 3 - w, p + v));
+        d.rough_crossings.push_back(std::make_pair(t + 1e-4 * (uniform() - 0.5),
+                                                   0.5 + 1e-4 * (uniform() - 0.5)));
+    }
+
+    d.star_a = polygon(Point(0, 0), 100, 32, 0.6);
+    d.star_b = polygon(Point(30, 20), 100, 32, 0.7);
+    for(unsigned i = 0; i < 64; i++) {
+        Point c(i % 8 * 9 + uniform() * 2, i / 8 * 30 + uniform() * 10);
+        d.footprints.push_back(polygon(c, 6, 4, 1) * Rotate(uniform() * 0.3));
+    }
+
+    std::ostringstream svg;
+    svg << "M 0,0";
+    d.svg_segments = 0;
+    for(unsigned i = 0; i < 250; i++) {
+        svg << " L " << uniform() * 1000 << "," << uniform() * 1000
+            << " Q " << uniform() * 1000 << "," << uniform() * 1000 << " "
+            << uniform() * 1000 << "," << uniform() * 1000
+            << " C " << uniform() * 1000 << "," << uniform() * 1000 << " "
+            << uniform() * 1000 << "," << uniform() * 1000 << " "
+            << uniform() * 1000 << "," << uniform() * 1000
+            << " A 50,30 " << uniform() * 180 << " 0 1 " << uniform() * 1000 << ","
+            << uniform() * 1000;
+        d.svg_segments += 4;
+    }
+    svg << " z";
+    d.svg = svg.str();
+
+    d.sb_a.resize(8);
+    d.sb_b.resize(8);
+    for(unsigned i = 0; i < 8; i++) {
+        d.sb_a[i] = Linear(uniform() - 0.5, uniform() - 0.5);
+        d.sb_b[i] = Linear(uniform() - 0.5, uniform() - 0.5);
+    }
+    d.sb_inner.resize(2);
+    d.sb_inner[0] = Linear(0.1, 0.9);
+    d.sb_inner[1] = Linear(0.2, -0.1);
+    d.pw_a = Piecewise<SBasis>(d.sb_a);
+    d.pw_b = partition(Piecewise<SBasis>(d.sb_b), std::vector<double>(1, 0.5));
+
+    for(unsigned i = 0; i < 10000; i++) {
+        Point o(uniform() * 1000, uniform() * 1000);
+        Rect r(o, o + Point(uniform() * 10, uniform() * 10));
+        d.items.push_back(std::make_pair(r, i));
+        d.rects.push_back(r);
+    }
+    d.tree.assign(d.items.begin(), d.items.end());
+}
+
+/* Each benchmark does its operation n times. An operation may handle several
+ * items, e.g. one batch of points, which is recorded to report time per item. */
+typedef void (*BenchFunc)(Data const &d, unsigned n);
+
+struct Benchmark {
+    char const *name;
+    unsigned items;
+    BenchFunc run;
+};
+
+static void cubic_point_at(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += d.cubics[i % 1000].pointAt(d.times[i % 997])[X];
+    sink = s;
+}
+
+static void cubic_points_at(Data const &d, unsigned n) {
+    Point out[1000];
+    for(unsigned i = 0; i < n; i++) {
+        d.cubics[i % 1000].pointsAt(&d.times[0], out, 1000);
+        sink = out[i % 1000][X];
+    }
+}
+
+static void cubic_subdivide(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) {
+        std::pair<CubicBezier, CubicBezier> parts = d.cubics[i % 1000].subdivide(d.times[i % 997]);
+        s += parts.first[1][X] + parts.second[2][Y];
+    }
+    sink = s;
+}
+
+static void cubic_portion(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) {
+        Coord t = d.times[i % 997] * 0.8;
+        Curve *part = d.cubics[i % 1000].portion(t, t + 0.2);
+        s += part->initialPoint()[X];
+        delete part;
+    }
+    sink = s;
+}
+
+static void bezier_value_at(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += d.cubic_xs[i % 1000].valueAt(d.times[i % 997]);
+    sink = s;
+}
+
+static void bezier_subdivide(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) {
+        std::pair<Bezier, Bezier> parts = d.cubic_xs[i % 1000].subdivide(d.times[i % 997]);
+        s += parts.first[1] + parts.second[2];
+    }
+    sink = s;
+}
+
+static void bezier_bounds_exact(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += bounds_exact(d.cubic_xs[i % 1000])->extent();
+    sink = s;
+}
+
+static void arc_point_at(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += d.arcs[i % 1000].pointAt(d.times[i % 997])[X];
+    sink = s;
+}
+
+static void path_point_at(Data const &d, unsigned n) {
+    Coord s = 0, size = d.path.size_default();
+    for(unsigned i = 0; i < n; i++) s += d.path.pointAt(d.times[i % 1000] * size)[X];
+    sink = s;
+}
+
+static void cubic_bounds_exact(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += d.cubics[i % 1000].boundsExact().width();
+    sink = s;
+}
+
+static void arc_bounds_exact(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += d.arcs[i % 1000].boundsExact().width();
+    sink = s;
+}
+
+static void cubic_bounds_local(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) {
+        Coord t = d.times[i % 997] * 0.8;
+        s += d.cubics[i % 1000].boundsLocal(Interval(t, t + 0.2), 0)->width();
+    }
+    sink = s;
+}
+
+static void arc_bounds_local(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) {
+        Coord t = d.times[i % 997] * 0.8;
+        s += d.arcs[i % 1000].boundsLocal(Interval(t, t + 0.2), 0)->width();
+    }
+    sink = s;
+}
+
+static void cubic_nearest_point(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += d.cubics[i % 1000].nearestPoint(d.points[i % 997]);
+    sink = s;
+}
+
+static void cubic_nearest_points(Data const &d, unsigned n) {
+    std::vector<Coord> ts(1000);
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) {
+        d.cubics[i % 1000].nearestPoints(&d.points[0], &ts[0], 1000);
+        s += ts[i % 1000];
+    }
+    sink = s;
+}
+
+static void path_nearest_point(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += d.path.nearestPoint(d.points[i % 1000]);
+    sink = s;
+}
+
+static void indexed_nearest_point(Data const &d, unsigned n) {
+    Coord s = 0;
+    for(unsigned i = 0; i < n; i++) s += d.indexed.nearestPoint(d.points[i % 1000])->t;
+    sink = s;
+}
+
+static void path_crossings(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) {
+        sink = crossings(d.paths[i % 50], d.paths[(i + 1) % 50]).size();
+    }
+}
+
+static void rounded_arcs_crossings(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) {
+        sink = crossings(d.rounded_arcs[i % 20], d.rounded_arcs[(i + 1) % 20]).size();
+    }
+}
+
+static void rounded_cubics_crossings(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) {
+        sink = crossings(d.rounded_cubics[i % 20], d.rounded_cubics[(i + 1) % 20]).size();
+    }
+}
+
+// the points fall in and around the rounded rectangles
+static void rounded_arcs_winding(Data const &d, unsigned n) {
+    int w = 0;
+    for(unsigned i = 0; i < n; i++) w += winding(d.rounded_arcs[i % 20], d.points[i % 997] * 0.2);
+    sink = w;
+}
+
+static void rounded_cubics_winding(Data const &d, unsigned n) {
+    int w = 0;
+    for(unsigned i = 0; i < n; i++) w += winding(d.rounded_cubics[i % 20], d.points[i % 997] * 0.2);
+    sink = w;
+}
+
+static void paths_crossings_among(Data const &d, unsigned n) {
+    std::vector<Path> ps(d.paths.begin(), d.paths.begin() + 20);
+    for(unsigned i = 0; i < n; i++) sink = crossings_among(ps).size();
+}
+
+static void bezier_clipping_batch(Data const &d, unsigned n) {
+    std::vector<std::vector<std::pair<double, double> > > xs;
+    for(unsigned i = 0; i < n; i++) {
+        find_intersections_bezier_clipping(xs, d.bezier_points, d.bezier_pairs);
+        sink = xs.size();
+    }
+}
+
+static void polish_crossings(Data const &d, unsigned n) {
+    Coord sum = 0;
+    for(unsigned i = 0; i < n; i++) {
+        for(unsigned k = 0; k < 1000; k++) {
+            Coord s = d.rough_crossings[k].first, t = d.rough_crossings[k].second;
+            polish_intersection(d.cubics[k], s, d.crossing_cubics[k], t);
+            sum += s + t;
+        }
+    }
+    sink = sum;
+}
+
+static void boolean_union(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = boolop(d.star_a, d.star_b, BOOLOP_UNION).size();
+}
+
+static void boolean_intersect(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = boolop(d.star_a, d.star_b, BOOLOP_INTERSECT).size();
+}
+
+static void boolean_union_all(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = union_all(d.footprints).size();
+}
+
+static void svg_parse(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = parse_svg_path(d.svg.c_str()).size();
+}
+
+static void sbasis_add(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = (d.sb_a + d.sb_b)[0][0];
+}
+
+static void sbasis_multiply(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = (d.sb_a * d.sb_b)[0][0];
+}
+
+static void sbasis_multiply_into(Data const &d, unsigned n) {
+    SBasis c;
+    for(unsigned i = 0; i < n; i++) {
+        multiply_into(c, d.sb_a, d.sb_b);
+        sink = c[0][0];
+    }
+}
+
+static void sbasis_compose(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = compose(d.sb_a, d.sb_inner)[0][0];
+}
+
+static void sbasis_derivative(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = derivative(d.sb_a)[0][0];
+}
+
+static void sbasis_roots(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = roots(d.sb_a).size();
+}
+
+static void piecewise_multiply(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = (d.pw_a * d.pw_b).size();
+}
+
+static void rtree_bulk_load(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) {
+        RTree<unsigned> tree(d.items.begin(), d.items.end());
+        sink = tree.height();
+    }
+}
+
+static void rtree_insert(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) {
+        RTree<unsigned> tree;
+        for(unsigned k = 0; k < d.items.size(); k++) tree.insert(d.items[k]);
+        sink = tree.height();
+    }
+}
+
+struct CountVisitor {
+    unsigned found;
+    CountVisitor() : found(0) {}
+    bool operator()(Rect const &, unsigned) { ++found; return true; }
+};
+
+static void rtree_window_query(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) {
+        Point p = d.points[i % 1000];
+        CountVisitor v;
+        d.tree.visit(Rect(p, p + Point(20, 20)), v);
+        sink = v.found;
+    }
+}
+
+static void rtree_nearest(Data const &d, unsigned n) {
+    std::vector<unsigned> out;
+    for(unsigned i = 0; i < n; i++) {
+        out.clear();
+        d.tree.nearest(d.points[i % 1000], 8, out);
+        sink = out[0];
+    }
+}
+
+static void sweep_bounds_self(Data const &d, unsigned n) {
+    for(unsigned i = 0; i < n; i++) sink = sweep_bounds(d.rects).size();
+}
+
+static Benchmark const benchmarks[] = {
+    {"curve/cubic-point-at", 1, cubic_point_at},
+    {"curve/cubic-points-at-1000", 1000, cubic_points_at},
+    {"curve/cubic-subdivide", 1, cubic_subdivide},
+    {"curve/cubic-portion", 1, cubic_portion},
+    {"curve/arc-point-at", 1, arc_point_at},
+    {"bezier/cubic-value-at", 1, bezier_value_at},
+    {"bezier/cubic-subdivide", 1, bezier_subdivide},
+    {"bezier/cubic-bounds-exact", 1, bezier_bounds_exact},
+    {"path/point-at", 1, path_point_at},
+    {"bounds/cubic-exact", 1, cubic_bounds_exact},
+    {"bounds/arc-exact", 1, arc_bounds_exact},
+    {"bounds/cubic-local", 1, cubic_bounds_local},
+    {"bounds/arc-local", 1, arc_bounds_local},
+    {"nearest/cubic", 1, cubic_nearest_point},
+    {"nearest/cubic-batch-1000", 1000, cubic_nearest_points},
+    {"nearest/path-200", 1, path_nearest_point},
+    {"nearest/indexed-pathvector-50", 1, indexed_nearest_point},
+    {"intersection/path-pair", 1, path_crossings},
+    {"intersection/crossings-among-20", 1, paths_crossings_among},
+    {"intersection/rounded-rect-arcs", 1, rounded_arcs_crossings},
+    {"intersection/rounded-rect-cubics", 1, rounded_cubics_crossings},
+    {"winding/rounded-rect-arcs", 1, rounded_arcs_winding},
+    {"winding/rounded-rect-cubics", 1, rounded_cubics_winding},
+    {"intersection/polish-1000", 1000, polish_crossings},
+    {"intersection/bezier-clipping-batch-1000", 1000, bezier_clipping_batch},
+    {"boolean/union", 1, boolean_union},
+    {"boolean/intersect", 1, boolean_intersect},
+    {"boolean/union-all-64", 64, boolean_union_all},
+    {"svg/parse-1000", 1000, svg_parse},
+    {"sbasis/add", 1, sbasis_add},
+    {"sbasis/multiply", 1, sbasis_multiply},
+    {"sbasis/multiply-into", 1, sbasis_multiply_into},
+    {"sbasis/compose", 1, sbasis_compose},
+    {"sbasis/derivative", 1, sbasis_derivative},
+    {"sbasis/roots", 1, sbasis_roots},
+    {"sbasis/piecewise-multiply", 1, piecewise_multiply},
+    {"spatial/rtree-bulk-load-10k", 10000, rtree_bulk_load},
+    {"spatial/rtree-insert-10k", 10000, rtree_insert},
+    {"spatial/rtree-window-query", 1, rtree_window_query},
+    {"spatial/rtree-8-nearest", 1, rtree_nearest},
+    {"spatial/sweep-bounds-10k", 10000, sweep_bounds_self},
+};
+
+struct Result {
+    unsigned long iterations;
+    double ns_per_op, min_ns_per_op;
+    double allocs_per_op, bytes_per_op;
+};
+
+/* Doubles the number of operations until one run takes min_time, then takes the
+ * median and the fastest of several runs of that size. */
+static Result measure(Benchmark const &b, Data const &d, double min_time, unsigned trials) {
+    unsigned long n = 1;
+    while(true) {
+        double start = now();
+        b.run(d, n);
+        double elapsed = now() - start;
+        if(elapsed >= min_time || n >= (1ul << 30)) break;
+        // aim a little past min_time so that the next run is usually the last
+        double factor = elapsed > 0 ? 1.2 * min_time / elapsed : 10;
+        n = (unsigned long) (n * std::min(std::max(factor, 2.0), 10.0));
+    }
+
+    std::vector<double> times;
+    times.reserve(trials);
+    unsigned long allocs = alloc_count, bytes = alloc_bytes;
+    for(unsigned t = 0; t < trials; t++) {
+        double start = now();
+        b.run(d, n);
+        times.push_back((now() - start) / n * 1e9);
+    }
+    Result r;
+    r.allocs_per_op = double(alloc_count - allocs) / (n * trials);
+    r.bytes_per_op = double(alloc_bytes - bytes) / (n * trials);
+    std::sort(times.begin(), times.end());
+    r.iterations = n;
+    r.ns_per_op = times[times.size() / 2];
+    r.min_ns_per_op = times[0];
+    return r;
+}
+
+static void usage(char const *name) {
+    std::cerr << "Usage: " << name << " [options]\n\n"
+              << "  -f  --filter=TEXT      run only the benchmarks whose name contains TEXT\n"
+              << "  -t  --min-time=SECONDS shortest duration of one measured run (0.1)\n"
+              << "  -r  --trials=NUMBER    measured runs per benchmark (5)\n"
+              << "  -o  --output=FILE      write the JSON report to FILE instead of stdout\n"
+              << "  -l  --list             print the names of the benchmarks\n"
+              << "  -h  --help             print this help\n";
+}
+
+int main(int argc, char **argv) {
+    std::string filter, output;
+    double min_time = 0.1;
+    unsigned trials = 5;
+    unsigned count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    static struct option long_options[] = {
+        {"filter",   required_argument, 0, 'f'},
+        {"min-time", required_argument, 0, 't'},
+        {"trials",   required_argument, 0, 'r'},
+        {"output",   required_argument, 0, 'o'},
+        {"list",     no_argument,       0, 'l'},
+        {"help",     no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+    int c;
+    while((c = getopt_long(argc, argv, "f:t:r:o:lh", long_options, 0)) != -1) {
+        switch(c) {
+        case 'f':
+            filter = optarg;
+            break;
+        case 't':
+            min_time = std::atof(optarg);
+            break;
+        case 'r':
+            trials = std::max(1, std::atoi(optarg));
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'l':
+            for(unsigned i = 0; i < count; i++) std::cout << benchmarks[i].name << std::endl;
+            return 0;
+        case 'h':
+            usage(argv[0]);
+            return 0;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Data d;
+    make_data(d);
+
+    std::ostringstream json;
+    json.precision(6);
+    json << "{\n  \"library\": \"lib2geom\",\n  \"version\": \"" << LIB2GEOM_VERSION << "\",\n";
+#ifdef _OPENMP
+    json << "  \"threads\": " << omp_get_max_threads() << ",\n";
+#else
+    json << "  \"threads\": 1,\n";
+#endif
+    json << "  \"min_time\": " << min_time << ",\n  \"trials\": " << trials << ",\n"
+         << "  \"benchmarks\": [";
+    bool first = true;
+    for(unsigned i = 0; i < count; i++) {
+        Benchmark const &b = benchmarks[i];
+        if(!filter.empty() && std::strstr(b.name, filter.c_str()) == 0) continue;
+        std::cerr << b.name << "... " << std::flush;
+        Result r = measure(b, d, min_time, trials);
+        std::cerr << r.ns_per_op << " ns/op" << std::endl;
+
+        json << (first ? "\n" : ",\n") << "    {\"name\": \"" << b.name << "\""
+             << ", \"items_per_op\": " << b.items
+             << ", \"iterations\": " << r.iterations
+             << ", \"ns_per_op\": " << r.ns_per_op
+             << ", \"min_ns_per_op\": " << r.min_ns_per_op
+             << ", \"items_per_second\": " << b.items * 1e9 / r.ns_per_op
+             << ", \"allocs_per_op\": " << r.allocs_per_op
+             << ", \"allocs_per_item\": " << r.allocs_per_op / b.items
+             << ", \"bytes_per_op\": " << r.bytes_per_op << "}";
+        first = false;
+    }
+    json << "\n  ]\n}\n";
+
+    if(output.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream out(output.c_str());
+        out << json.str();
+        if(!out) {
+            std::cerr << "cannot write " << output << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,146 @@
+/*
+ * Timing of Bezier clipping one pair at a time, with a workspace and in batches
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/basic-intersection.h>
+#include <2geom/rect.h>
+#include "testing.h"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Geom;
+
+typedef std::vector<std::pair<double, double> > Times;
+typedef std::vector<std::pair<unsigned, unsigned> > Pairs;
+
+static Rect control_bounds(std::vector<Point> const &c) {
+    Rect r(c[0], c[0]);
+    for(unsigned i = 1; i < c.size(); i++) r.expandTo(c[i]);
+    return r;
+}
+
+/* Like the random scenes of the intersect-data toy: paths of chained Bezier curves
+ * of the given degree with control points spread over a 400 by 300 box. The pairs
+ * are the curves of different paths whose control polygons overlap. */
+static void scene(std::vector<std::vector<Point> > &curves, Pairs &pairs,
+                  unsigned paths, unsigned curves_per_path, unsigned degree) {
+    unsigned first = curves.size();
+    for(unsigned i = 0; i < paths; i++) {
+        Point p(uniform() * 400, 100 + uniform() * 300);
+        for(unsigned j = 0; j < curves_per_path; j++) {
+            std::vector<Point> c(1, p);
+            for(unsigned k = 0; k < degree; k++)
+                c.push_back(Point(uniform() * 400, 100 + uniform() * 300));
+            p = c.back();
+            curves.push_back(c);
+        }
+    }
+    for(unsigned i = first; i < curves.size(); i++) {
+        Rect bi = control_bounds(curves[i]);
+        for(unsigned j = i + 1; j < curves.size(); j++) {
+            if((i - first) / curves_per_path == (j - first) / curves_per_path) continue;
+            if(bi.intersects(control_bounds(curves[j]))) pairs.push_back(std::make_pair(i, j));
+        }
+    }
+}
+
+static void run(char const *name, std::vector<std::vector<Point> > const &curves,
+                Pairs const &pairs) {
+    unsigned long found = 0;
+    double start = wall_seconds();
+    for(unsigned i = 0; i < pairs.size(); i++) {
+        Times xs;
+        find_intersections_bezier_clipping(xs, curves[pairs[i].first], curves[pairs[i].second]);
+        found += xs.size();
+    }
+    double single = wall_seconds() - start;
+
+    BezierClippingWorkspace ws;
+    Times xs;
+    start = wall_seconds();
+    for(unsigned i = 0; i < pairs.size(); i++) {
+        find_intersections_bezier_clipping(xs, curves[pairs[i].first], curves[pairs[i].second], ws);
+    }
+    double reused = wall_seconds() - start;
+
+    std::vector<Times> all;
+    start = wall_seconds();
+    find_intersections_bezier_clipping(all, curves, pairs);
+    double batch = wall_seconds() - start;
+
+    std::cout << name << ": " << pairs.size() << " pairs, " << found << " crossings" << std::endl
+              << "  one at a time:  " << pairs.size() / single * 1e-3 << "k pairs/s" << std::endl
+              << "  workspace:      " << pairs.size() / reused * 1e-3 << "k pairs/s" << std::endl
+              << "  batch:          " << pairs.size() / batch * 1e-3 << "k pairs/s" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned n = argc > 1 ? std::atoi(argv[1]) : 20000;
+    std::srand(n);
+#ifdef _OPENMP
+    std::cout << omp_get_max_threads() << " threads" << std::endl;
+#endif
+
+    std::vector<std::vector<Point> > curves;
+    Pairs pairs;
+    for(unsigned i = 0; i < n; i++) {
+        for(unsigned j = 0; j < 2; j++) {
+            std::vector<Point> c;
+            for(unsigned k = 0; k < 4; k++) c.push_back(Point(uniform() * 100, uniform() * 100));
+            curves.push_back(c);
+        }
+        pairs.push_back(std::make_pair(2 * i, 2 * i + 1));
+    }
+    run("random cubic pairs", curves, pairs);
+
+    for(unsigned degree = 1; degree <= 3; degree++) {
+        curves.clear();
+        pairs.clear();
+        for(unsigned i = 0; pairs.size() < n; i++) scene(curves, pairs, 3, 5, degree);
+        char name[] = "intersect-data scenes of degree 0";
+        name[sizeof(name) - 2] += degree;
+        run(name, curves, pairs);
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
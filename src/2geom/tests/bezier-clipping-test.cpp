@@ -0,0 +1,167 @@
+/*
+ * Unit tests for Bezier clipping with a workspace and in batches
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <2geom/basic-intersection.h>
+#include <2geom/bezier-curve.h>
+#include <2geom/svg-elliptical-arc.h>
+#include <cstdlib>
+#include <vector>
+
+namespace Geom {
+
+typedef std::vector<std::pair<double, double> > Times;
+
+static std::vector<Point> random_bezier(unsigned degree)
+{
+    std::vector<Point> ret;
+    for (unsigned i = 0; i <= degree; ++i) {
+        ret.push_back(Point(uniform() * 100, uniform() * 100));
+    }
+    return ret;
+}
+
+static Point point_at(std::vector<Point> b, Coord t)
+{
+    for (unsigned n = b.size() - 1; n > 0; --n) {
+        for (unsigned i = 0; i < n; ++i) {
+            b[i] = lerp(t, b[i], b[i + 1]);
+        }
+    }
+    return b[0];
+}
+
+TEST(BezierClippingTest, Lines) {
+    std::vector<Point> a, b;
+    a.push_back(Point(0, 0));
+    a.push_back(Point(4, 4));
+    b.push_back(Point(0, 4));
+    b.push_back(Point(4, 0));
+    BezierClippingWorkspace ws;
+    Times xs;
+    find_intersections_bezier_clipping(xs, a, b, ws);
+    ASSERT_EQ(1u, xs.size());
+    EXPECT_NEAR(0.5, xs[0].first, 1e-5);
+    EXPECT_NEAR(0.5, xs[0].second, 1e-5);
+
+    // the workspace is reusable, and xs is overwritten
+    b[1] = Point(-4, 0);
+    find_intersections_bezier_clipping(xs, a, b, ws);
+    EXPECT_TRUE(xs.empty());
+}
+
+TEST(BezierClippingTest, WorkspaceAndBatchAgree) {
+    std::srand(19);
+    std::vector<std::vector<Point> > curves;
+    for (unsigned i = 0; i < 60; ++i) {
+        curves.push_back(random_bezier(1 + i % 4));
+    }
+    std::vector<std::pair<unsigned, unsigned> > pairs;
+    for (unsigned i = 0; i < curves.size(); ++i) {
+        for (unsigned j = i + 1; j < curves.size(); j += 3) {
+            pairs.push_back(std::make_pair(i, j));
+        }
+    }
+
+    std::vector<Times> batch;
+    find_intersections_bezier_clipping(batch, curves, pairs);
+    ASSERT_EQ(pairs.size(), batch.size());
+
+    BezierClippingWorkspace ws;
+    unsigned found = 0;
+    for (unsigned p = 0; p < pairs.size(); ++p) {
+        std::vector<Point> const &a = curves[pairs[p].first], &b = curves[pairs[p].second];
+        Times single, reused;
+        find_intersections_bezier_clipping(single, a, b);
+        find_intersections_bezier_clipping(reused, a, b, ws);
+        EXPECT_EQ(single, reused);
+        EXPECT_EQ(single, batch[p]);
+
+        // the times are found to 1e-5, and the curves are about 100 long
+        for (unsigned k = 0; k < single.size(); ++k) {
+            EXPECT_TRUE(are_near(point_at(a, single[k].first), point_at(b, single[k].second), 1e-2));
+        }
+        found += single.size();
+    }
+    EXPECT_GT(found, 100u);
+}
+
+TEST(BezierClippingTest, PolishIntersection) {
+    std::srand(7);
+    for (unsigned i = 0; i < 100; ++i) {
+        std::vector<Point> a = random_bezier(3);
+        CubicBezier A(a[0], a[1], a[2], a[3]);
+        // B passes through A(ta) at time 0.5
+        Coord ta = 0.1 + 0.8 * uniform();
+        Point p = A.pointAt(ta);
+        Point v(uniform() * 40 - 20, uniform() * 40 - 20), w(uniform() * 10, uniform() * 10);
+        CubicBezier B(p - v, p - v / 3 + w, p + v / 3 - w, p + v);
+        if (std::fabs(cross(A.pointAndDerivatives(ta, 1)[1], v)) < 1) continue; // nearly tangent
+
+        Coord s = ta + 1e-3, t = 0.5 - 1e-3;
+        polish_intersection(A, s, B, t);
+        EXPECT_NEAR(ta, s, 1e-12);
+        EXPECT_NEAR(0.5, t, 1e-12);
+
+        Times xs(1, std::make_pair(ta - 1e-3, 0.5 + 1e-3));
+        polish_intersections(xs, A.toSBasis(), B.toSBasis());
+        EXPECT_NEAR(ta, xs[0].first, 1e-12);
+        EXPECT_NEAR(0.5, xs[0].second, 1e-12);
+    }
+
+    // an arc against the horizontal line through its middle, which it crosses at time 0.5
+    SVGEllipticalArc arc(Point(0, 0), 20, 10, 0.3, false, true, Point(30, 10));
+    Point m = arc.pointAt(0.5);
+    LineSegment line(m - Point(20, 0), m + Point(20, 0));
+    Coord s = 0.52, t = 0.47;
+    polish_intersection(arc, s, line, t);
+    EXPECT_NEAR(0.5, s, 1e-12);
+    EXPECT_NEAR(0.5, t, 1e-12);
+
+    // the times stay in [0, 1]
+    s = 0.9;
+    t = 0.5;
+    polish_intersection(LineSegment(Point(0, 0), Point(1, 0)), s,
+                        LineSegment(Point(2, -1), Point(2, 1)), t);
+    EXPECT_EQ(1, s);
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
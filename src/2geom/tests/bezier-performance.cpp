@@ -0,0 +1,269 @@
+/*
+ * Timing of single and batch evaluation of Bezier curves,
+ * and heap allocations made by common operations on them
+ *//*
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/bezier-curve.h>
+#include <2geom/svg-elliptical-arc.h>
+#include <2geom/sbasis-geometric.h>
+#include "testing.h"
+#include <iostream>
+#include <vector>
+#include <new>
+#include <cstdlib>
+#include <ctime>
+
+using namespace Geom;
+
+static unsigned long allocations = 0;
+
+void *operator new(std::size_t n) {
+    ++allocations;
+    void *p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) throw() {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) throw() {
+    std::free(p);
+}
+
+static void report(char const *name, double start, double samples, double check) {
+    double elapsed = seconds() - start;
+    std::cout << "  " << name << ": " << samples / elapsed / 1e6 << " Msamples/s"
+              << " (" << check << ")" << std::endl;
+}
+
+static void time_curve(char const *name, Curve const &c, std::vector<Coord> const &ts, unsigned reps) {
+    size_t n = ts.size();
+    double samples = (double) n * reps;
+    std::vector<Point> ps(n);
+    std::vector<Coord> vs(n);
+    std::cout << name << std::endl;
+
+    double start = seconds();
+    double check = 0;
+    for(unsigned r = 0; r < reps; r++) {
+        for(size_t i = 0; i < n; i++) {
+            ps[i] = c.pointAt(ts[i]);
+        }
+        check += ps[r % n][X];
+    }
+    report("pointAt", start, samples, check);
+
+    start = seconds();
+    check = 0;
+    for(unsigned r = 0; r < reps; r++) {
+        c.pointsAt(&ts[0], &ps[0], n);
+        check += ps[r % n][X];
+    }
+    report("pointsAt", start, samples, check);
+
+    start = seconds();
+    check = 0;
+    for(unsigned r = 0; r < reps; r++) {
+        for(size_t i = 0; i < n; i++) {
+            vs[i] = c.valueAt(ts[i], Y);
+        }
+        check += vs[r % n];
+    }
+    report("valueAt", start, samples, check);
+
+    start = seconds();
+    check = 0;
+    for(unsigned r = 0; r < reps; r++) {
+        c.valuesAt(&ts[0], &vs[0], n, Y);
+        check += vs[r % n];
+    }
+    report("valuesAt", start, samples, check);
+}
+
+/* Compares the nearest points found through SBasis, natively and in one batch,
+ * and reports the largest difference in distance between the first two. */
+static void time_nearest(char const *name, Curve const &c, std::vector<Point> const &ps,
+                         unsigned reps) {
+    size_t n = ps.size();
+    double queries = (double) n * reps;
+    std::vector<Coord> generic(n), native(n);
+    std::cout << name << " nearest points" << std::endl;
+
+    double start = seconds();
+    for(unsigned r = 0; r < reps; r++) {
+        for(size_t i = 0; i < n; i++) {
+            generic[i] = c.Curve::nearestPoint(ps[i]);
+        }
+    }
+    report("through SBasis", start, queries, generic[reps % n]);
+
+    start = seconds();
+    for(unsigned r = 0; r < reps; r++) {
+        for(size_t i = 0; i < n; i++) {
+            native[i] = c.nearestPoint(ps[i]);
+        }
+    }
+    report("nearestPoint", start, queries, native[reps % n]);
+
+    start = seconds();
+    for(unsigned r = 0; r < reps; r++) {
+        c.nearestPoints(&ps[0], &native[0], n);
+    }
+    report("nearestPoints", start, queries, native[reps % n]);
+
+    Coord worst = 0;
+    for(size_t i = 0; i < n; i++) {
+        worst = std::max(worst, distance(ps[i], c.pointAt(native[i]))
+                                - distance(ps[i], c.pointAt(generic[i])));
+    }
+    std::cout << "  largest excess distance: " << worst << std::endl;
+}
+
+static Coord sink = 0;
+
+struct Workload {
+    CubicBezier c;
+    Bezier x, y;
+    SVGEllipticalArc arc;
+    Workload()
+        : c(Point(0, 0), Point(30, 100), Point(70, -100), Point(100, 0))
+        , x(0, 30, 70, 100)
+        , y(0, 100, -100, 0)
+        , arc(Point(0, 0), 60, 20, 0.3, true, false, Point(100, 0))
+    {}
+};
+
+static void count(char const *name, unsigned reps, void (*op)(Workload const &)) {
+    Workload w;
+    // fill static tables such as the one used by choose()
+    op(w);
+    unsigned long before = allocations;
+    double start = seconds();
+    for(unsigned r = 0; r < reps; r++) {
+        op(w);
+    }
+    double elapsed = seconds() - start;
+    std::cout << "  " << name << ": " << (allocations - before) / (double) reps
+              << " allocations, " << elapsed / reps * 1e9 << "ns" << std::endl;
+}
+
+static void op_copy(Workload const &w) {
+    CubicBezier d(w.c);
+    sink += d.finalPoint()[X];
+}
+static void op_subdivide(Workload const &w) {
+    std::pair<CubicBezier, CubicBezier> s = w.c.subdivide(0.3);
+    sink += s.first.finalPoint()[X];
+}
+static void op_portion(Workload const &w) {
+    Bezier b = portion(w.x, 0.2, 0.7);
+    sink += b[1];
+}
+static void op_derivative(Workload const &w) {
+    Bezier b = derivative(w.x);
+    sink += b[1];
+}
+static void op_multiply(Workload const &w) {
+    Bezier b = multiply(w.x, w.y);
+    sink += b[3];
+}
+static void op_arithmetic(Workload const &w) {
+    Bezier b = reverse(w.x * 2 + 1);
+    sink += b[1];
+}
+static void op_bounds_fast(Workload const &w) {
+    sink += w.c.boundsFast().width();
+}
+static void op_point_at(Workload const &w) {
+    sink += w.c.pointAt(0.4)[Y];
+}
+static void op_length(Workload const &w) {
+    sink += w.c.length(0.01);
+}
+static void op_length_sbasis(Workload const &w) {
+    sink += length(w.c.toSBasis(), 0.01);
+}
+static void op_arc_length(Workload const &w) {
+    sink += w.arc.length(0.01);
+}
+static void op_arc_length_sbasis(Workload const &w) {
+    sink += length(w.arc.toSBasis(), 0.01);
+}
+
+int main(int argc, char **argv) {
+    unsigned reps = argc > 1 ? std::atoi(argv[1]) : 20000;
+    // a typical number of samples for flattening one segment
+    std::vector<Coord> ts(256);
+    for(size_t i = 0; i < ts.size(); i++) {
+        ts[i] = i / (ts.size() - 1.0);
+    }
+
+    LineSegment line(Point(0, 0), Point(100, 50));
+    QuadraticBezier quad(Point(0, 0), Point(50, 100), Point(100, 0));
+    CubicBezier cubic(Point(0, 0), Point(30, 100), Point(70, -100), Point(100, 0));
+    time_curve("line", line, ts, reps);
+    time_curve("quadratic", quad, ts, reps);
+    time_curve("cubic", cubic, ts, reps);
+
+    std::vector<Point> ps;
+    std::srand(0);
+    for(size_t i = 0; i < 1000; i++) {
+        ps.push_back(Point(std::rand() % 140 - 20, std::rand() % 140 - 70));
+    }
+    time_nearest("quadratic", quad, ps, reps / 1000 + 1);
+    time_nearest("cubic", cubic, ps, reps / 1000 + 1);
+
+    std::cout << "cubic operations" << std::endl;
+    unsigned ops = reps * 50;
+    count("copy", ops, op_copy);
+    count("subdivide", ops, op_subdivide);
+    count("portion", ops, op_portion);
+    count("derivative", ops, op_derivative);
+    count("multiply", ops, op_multiply);
+    count("scale, offset and reverse", ops, op_arithmetic);
+    count("boundsFast", ops, op_bounds_fast);
+    count("pointAt", ops, op_point_at);
+    count("length", ops / 10, op_length);
+    count("length through SBasis", ops / 10, op_length_sbasis);
+    count("elliptical arc length", ops / 10, op_arc_length);
+    count("elliptical arc length through SBasis", ops / 10, op_arc_length_sbasis);
+    std::cout << "(" << sink << ")" << std::endl;
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -2,6 +2,9 @@
 #include <iostream>
 
 #include <2geom/bezier.h>
+#include <2geom/bezier-curve.h>
+#include <2geom/sbasis-curve.h>
+#include <2geom/svg-elliptical-arc.h>
 #include <2geom/poly.h>
 #include <vector>
 #include <iterator>
@@ -295,6 +298,223 @@ TEST_F(BezierTest,Operators) {
     }
 }
 
+TEST_F(BezierTest, CoefficientStorage) {
+    // orders up to 7 are stored inline, higher ones on the heap
+    Bezier high = wiggle.elevate_to_degree(10);
+    EXPECT_EQ(11u, high.size());
+    EXPECT_TRUE(are_equal(high, wiggle));
+
+    Bezier b = hump;
+    b = high;
+    EXPECT_TRUE(are_equal(b, wiggle));
+    b[5] += 1;
+    EXPECT_NE(b[5], high[5]);
+    b = unit;
+    EXPECT_EQ(2u, b.size());
+    EXPECT_TRUE(are_equal(b, unit));
+
+    Bezier bs[] = {wiggle, wiggle.elevate_to_degree(7), high};
+    for(unsigned i = 0; i < sizeof(bs)/sizeof(Bezier); i++) {
+        std::pair<Bezier, Bezier> parts = bs[i].subdivide(0.25);
+        Bezier mid = portion(bs[i], 0.25, 0.75);
+        for(int j = 0; j <= 8; j++) {
+            double t = j/8.0;
+            EXPECT_NEAR(bs[i].valueAt(t/4), parts.first.valueAt(t), 1e-12);
+            EXPECT_NEAR(bs[i].valueAt(0.25 + 0.75*t), parts.second.valueAt(t), 1e-12);
+            EXPECT_NEAR(bs[i].valueAt(0.25 + 0.5*t), mid.valueAt(t), 1e-12);
+        }
+        EXPECT_TRUE(are_equal(derivative(bs[i]), derivative(wiggle)));
+    }
+
+    b.resize(12, 2);
+    EXPECT_EQ(12u, b.size());
+    EXPECT_TRUE(b.isConstant());
+    EXPECT_EQ(2, b[11]);
+}
+
+TEST_F(BezierTest, BatchEvaluation) {
+    // an odd count exercises the tail of the vectorized loops
+    std::vector<double> ts;
+    for(int i = 0; i <= 21; i++) {
+        ts.push_back(i/21.0);
+    }
+    ts.push_back(0.5);
+
+    LineSegment line(Point(1, 2), Point(-3, 7));
+    QuadraticBezier quad(Point(0, 0), Point(5, 10), Point(-2, 1));
+    CubicBezier cubic(Point(0.5, -1), Point(2, 8), Point(-4, 3), Point(7, 7));
+    std::vector<Point> pts;
+    pts.push_back(Point(0, 0)); pts.push_back(Point(1, 3)); pts.push_back(Point(2, -1));
+    pts.push_back(Point(3, 4)); pts.push_back(Point(4, 0));
+    Curve *quartic = BezierCurve::create(pts);
+    SBasisCurve sbcurve(cubic.toSBasis());
+    Curve const *curves[] = {&line, &quad, &cubic, quartic, &sbcurve};
+
+    for(unsigned c = 0; c < sizeof(curves)/sizeof(Curve*); c++) {
+        Curve const &curve = *curves[c];
+        std::vector<Point> points(ts.size());
+        std::vector<double> xs(ts.size()), ys(ts.size());
+        curve.pointsAt(&ts[0], &points[0], ts.size());
+        curve.valuesAt(&ts[0], &xs[0], ts.size(), X);
+        curve.valuesAt(&ts[0], &ys[0], ts.size(), Y);
+        for(unsigned i = 0; i < ts.size(); i++) {
+            Point p = curve.pointAt(ts[i]);
+            EXPECT_NEAR(p[X], points[i][X], 1e-12);
+            EXPECT_NEAR(p[Y], points[i][Y], 1e-12);
+            EXPECT_NEAR(p[X], xs[i], 1e-12);
+            EXPECT_NEAR(p[Y], ys[i], 1e-12);
+        }
+        // the endpoints are exact
+        EXPECT_EQ(curve.initialPoint(), points.front());
+        EXPECT_EQ(curve.finalPoint(), points[ts.size()-2]);
+        EXPECT_EQ(curve.initialPoint()[X], xs.front());
+        EXPECT_EQ(curve.finalPoint()[Y], ys[ts.size()-2]);
+    }
+    delete quartic;
+}
+
+TEST_F(BezierTest, PointAndDerivative) {
+    LineSegment line(Point(1, 2), Point(-3, 7));
+    QuadraticBezier quad(Point(0, 0), Point(5, 10), Point(-2, 1));
+    CubicBezier cubic(Point(0.5, -1), Point(2, 8), Point(-4, 3), Point(7, 7));
+    std::vector<Point> pts;
+    pts.push_back(Point(0, 0)); pts.push_back(Point(1, 3)); pts.push_back(Point(2, -1));
+    pts.push_back(Point(3, 4)); pts.push_back(Point(4, 0));
+    Curve *quartic = BezierCurve::create(pts);
+    SBasisCurve sbcurve(cubic.toSBasis());
+    SVGEllipticalArc arc(Point(0, 0), 20, 10, 0.3, true, false, Point(30, 10));
+    SVGEllipticalArc flat(Point(0, 0), 0, 10, 0.3, true, false, Point(30, 10));
+    Curve const *curves[] = {&line, &quad, &cubic, quartic, &sbcurve, &arc, &flat};
+
+    for(unsigned c = 0; c < sizeof(curves)/sizeof(Curve*); c++) {
+        for(int i = 0; i <= 10; i++) {
+            double t = i / 10.0;
+            std::vector<Point> expected = curves[c]->pointAndDerivatives(t, 1);
+            Point d;
+            Point p = curves[c]->pointAndDerivative(t, d);
+            EXPECT_NEAR(expected[0][X], p[X], 1e-12);
+            EXPECT_NEAR(expected[0][Y], p[Y], 1e-12);
+            EXPECT_NEAR(expected[1][X], d[X], 1e-11);
+            EXPECT_NEAR(expected[1][Y], d[Y], 1e-11);
+        }
+    }
+    delete quartic;
+
+    double der;
+    EXPECT_EQ(wiggle.valueAt(0.3), wiggle.valueAndDerivative(0.3, der));
+    EXPECT_NEAR(derivative(wiggle).valueAt(0.3), der, 1e-12);
+    Bezier constant(Bezier::Order(0));
+    constant[0] = 2;
+    EXPECT_EQ(2, constant.valueAndDerivative(0.3, der));
+    EXPECT_EQ(0, der);
+}
+
+TEST_F(BezierTest, NearestPoint) {
+    QuadraticBezier quad(Point(0, 0), Point(5, 10), Point(-2, 1));
+    CubicBezier cubic(Point(0.5, -1), Point(2, 8), Point(-4, 3), Point(7, 7));
+    // a loop, which has several local minima for points inside it
+    CubicBezier loop(Point(0, 0), Point(10, 10), Point(0, 10), Point(10, 0));
+    Curve const *curves[] = {&quad, &cubic, &loop};
+
+    std::vector<Point> ps;
+    for(int i = 0; i <= 12; i++) {
+        for(int j = 0; j <= 12; j++) {
+            ps.push_back(Point(i - 2.3, j - 1.9));
+        }
+    }
+    for(unsigned c = 0; c < sizeof(curves)/sizeof(Curve*); c++) {
+        Curve const &curve = *curves[c];
+        std::vector<double> batch(ps.size()), part(ps.size());
+        curve.nearestPoints(&ps[0], &batch[0], ps.size());
+        curve.nearestPoints(&ps[0], &part[0], ps.size(), 0.25, 0.6);
+        for(unsigned i = 0; i < ps.size(); i++) {
+            double t = curve.nearestPoint(ps[i]);
+            EXPECT_EQ(t, batch[i]);
+            // no farther than the nearest point found through SBasis or by sampling
+            double d = distance(ps[i], curve.pointAt(t));
+            EXPECT_LE(d, distance(ps[i], curve.pointAt(curve.Curve::nearestPoint(ps[i]))) + 1e-9);
+            for(int k = 0; k <= 200; k++) {
+                EXPECT_LE(d, distance(ps[i], curve.pointAt(k / 200.)) + 1e-9);
+            }
+            EXPECT_GE(part[i], 0.25);
+            EXPECT_LE(part[i], 0.6);
+            double g = curve.Curve::nearestPoint(ps[i], 0.25, 0.6);
+            EXPECT_NEAR(distance(ps[i], curve.pointAt(g)),
+                        distance(ps[i], curve.pointAt(part[i])), 1e-9);
+        }
+    }
+
+    EXPECT_EQ(0, cubic.nearestPoint(cubic.initialPoint()));
+    EXPECT_EQ(1, cubic.nearestPoint(cubic.finalPoint()));
+    EXPECT_EQ(0.6, cubic.nearestPoint(cubic.finalPoint(), 0.6, 0.25));
+    CubicBezier dot(Point(1, 1), Point(1, 1), Point(1, 1), Point(1, 1));
+    EXPECT_EQ(0.5, dot.nearestPoint(Point(3, 2), 0.5, 1));
+    EXPECT_THROW(cubic.nearestPoint(Point(0, 0), 0, 2), RangeError);
+}
+
+// one coordinate of a curve, as a Bezier whose order is only known at runtime
+Bezier coordinate(BezierCurve const &c, Dim2 d) {
+    Bezier b(Bezier::Order(c.order()));
+    for(unsigned i = 0; i <= c.order(); i++) {
+        b[i] = c[i][d];
+    }
+    return b;
+}
+
+template <unsigned degree>
+void check_kernels(BezierCurveN<degree> const &c) {
+    std::pair<BezierCurveN<degree>, BezierCurveN<degree> > halves = c.subdivide(0.3);
+    Curve *part = c.portion(0.2, 0.7);
+    EXPECT_EQ(halves.first.finalPoint(), halves.second.initialPoint());
+    EXPECT_EQ(c.initialPoint(), c.pointAt(0));
+    EXPECT_EQ(c.finalPoint(), c.pointAt(1));
+
+    for(unsigned d = 0; d < 2; d++) {
+        // the general loops are the reference
+        Bezier b = coordinate(c, Dim2(d));
+        Bezier der = derivative(b), up = b.elevate_degree();
+        Bezier left = coordinate(halves.first, Dim2(d)), right = coordinate(halves.second, Dim2(d));
+        Interval sampled(b.at0(), b.at1());
+        for(int i = 0; i <= 2000; i++) {
+            double t = i / 2000.0;
+            double v = bernsteinValueAt(t, &b[0], degree);
+            sampled.expandTo(v);
+            if (i % 100) continue;
+            EXPECT_NEAR(v, c.pointAt(t)[d], 1e-12);
+            EXPECT_NEAR(v, c.valueAt(t, Dim2(d)), 1e-12);
+            EXPECT_NEAR(v, b.valueAt(t), 1e-12);
+            EXPECT_NEAR(v, up.valueAt(t), 1e-12);
+            EXPECT_NEAR(bernsteinValueAt(0.3 * t, &b[0], degree), left.valueAt(t), 1e-12);
+            EXPECT_NEAR(bernsteinValueAt(0.3 + 0.7 * t, &b[0], degree), right.valueAt(t), 1e-12);
+            EXPECT_NEAR(bernsteinValueAt(0.2 + 0.5 * t, &b[0], degree),
+                        part->valueAt(t, Dim2(d)), 1e-12);
+            double dv;
+            b.valueAndDerivative(t, dv);
+            EXPECT_NEAR(dv, der.valueAt(t), 1e-12);
+        }
+        Interval bounds = c.boundsExact()[d];
+        EXPECT_EQ(bounds, *bounds_exact(b));
+        EXPECT_NEAR(sampled.min(), bounds.min(), 1e-3);
+        EXPECT_NEAR(sampled.max(), bounds.max(), 1e-3);
+        EXPECT_LE(bounds.min(), sampled.min() + 1e-12);
+        EXPECT_GE(bounds.max(), sampled.max() - 1e-12);
+        EXPECT_NEAR(bounds_exact(b.toSBasis())->min(), bounds.min(), 1e-9);
+        EXPECT_NEAR(bounds_exact(b.toSBasis())->max(), bounds.max(), 1e-9);
+    }
+    delete part;
+}
+
+TEST_F(BezierTest, CompileTimeKernels) {
+    check_kernels(LineSegment(Point(1, 2), Point(-3, 7)));
+    check_kernels(QuadraticBezier(Point(0, 0), Point(5, 10), Point(-2, 1)));
+    // the middle point within the ends, so that the hull is the range
+    check_kernels(QuadraticBezier(Point(0, 0), Point(1, 1), Point(3, 3)));
+    check_kernels(CubicBezier(Point(0.5, -1), Point(2, 8), Point(-4, 3), Point(7, 7)));
+    check_kernels(CubicBezier(Point(0, 0), Point(10, 10), Point(0, 10), Point(10, 0)));
+    // evenly spaced coordinates have a constant derivative
+    check_kernels(CubicBezier(Point(0, 0), Point(1, 5), Point(2, -5), Point(3, 0)));
+}
+
 }  // namespace
 
 int main(int argc, char **argv) {
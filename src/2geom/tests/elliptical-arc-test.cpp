@@ -0,0 +1,206 @@
+/*
+ * Unit tests for the native methods of EllipticalArc
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <2geom/svg-elliptical-arc.h>
+#include <2geom/path.h>
+#include <2geom/path-intersection.h>
+#include <2geom/transforms.h>
+#include <algorithm>
+#include <vector>
+
+namespace Geom {
+
+// arcs in both directions, smaller and larger than half an ellipse, and nearly full
+static std::vector<SVGEllipticalArc> some_arcs()
+{
+    std::vector<SVGEllipticalArc> arcs;
+    arcs.push_back(SVGEllipticalArc(Point(0, 0), 20, 10, 0.3, false, true, Point(30, 10)));
+    arcs.push_back(SVGEllipticalArc(Point(0, 0), 20, 10, 0.3, true, true, Point(30, 10)));
+    arcs.push_back(SVGEllipticalArc(Point(0, 0), 20, 10, 0.3, false, false, Point(30, 10)));
+    arcs.push_back(SVGEllipticalArc(Point(0, 0), 20, 10, 0.3, true, false, Point(30, 10)));
+    arcs.push_back(SVGEllipticalArc(Point(5, -3), 40, 25, 2.1, true, true, Point(5.5, -2)));
+    arcs.push_back(SVGEllipticalArc(Point(1, 2), 15, 15, 0, false, false, Point(-20, 9)));
+    return arcs;
+}
+
+// the transform from the rays, rotation and center, as it was computed on every call
+static Affine expected_transform(EllipticalArc const &arc)
+{
+    Affine m = Scale(arc.ray(X), arc.ray(Y)) * Rotate(arc.rotationAngle());
+    m.setTranslation(arc.center());
+    return m;
+}
+
+TEST(EllipticalArcTest, UnitCircleTransform) {
+    std::vector<SVGEllipticalArc> arcs = some_arcs();
+    for (unsigned i = 0; i < arcs.size(); ++i) {
+        EXPECT_TRUE(are_near(expected_transform(arcs[i]), arcs[i].unitCircleTransform(), 1e-12));
+
+        // every way of making a new arc must leave the transform up to date
+        Curve *made[] = {
+            arcs[i].portion(0.2, 0.7),
+            arcs[i].portion(0.4, 0.4),
+            arcs[i].reverse(),
+            arcs[i].derivative(),
+            arcs[i].transformed(Rotate(0.5) * Translate(3, 4))
+        };
+        for (unsigned k = 0; k < 5; ++k) {
+            EllipticalArc const *arc = dynamic_cast<EllipticalArc const *>(made[k]);
+            EXPECT_TRUE(arc != NULL);
+            if (arc) {
+                EXPECT_TRUE(are_near(expected_transform(*arc), arc->unitCircleTransform(), 1e-9));
+            }
+            delete made[k];
+        }
+
+        EllipticalArc moved = arcs[i];
+        moved.setExtremes(Point(-3, 1), Point(12, 7));
+        EXPECT_TRUE(are_near(expected_transform(moved), moved.unitCircleTransform(), 1e-12));
+    }
+}
+
+TEST(EllipticalArcTest, DerivativeInTime) {
+    // derivatives are taken with respect to the curve time, not the angle
+    std::vector<SVGEllipticalArc> arcs = some_arcs();
+    Coord const h = 1e-6;
+    for (unsigned i = 0; i < arcs.size(); ++i) {
+        Curve *d = arcs[i].derivative();
+        for (unsigned k = 1; k < 10; ++k) {
+            Coord t = k / 10.0;
+            Point fd = (arcs[i].pointAt(t + h) - arcs[i].pointAt(t - h)) / (2 * h);
+            Coord tol = 1e-5 * L2(fd);
+            EXPECT_TRUE(are_near(fd, d->pointAt(t), tol)) << "arc " << i << " at " << t;
+            std::vector<Point> pd = arcs[i].pointAndDerivatives(t, 1);
+            EXPECT_TRUE(are_near(arcs[i].pointAt(t), pd[0], 1e-9)) << "arc " << i << " at " << t;
+            EXPECT_TRUE(are_near(fd, pd[1], tol)) << "arc " << i << " at " << t;
+        }
+        delete d;
+    }
+}
+
+TEST(EllipticalArcTest, BoundsLocal) {
+    std::vector<SVGEllipticalArc> arcs = some_arcs();
+    Interval parts[] = { Interval(0, 1), Interval(0.1, 0.35), Interval(0.3, 0.9),
+                         Interval(0.5, 0.5), Interval(0, 0.6) };
+    for (unsigned i = 0; i < arcs.size(); ++i) {
+        Curve const &arc = arcs[i];
+        for (unsigned k = 0; k < 5; ++k) {
+            Interval const &part = parts[k];
+            OptRect bounds = arc.boundsLocal(part);
+            ASSERT_FALSE(bounds.isEmpty());
+            Rect loose = *bounds;
+            loose.expandBy(1e-9);
+
+            // tight around the points of the part
+            Rect sampled(arc.pointAt(part.min()), arc.pointAt(part.max()));
+            for (unsigned s = 0; s <= 2000; ++s) {
+                Point p = arc.pointAt(lerp(s / 2000., part.min(), part.max()));
+                EXPECT_TRUE(loose.contains(p));
+                sampled.expandTo(p);
+            }
+            for (unsigned c = 0; c < 4; ++c) {
+                EXPECT_NEAR(sampled.corner(c)[X], bounds->corner(c)[X], 1e-3);
+                EXPECT_NEAR(sampled.corner(c)[Y], bounds->corner(c)[Y], 1e-3);
+            }
+
+            // derivatives of the first order
+            OptRect dbounds = arc.boundsLocal(part, 1);
+            ASSERT_FALSE(dbounds.isEmpty());
+            dbounds->expandBy(1e-9);
+            for (unsigned s = 0; s <= 200; ++s) {
+                Point d;
+                arc.pointAndDerivative(lerp(s / 200., part.min(), part.max()), d);
+                EXPECT_TRUE(dbounds->contains(d));
+            }
+        }
+        EXPECT_TRUE(arc.boundsLocal(OptInterval()).isEmpty());
+    }
+}
+
+static Coord polyline_distance(std::vector<Point> const &pts, Point const &p)
+{
+    Coord ret = distance(pts[0], p);
+    for (unsigned i = 1; i < pts.size(); ++i) {
+        ret = std::min(ret, distance(pts[i], p));
+    }
+    return ret;
+}
+
+TEST(EllipticalArcTest, Winding) {
+    std::vector<SVGEllipticalArc> arcs = some_arcs();
+    for (unsigned i = 0; i < arcs.size(); ++i) {
+        std::vector<Point> pts;
+        for (unsigned s = 0; s <= 4000; ++s) {
+            pts.push_back(arcs[i].pointAt(s / 4000.));
+        }
+        Rect box = arcs[i].boundsExact();
+        box.expandBy(5);
+        for (unsigned gx = 0; gx <= 30; ++gx) {
+            for (unsigned gy = 0; gy <= 30; ++gy) {
+                Point p(lerp(gx / 30., box.left(), box.right()), lerp(gy / 30., box.top(), box.bottom()));
+                // away from the curve, where the polyline might go to the other side
+                if (polyline_distance(pts, p) < 0.1) continue;
+                EXPECT_EQ(polyline_winding(pts, p), arcs[i].winding(p)) << i << " " << p;
+            }
+        }
+    }
+
+    // a circle made of two arcs, in both directions
+    for (unsigned dir = 0; dir < 2; ++dir) {
+        Path circle(Point(10, 0));
+        circle.appendNew<SVGEllipticalArc>(10, 10, 0, false, dir, Point(-10, 0));
+        circle.appendNew<SVGEllipticalArc>(10, 10, 0, false, dir, Point(10, 0));
+        circle.close();
+        int inside = dir ? 1 : -1;
+        EXPECT_EQ(inside, Geom::winding(circle, Point(0, 1)));
+        EXPECT_EQ(inside, Geom::winding(circle, Point(3, 4)));
+        EXPECT_EQ(inside, Geom::winding(circle, Point(-7, -7)));
+        EXPECT_EQ(0, Geom::winding(circle, Point(8, 8)));
+        EXPECT_EQ(0, Geom::winding(circle, Point(-11, 0.5)));
+    }
+
+    // a flat SVG arc is its chord
+    SVGEllipticalArc flat(Point(0, 0), 0, 10, 0.3, true, false, Point(30, 10));
+    EXPECT_EQ(flat.chord().winding(Point(10, 5)), flat.winding(Point(10, 5)));
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
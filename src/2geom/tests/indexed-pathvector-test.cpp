@@ -0,0 +1,155 @@
+/*
+ * Unit tests for IndexedPathVector
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <gtest/gtest.h>
+#include <2geom/indexed-pathvector.h>
+#include <2geom/path-intersection.h>
+#include <2geom/bezier-curve.h>
+#include <cstdlib>
+
+namespace Geom {
+
+class IndexedPathVectorTest : public ::testing::Test {
+protected:
+    IndexedPathVectorTest() {
+        std::srand(1);
+        // blobs of mixed lines and cubics, some of them left open
+        for (unsigned i = 0; i < 40; ++i) {
+            Point c = random_point(1000);
+            Path path(c + random_point(50));
+            unsigned n = 3 + std::rand() % 20;
+            for (unsigned j = 0; j < n; ++j) {
+                Point next = c + random_point(50);
+                if (std::rand() % 2) {
+                    path.appendNew<LineSegment>(next);
+                } else {
+                    path.appendNew<CubicBezier>(c + random_point(50), c + random_point(50), next);
+                }
+            }
+            path.close(i % 4 != 0);
+            pv.push_back(path);
+        }
+        pv.push_back(Path(Point(500, 500)));
+    }
+
+    static Point random_point(Coord range) {
+        return Point(std::rand() / (RAND_MAX + 1.0) * range,
+                     std::rand() / (RAND_MAX + 1.0) * range);
+    }
+
+    PathVector pv;
+};
+
+TEST_F(IndexedPathVectorTest, NearestPoint) {
+    IndexedPathVector index(pv);
+    for (unsigned i = 0; i < 200; ++i) {
+        Point p = random_point(1200) - Point(100, 100);
+        double dsq, expected_dsq;
+        boost::optional<PathVectorPosition> pos = index.nearestPoint(p, &dsq);
+        boost::optional<PathVectorPosition> expected = nearestPoint(pv, p, &expected_dsq);
+        ASSERT_TRUE(pos != boost::none && expected != boost::none);
+        EXPECT_DOUBLE_EQ(dsq, expected_dsq);
+        EXPECT_EQ(pos->path_nr, expected->path_nr);
+        EXPECT_DOUBLE_EQ(pos->t, expected->t);
+
+        double all_dsq;
+        std::vector<PathVectorPosition> all = index.allNearestPoints(p, &all_dsq);
+        EXPECT_NEAR(all_dsq, dsq, 1e-6 * (1 + dsq));
+        ASSERT_FALSE(all.empty());
+        EXPECT_NEAR(distanceSq(p, pointAt(pv, all.front())), dsq, 1e-6 * (1 + dsq));
+    }
+
+    // the naked moveto can still be snapped to
+    double dsq;
+    index.nearestPoint(Point(500, 500), &dsq);
+    EXPECT_EQ(dsq, 0);
+}
+
+/* Reference winding number from a finely sampled polygon of every path,
+ * including the closing segment of open paths. */
+static int polygon_winding(std::vector<Point> const &poly, Point const &p)
+{
+    int wind = 0;
+    for (unsigned i = 0; i + 1 < poly.size(); ++i) {
+        Point a = poly[i], b = poly[i + 1];
+        bool a_above = a[Y] > p[Y], b_above = b[Y] > p[Y];
+        if (a_above == b_above) continue;
+        Coord x = a[X] + (p[Y] - a[Y]) / (b[Y] - a[Y]) * (b[X] - a[X]);
+        if (x > p[X]) wind += b_above ? 1 : -1;
+    }
+    return wind;
+}
+
+TEST_F(IndexedPathVectorTest, Winding) {
+    IndexedPathVector index(pv);
+    std::vector<std::vector<Point> > polys;
+    for (unsigned i = 0; i < pv.size(); ++i) {
+        std::vector<Point> poly;
+        for (unsigned j = 0; j < pv[i].size_closed(); ++j) {
+            for (unsigned k = 0; k < 500; ++k) {
+                poly.push_back(pv[i][j].pointAt(k / 500.));
+            }
+        }
+        poly.push_back(pv[i].initialPoint());
+        polys.push_back(poly);
+    }
+
+    for (unsigned i = 0; i < 500; ++i) {
+        Point p = random_point(1100) - Point(50, 50);
+        int expected = 0;
+        for (unsigned j = 0; j < polys.size(); ++j) {
+            expected += polygon_winding(polys[j], p);
+        }
+        EXPECT_EQ(index.winding(p), expected) << p;
+        EXPECT_EQ(index.contains(p, false), expected != 0);
+    }
+}
+
+TEST_F(IndexedPathVectorTest, Empty) {
+    IndexedPathVector index;
+    double dsq;
+    EXPECT_FALSE(index.nearestPoint(Point(1, 1), &dsq) != boost::none);
+    EXPECT_TRUE(index.allNearestPoints(Point(1, 1)).empty());
+    EXPECT_EQ(index.winding(Point(1, 1)), 0);
+    EXPECT_FALSE(index.contains(Point(1, 1)));
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
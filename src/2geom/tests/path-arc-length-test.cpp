@@ -0,0 +1,128 @@
+/*
+ * Unit tests for PathArcLengthIndex
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <gtest/gtest.h>
+#include <2geom/path-arc-length.h>
+#include <2geom/svg-path-parser.h>
+
+namespace Geom {
+
+// length from the start of the path to the path time t, measured curve by curve
+static Coord length_to(Path const &p, Coord t)
+{
+    Coord ret = 0;
+    unsigned i = 0;
+    for (; i + 1 <= t && i < p.size_default(); ++i) {
+        ret += p[i].length(1e-10);
+    }
+    if (i < p.size_default() && t > i) {
+        Curve *part = p[i].portion(0, t - i);
+        ret += part->length(1e-10);
+        delete part;
+    }
+    return ret;
+}
+
+TEST(PathArcLengthIndexTest, Square) {
+    PathArcLengthIndex index(parse_svg_path("M 0,0 1,0 1,1 0,1 z")[0]);
+    EXPECT_DOUBLE_EQ(4, index.length());
+    EXPECT_NEAR(2.5, index.timeAtLength(2.5), 1e-9);
+    EXPECT_NEAR(0, distance(Point(0.5, 1), index.pointAtLength(2.5)), 1e-9);
+    EXPECT_EQ(Point(-1, 0), index.unitTangentAtLength(2.5));
+    EXPECT_NEAR(1.25, index.lengthAtTime(1.25), 1e-9);
+
+    // lengths outside of the path are clamped
+    EXPECT_EQ(0, index.timeAtLength(-1));
+    EXPECT_EQ(4, index.timeAtLength(5));
+    EXPECT_EQ(Point(0, 0), index.pointAtLength(5));
+}
+
+TEST(PathArcLengthIndexTest, MixedCurves) {
+    // a cusp, a counter-clockwise arc and the closing segment
+    Path p = parse_svg_path("M 0,0 L 10,5 Q 20,20 30,5 C 130,105 30,105 130,5 "
+                            "A 20,10 30 0 0 140,-20 Z")[0];
+    Coord tolerances[] = {1e-2, 1e-6};
+    for (unsigned k = 0; k < 2; ++k) {
+        PathArcLengthIndex index(p, tolerances[k]);
+        EXPECT_NEAR(length_to(p, p.size_default()), index.length(), tolerances[k]);
+        for (unsigned i = 0; i <= 100; ++i) {
+            Coord s = index.length() * i / 100;
+            Coord t = index.timeAtLength(s);
+            EXPECT_NEAR(s, length_to(p, t), tolerances[k]) << "at " << s;
+            EXPECT_NEAR(s, index.lengthAtTime(t), tolerances[k]) << "at " << s;
+            EXPECT_NEAR(0, distance(p.pointAt(t), index.pointAtLength(s)), 1e-9);
+
+            // compare with the direction of a short chord
+            Coord t1 = std::min(t + 1e-6, (Coord) p.size_default());
+            Coord t0 = t1 - 2e-6;
+            if (std::floor(t0) != std::floor(t1 - 1e-9)) continue;
+            Point chord = unit_vector(p.pointAt(t1) - p.pointAt(t0));
+            EXPECT_NEAR(0, distance(chord, index.unitTangentAtLength(s)), 1e-4) << "at " << s;
+        }
+    }
+}
+
+TEST(PathArcLengthIndexTest, DegenerateCurves) {
+    // explicit closing points leave a zero length closing segment
+    char const *paths[] = {"M 0,0 1,0 1,1 0,1 0,0 z",
+                           "M 0,0 C 1,1 2,1 3,0 C 2,-1 1,-1 0,0 Z",
+                           "M 0,0 1,0 1,0 1,1 Z"};
+    for (unsigned k = 0; k < 3; ++k) {
+        Path p = parse_svg_path(paths[k])[0];
+        PathArcLengthIndex index(p, 1e-6);
+        EXPECT_LT(index.size(), 1000u) << paths[k];
+        EXPECT_NEAR(length_to(p, p.size_default()), index.length(), 1e-6) << paths[k];
+        for (unsigned i = 0; i <= 10; ++i) {
+            Coord s = index.length() * i / 10;
+            EXPECT_NEAR(s, length_to(p, index.timeAtLength(s)), 1e-6) << paths[k];
+        }
+    }
+}
+
+TEST(PathArcLengthIndexTest, Empty) {
+    PathArcLengthIndex index(Path(Point(3, 4)));
+    EXPECT_EQ(0, index.length());
+    EXPECT_EQ(0, index.timeAtLength(1));
+    EXPECT_EQ(0, index.lengthAtTime(1));
+    EXPECT_EQ(Point(3, 4), index.pointAtLength(1));
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,178 @@
+/*
+ * Timing and output size of path flattening against uniform sampling
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/path-flatten.h>
+#include <2geom/svg-elliptical-arc.h>
+#include "testing.h"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Geom;
+
+/* Closed paths of lines, quadratics, cubics and elliptical arcs of very
+ * different sizes, spread over a 1000 by 1000 drawing. */
+static PathVector random_paths(unsigned n, unsigned curves) {
+    PathVector pv;
+    for(unsigned i = 0; i < n; i++) {
+        Point o(uniform() * 1000, uniform() * 1000);
+        Coord size = 2 + uniform() * uniform() * 200;
+        Path p(o);
+        for(unsigned j = 0; j < curves; j++) {
+            Point a = o + size * Point(uniform(), uniform());
+            Point b = o + size * Point(uniform(), uniform());
+            Point c = o + size * Point(uniform(), uniform());
+            switch(j % 4) {
+            case 0:
+                p.appendNew<LineSegment>(a);
+                break;
+            case 1:
+                p.appendNew<QuadraticBezier>(a, b);
+                break;
+            case 2:
+                p.appendNew<CubicBezier>(a, b, c);
+                break;
+            default:
+                p.appendNew<SVGEllipticalArc>(size, size * uniform(), uniform() * M_PI,
+                                              false, true, a);
+                break;
+            }
+        }
+        p.close();
+        pv.push_back(p);
+    }
+    return pv;
+}
+
+/* The largest distance from the curves to their chords, sampled. Each curve was split
+ * into the given number of pieces, or as many as flatten() uses when that is zero. */
+static Coord max_error(PathVector const &pv, std::vector<Point> const &points,
+                       std::vector<unsigned> const &offsets, Coord tol, unsigned pieces) {
+    Coord worst = 0;
+    for(unsigned i = 0; i < pv.size(); i++) {
+        unsigned k = offsets[i];
+        for(unsigned j = 0; j < pv[i].size(); j++) {
+            Curve const &c = pv[i][j];
+            unsigned n = pieces ? pieces : flatten_count(c, tol);
+            for(unsigned m = 0; m < n; m++) {
+                LineSegment chord(points[k + m], points[k + m + 1]);
+                for(unsigned s = 1; s < 8; s++) {
+                    Point p = c.pointAt((m + s / 8.) / n);
+                    worst = std::max(worst, distance(p, chord.pointAt(chord.nearestPoint(p))));
+                }
+            }
+            k += n;
+        }
+    }
+    return worst;
+}
+
+struct CountingSink : PolylineSink {
+    unsigned long points;
+    CountingSink() : points(0) {}
+    void moveTo(Point const &) { points++; }
+    void lineTo(Point const *, unsigned n) { points += n; }
+    void closePath() {}
+};
+
+int main(int argc, char **argv) {
+    unsigned n = argc > 1 ? std::atoi(argv[1]) : 500;
+    std::srand(n);
+    PathVector pv = random_paths(n, 20);
+#ifdef _OPENMP
+    std::cout << n << " paths of 20 curves, " << omp_get_max_threads() << " threads" << std::endl;
+#else
+    std::cout << n << " paths of 20 curves" << std::endl;
+#endif
+
+    Coord tolerances[] = {1, 0.1, 0.01};
+    for(unsigned ti = 0; ti < 3; ti++) {
+        Coord tol = tolerances[ti];
+        std::cout << "tolerance " << tol << std::endl;
+
+        std::vector<Point> points;
+        std::vector<unsigned> offsets;
+        double start = wall_seconds();
+        flatten(pv, tol, points, offsets);
+        double elapsed = wall_seconds() - start;
+        std::cout << "  flatten into array: " << points.size() << " points, "
+                  << points.size() / elapsed * 1e-6 << "M points/s, error "
+                  << max_error(pv, points, offsets, tol, 0) << std::endl;
+
+        CountingSink sink;
+        start = seconds();
+        flatten(pv, tol, sink);
+        elapsed = seconds() - start;
+        std::cout << "  flatten into sink: " << sink.points << " points, "
+                  << sink.points / elapsed * 1e-6 << "M points/s" << std::endl;
+
+        // uniform sampling needs as many pieces on every curve as on the worst one
+        unsigned pieces = 1;
+        for(unsigned i = 0; i < pv.size(); i++) {
+            for(unsigned j = 0; j < pv[i].size(); j++) {
+                pieces = std::max(pieces, flatten_count(pv[i][j], tol));
+            }
+        }
+        std::vector<Point> sampled;
+        std::vector<unsigned> sampled_offsets;
+        start = seconds();
+        for(unsigned i = 0; i < pv.size(); i++) {
+            sampled_offsets.push_back(sampled.size());
+            sampled.push_back(pv[i].initialPoint());
+            for(unsigned j = 0; j < pv[i].size(); j++) {
+                for(unsigned k = 1; k < pieces; k++) {
+                    sampled.push_back(pv[i][j].pointAt(k / (double) pieces));
+                }
+                sampled.push_back(pv[i][j].finalPoint());
+            }
+            sampled.push_back(pv[i].initialPoint());
+        }
+        elapsed = seconds() - start;
+        sampled_offsets.push_back(sampled.size());
+        std::cout << "  uniform sampling, " << pieces << " per curve: " << sampled.size()
+                  << " points, " << sampled.size() / elapsed * 1e-6 << "M points/s, error "
+                  << max_error(pv, sampled, sampled_offsets, tol, pieces) << std::endl;
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
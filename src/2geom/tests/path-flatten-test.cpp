@@ -0,0 +1,195 @@
+/*
+ * Unit tests for path flattening
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <gtest/gtest.h>
+#include <2geom/path-flatten.h>
+#include <2geom/sbasis-curve.h>
+#include <2geom/svg-path-parser.h>
+#include <2geom/transforms.h>
+#include <cmath>
+#include <vector>
+
+namespace Geom {
+
+// largest distance of the curve from the chords of its pieces, sampled finely
+static Coord flattening_error(Curve const &c, std::vector<Point> const &pts)
+{
+    unsigned n = pts.size() - 1;
+    Coord worst = 0;
+    for (unsigned k = 0; k < n; ++k) {
+        LineSegment chord(pts[k], pts[k+1]);
+        for (unsigned j = 0; j <= 50; ++j) {
+            Point p = c.pointAt((k + j / 50.) / n);
+            worst = std::max(worst, distance(p, chord.pointAt(chord.nearestPoint(p))));
+        }
+    }
+    return worst;
+}
+
+static std::vector<Point> flatten_curve(Curve const &c, Coord tolerance)
+{
+    unsigned n = flatten_count(c, tolerance);
+    std::vector<Point> pts(n + 1);
+    pts[0] = c.initialPoint();
+    flatten_points(c, n, 0, n, &pts[1]);
+    return pts;
+}
+
+class FlattenTest : public ::testing::Test {
+protected:
+    FlattenTest() {
+        // quadratic, cubic with a cusp, circle, SVG arc, flat ellipse, degenerate arc
+        pv = parse_svg_path("M 0,0 Q 50,80 100,0 C 200,100 100,100 200,0 "
+                            "A 30,30 0 1 1 260,0 A 40,10 30 0 0 300,50 "
+                            "A 0,10 0 0 0 320,60 Z "
+                            "M 0,100 L 10,110 10,120");
+        // a long, thin ellipse through the current point
+        Rotate rot(M_PI / 5);
+        Point center = pv[0].finalPoint() - Point(500 * std::cos(2.8), 3 * std::sin(2.8)) * rot;
+        pv[0].appendNew<EllipticalArc>(500, 3, M_PI / 5, true, false,
+                                       center + Point(500 * std::cos(0.2), 3 * std::sin(0.2)) * rot);
+        pv[1].append(SBasisCurve(CubicBezier(Point(10,120), Point(50,200), Point(-30,200),
+                                             Point(10,120)).toSBasis()));
+        std::vector<Point> quintic;
+        for (unsigned i = 0; i < 6; ++i) {
+            quintic.push_back(Point(10 + 20 * i, 120 + (i % 2 ? 60 : -20)));
+        }
+        curves.push_back(BezierCurve::create(quintic));
+    }
+    ~FlattenTest() {
+        for (unsigned i = 0; i < curves.size(); ++i) delete curves[i];
+    }
+
+    PathVector pv;
+    std::vector<Curve *> curves;
+};
+
+TEST_F(FlattenTest, ToleranceIsKept) {
+    std::vector<Curve const *> all;
+    for (unsigned i = 0; i < pv.size(); ++i) {
+        for (unsigned j = 0; j < pv[i].size(); ++j) all.push_back(&pv[i][j]);
+    }
+    all.insert(all.end(), curves.begin(), curves.end());
+
+    Coord tolerances[] = {5, 0.25, 1e-3};
+    for (unsigned ti = 0; ti < 3; ++ti) {
+        Coord tol = tolerances[ti];
+        for (unsigned i = 0; i < all.size(); ++i) {
+            std::vector<Point> pts = flatten_curve(*all[i], tol);
+            EXPECT_EQ(all[i]->finalPoint(), pts.back());
+            Coord error = flattening_error(*all[i], pts);
+            EXPECT_LE(error, tol) << "curve " << i << " at tolerance " << tol;
+            // and the count is not wildly larger than necessary
+            if (pts.size() > 8) {
+                EXPECT_GT(error, tol / 8) << "curve " << i << " at tolerance " << tol;
+            }
+        }
+    }
+}
+
+struct Collector : PolylineSink {
+    std::vector<Point> pts;
+    unsigned moves, closes, batches;
+    Collector() : moves(0), closes(0), batches(0) {}
+    void moveTo(Point const &p) {
+        ++moves;
+        pts.push_back(p);
+    }
+    void lineTo(Point const *points, unsigned n) {
+        ++batches;
+        pts.insert(pts.end(), points, points + n);
+    }
+    void closePath() {
+        ++closes;
+        pts.push_back(pts[0]);
+    }
+};
+
+TEST_F(FlattenTest, OutputsAgree) {
+    // enough pieces for the sink to get several batches per curve
+    Coord tol = 1e-4;
+    std::vector<Point> points;
+    std::vector<unsigned> offsets;
+    flatten(pv, tol, points, offsets);
+    ASSERT_EQ(pv.size() + 1, offsets.size());
+    EXPECT_EQ(points.size(), offsets.back());
+
+    for (unsigned i = 0; i < pv.size(); ++i) {
+        unsigned count = flatten_count(pv[i], tol);
+        std::vector<Point> buffer(count);
+        EXPECT_EQ(count, flatten(pv[i], tol, &buffer[0]));
+        EXPECT_EQ(count, offsets[i+1] - offsets[i]);
+        EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), points.begin() + offsets[i]));
+
+        Collector sink;
+        flatten(pv[i], tol, sink);
+        EXPECT_EQ(1u, sink.moves);
+        EXPECT_EQ(pv[i].closed() ? 1u : 0u, sink.closes);
+        EXPECT_TRUE(buffer == sink.pts);
+        EXPECT_EQ(pv[i].initialPoint(), buffer.front());
+        EXPECT_EQ(pv[i].closed() ? pv[i].initialPoint() : pv[i].finalPoint(), buffer.back());
+        EXPECT_LT(pv[i].size(), sink.batches);
+    }
+
+    Collector all;
+    flatten(pv, tol, all);
+    EXPECT_EQ(pv.size(), all.moves);
+}
+
+TEST_F(FlattenTest, EdgeCases) {
+    Path empty(Point(3, 4));
+    EXPECT_EQ(1u, flatten_count(empty, 0.1));
+    empty.close();
+    Collector sink;
+    flatten(empty, 0.1, sink);
+    EXPECT_EQ(2u, sink.pts.size());
+
+    // the closing segment adds no point when the path already returns to its start
+    Path square = parse_svg_path("M 0,0 1,0 1,1 0,1 0,0 z")[0];
+    EXPECT_EQ(5u, flatten_count(square, 0.1));
+    square.setFinal(Point(0, 0.5));
+    EXPECT_EQ(6u, flatten_count(square, 0.1));
+
+    EXPECT_THROW(flatten_count(pv[0][0], 0), RangeError);
+    EXPECT_THROW(flatten_count(pv[0][0], -1), RangeError);
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,243 @@
+/*
+ * Timing of common operations on paths made of lines and Bezier curves
+ *//*
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/path.h>
+#include <2geom/path-intersection.h>
+#include <2geom/path-arc-length.h>
+#include <2geom/sbasis-geometric.h>
+#include <2geom/transforms.h>
+#include <2geom/winding-index.h>
+#include "testing.h"
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <ctime>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Geom;
+
+/* A closed path with the mix of segments found in typical drawings:
+ * mostly lines and cubics, with an occasional quadratic. */
+static Path random_path(unsigned n) {
+    Path p(Point(uniform() * 100, uniform() * 100));
+    for(unsigned i = 0; i < n; i++) {
+        Point a(uniform() * 100, uniform() * 100);
+        Point b(uniform() * 100, uniform() * 100);
+        Point c(uniform() * 100, uniform() * 100);
+        switch(i % 5) {
+        case 0:
+        case 1:
+            p.appendNew<LineSegment>(a);
+            break;
+        case 2:
+            p.appendNew<QuadraticBezier>(a, b);
+            break;
+        default:
+            p.appendNew<CubicBezier>(a, b, c);
+            break;
+        }
+    }
+    p.close();
+    return p;
+}
+
+static void report(char const *name, double start, unsigned reps, double check) {
+    double elapsed = seconds() - start;
+    std::cout << "  " << name << ": " << elapsed / reps * 1e6 << "us (" << check << ")" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned reps = argc > 1 ? std::atoi(argv[1]) : 200;
+    unsigned sizes[] = {10, 100, 1000};
+
+    for(unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        unsigned n = sizes[s];
+        unsigned r = reps * 1000 / n;
+        std::srand(n);
+        std::cout << n << " curves, " << r << " repetitions" << std::endl;
+
+        double start = seconds();
+        double check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            check += random_path(n).size();
+        }
+        report("construct", start, r, check);
+
+        Path path = random_path(n);
+
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            Path copy = path;
+            copy *= Translate(1, 1);
+            check += copy.finalPoint()[X];
+        }
+        report("copy and translate", start, r, check);
+
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            for(Path::const_iterator it = path.begin(); it != path.end(); ++it) {
+                check += it->finalPoint()[X];
+            }
+        }
+        report("iterate", start, r, check);
+
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            check += path.boundsExact()->width();
+        }
+        report("boundsExact", start, r, check);
+
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            check += path.boundsFast()->width();
+        }
+        report("boundsFast", start, r, check);
+
+        // only the bounds are compared, so this measures the culling
+        Path apart = path * Translate(200, 0);
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            check += crossings(path, apart).size();
+        }
+        report("crossings with a disjoint copy", start, r, check);
+
+        std::vector<Point> points;
+        for(unsigned i = 0; i < r; i++) {
+            points.push_back(Point(uniform() * 100, uniform() * 100));
+        }
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            check += winding(path, points[i]);
+        }
+        report("winding", start, r, check);
+
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < r / 10 + 1; i++) {
+            WindingIndex index(path);
+            check += index.winding(points[i]);
+        }
+        report("WindingIndex construct", start, r / 10 + 1, check);
+
+        // the same points as above, so the checks can be compared with the one of winding()
+        WindingIndex index(path);
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            check += index.winding(points[i]);
+        }
+        report("WindingIndex winding", start, r, check);
+
+        std::vector<int> windings;
+        start = seconds();
+        index.winding(points, windings);
+        check = 0;
+        for(unsigned i = 0; i < r; i++) {
+            check += windings[i];
+        }
+        report("WindingIndex winding, batch", start, r, check);
+    }
+
+    // many small paths scattered over a map, like the input of sanitize or boolops
+    unsigned counts[] = {100, 1000, 4000};
+    for(unsigned s = 0; s < sizeof(counts) / sizeof(counts[0]); s++) {
+        unsigned n = counts[s];
+        std::srand(n);
+        std::vector<Path> paths;
+        Coord side = std::sqrt((double) n) * 8;
+        for(unsigned i = 0; i < n; i++) {
+            Translate offset(uniform() * side, uniform() * side);
+            paths.push_back(random_path(4) * Scale(0.1) * offset);
+        }
+#ifdef _OPENMP
+        std::cout << n << " paths, " << omp_get_max_threads() << " threads" << std::endl;
+#else
+        std::cout << n << " paths" << std::endl;
+#endif
+
+        double start = wall_seconds();
+        CrossingSet crs = crossings_among(paths);
+        double check = 0;
+        for(unsigned i = 0; i < crs.size(); i++) {
+            check += crs[i].size();
+        }
+        double elapsed = wall_seconds() - start;
+        std::cout << "  crossings_among: " << elapsed * 1e6 << "us (" << check << ")" << std::endl;
+    }
+
+    // points spaced evenly along a path, as for dashes or text on a path
+    unsigned lengths[] = {10, 100, 1000};
+    unsigned queries = 100000;
+    for(unsigned s = 0; s < sizeof(lengths) / sizeof(lengths[0]); s++) {
+        unsigned n = lengths[s];
+        std::srand(n);
+        Path path = random_path(n);
+        std::cout << n << " curves, " << queries << " points at length" << std::endl;
+
+        double start = seconds();
+        PathArcLengthIndex index(path);
+        report("PathArcLengthIndex build", start, 1, index.length());
+        start = seconds();
+        double check = 0;
+        for(unsigned i = 0; i < queries; i++) {
+            check += index.pointAtLength(index.length() * i / queries)[X];
+        }
+        report("PathArcLengthIndex query", start, queries, check);
+
+        start = seconds();
+        Piecewise<D2<SBasis> > pw = arc_length_parametrization(path.toPwSb());
+        report("arc_length_parametrization build", start, 1, pw.cuts.back());
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < queries; i++) {
+            check += pw(pw.cuts.back() * i / queries)[X];
+        }
+        report("arc_length_parametrization query", start, queries, check);
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -4,9 +4,12 @@
 #include <2geom/bezier.h>
 #include <2geom/path.h>
 #include <2geom/pathvector.h>
+#include <2geom/path-intersection.h>
 #include <2geom/svg-path-parser.h>
+#include <2geom/transforms.h>
 #include <vector>
 #include <iterator>
+#include <algorithm>
 
 using namespace std;
 using namespace Geom;
@@ -66,6 +69,241 @@ TEST_F(PathTest, NearestPoint) {
 
 }
 
+TEST_F(PathTest, CurveStorage) {
+    Path p(Point(0,0));
+    p.appendNew<LineSegment>(Point(1,0));
+    p.appendNew<QuadraticBezier>(Point(2,0), Point(2,1));
+    p.appendNew<CubicBezier>(Point(2,2), Point(1,2), Point(0,2));
+    p.append(SBasisCurve(LineSegment(Point(0,2), Point(0,1)).toSBasis()));
+    p.stitchTo(Point(0,0.5));
+    EXPECT_EQ(5u, p.size());
+    EXPECT_TRUE(dynamic_cast<CubicBezier const *>(&p[2]));
+    EXPECT_TRUE(dynamic_cast<SBasisCurve const *>(&p[3]));
+    EXPECT_TRUE(dynamic_cast<Path::StitchSegment const *>(&p[4]));
+
+    // copies share storage until one of them changes
+    Path q(p);
+    EXPECT_TRUE(p == q);
+    EXPECT_EQ(&p[0], &q[0]);
+    q *= Translate(1, 1);
+    EXPECT_EQ(Point(0,0), p.initialPoint());
+    EXPECT_EQ(Point(1,1), q.initialPoint());
+    EXPECT_EQ(Point(1,3), q[2].finalPoint());
+    EXPECT_EQ(Point(0,2), p[2].finalPoint());
+    EXPECT_FALSE(p == q);
+
+    // inline curves compare by value after unsharing
+    Path r(square);
+    r.setFinal(square.finalPoint());
+    EXPECT_NE(&square[0], &r[0]);
+    EXPECT_TRUE(square == r);
+
+    // all kinds of curves compare by value, whether stored inline or not
+    EXPECT_TRUE(string_to_path("M 0,0 1,0 1,1 0,1 z") == square);
+    EXPECT_TRUE(string_to_path("m 362,288.5 a 4.5,4.5 0 1 1 -9,0 4.5,4.5 0 1 1 9,0 z") == circle);
+    EXPECT_FALSE(string_to_path("m 362,288.5 a 4.5,4.5 0 1 0 -9,0 4.5,4.5 0 1 1 9,0 z") == circle);
+    Path s1(Point(0,2)), s2(Point(0,2));
+    s1.append(SBasisCurve(LineSegment(Point(0,2), Point(0,1)).toSBasis()));
+    s2.append(SBasisCurve(LineSegment(Point(0,2), Point(0,1)).toSBasis()));
+    EXPECT_TRUE(s1 == s2);
+
+    Path rev = p.reverse();
+    EXPECT_EQ(p.finalPoint(), rev.initialPoint());
+    EXPECT_EQ(p.initialPoint(), rev.finalPoint());
+    EXPECT_TRUE(dynamic_cast<CubicBezier const *>(&rev[2]));
+
+    boost::shared_ptr<Curve const> ref = p.get_ref_at_index(1);
+    EXPECT_EQ(p[1].finalPoint(), ref->finalPoint());
+    // inline curves are copied, boxed ones shared
+    EXPECT_NE(&p[1], ref.get());
+    EXPECT_TRUE(p[1] == *ref);
+    EXPECT_EQ(&p[3], p.get_ref_at_index(3).get());
+}
+
+// crossings_among() as it was before the pairs were intersected in parallel
+static CrossingSet serial_crossings_among(std::vector<Path> const &p) {
+    CrossingSet results(p.size(), Crossings());
+    SimpleCrosser cc;
+    std::vector<std::vector<unsigned> > cull = sweep_bounds(bounds(p));
+    for(unsigned i = 0; i < cull.size(); i++) {
+        Crossings res = self_crossings(p[i]);
+        for(unsigned k = 0; k < res.size(); k++) { res[k].a = res[k].b = i; }
+        merge_crossings(results[i], res, i);
+        for(unsigned k = 0; k < res.size(); k++) {
+            res[k] = Crossing(res[k].tb, res[k].ta, res[k].b, res[k].a, !res[k].dir);
+        }
+        merge_crossings(results[i], res, i);
+        for(unsigned jx = 0; jx < cull[i].size(); jx++) {
+            unsigned j = cull[i][jx];
+            Crossings res = cc.crossings(p[i], p[j]);
+            for(unsigned k = 0; k < res.size(); k++) { res[k].a = i; res[k].b = j; }
+            merge_crossings(results[i], res, i);
+            merge_crossings(results[j], res, j);
+        }
+    }
+    return results;
+}
+
+TEST_F(PathTest, CrossingsAmong) {
+    std::vector<Path> paths;
+    paths.push_back(square);
+    paths.push_back(diederik * Scale(0.01));
+    srand(7);
+    for(unsigned i = 0; i < 12; i++) {
+        Point p[4];
+        for(unsigned j = 0; j < 4; j++) {
+            p[j] = Point(rand() % 1000, rand() % 1000) / 100;
+        }
+        Path path(p[0]);
+        path.appendNew<CubicBezier>(p[1], p[2], p[3]);
+        path.appendNew<LineSegment>(p[1]);
+        path.close();
+        paths.push_back(path);
+    }
+
+    CrossingSet expected = serial_crossings_among(paths);
+    CrossingSet crs = crossings_among(paths);
+    ASSERT_EQ(expected.size(), crs.size());
+    unsigned total = 0;
+    for(unsigned i = 0; i < crs.size(); i++) {
+        EXPECT_TRUE(expected[i] == crs[i]) << "crossings of path " << i << " differ";
+        total += crs[i].size();
+    }
+    EXPECT_LT(0u, total);
+    EXPECT_TRUE(crossings_among(std::vector<Path>()).empty());
+}
+
+TEST_F(PathTest, CumulativeLengths) {
+    std::vector<Coord> ls = square.cumulativeLengths();
+    ASSERT_EQ(5u, ls.size());
+    for(unsigned i = 0; i < ls.size(); i++) {
+        EXPECT_EQ(i, ls[i]);
+    }
+
+    ls = circle.cumulativeLengths(1e-6);
+    EXPECT_NEAR(2 * M_PI * 4.5, ls.back(), 1e-6);
+
+    // the SBasis form of an elliptical arc is only a fit, so measure a fine polyline instead
+    Path ellipse = string_to_path("M 0,0 A 30,10 20 1 0 20,15 A 5,40 -70 0 1 0,0");
+    ls = ellipse.cumulativeLengths(1e-6);
+    ASSERT_EQ(3u, ls.size());
+    for(unsigned i = 0; i < 2; i++) {
+        Coord expected = 0;
+        for(unsigned k = 0; k < 100000; k++) {
+            expected += distance(ellipse[i].pointAt(k / 100000.), ellipse[i].pointAt((k + 1) / 100000.));
+        }
+        EXPECT_NEAR(expected, ls[i+1] - ls[i], 1e-6);
+    }
+
+    ls = diederik.cumulativeLengths(1e-6);
+    ASSERT_EQ(diederik.size_default() + 1, ls.size());
+    for(unsigned i = 0; i < diederik.size_default(); i++) {
+        Coord expected = length(diederik[i].toSBasis(), 1e-10);
+        EXPECT_NEAR(expected, ls[i+1] - ls[i], 1e-6 * expected);
+    }
+}
+
+// bounds computed from scratch, for comparison with the cached ones
+static Rect curve_union(Path const &p, bool exact) {
+    Rect r = exact ? p[0].boundsExact() : p[0].boundsFast();
+    for(unsigned i = 1; i < p.size(); i++) {
+        r.unionWith(exact ? p[i].boundsExact() : p[i].boundsFast());
+    }
+    return r;
+}
+
+TEST_F(PathTest, CachedBounds) {
+    Path p = diederik;
+    EXPECT_EQ(curve_union(p, false), *p.boundsFast());
+    EXPECT_EQ(curve_union(p, true), *p.boundsExact());
+    std::vector<Rect> const &cb = p.curveBounds();
+    ASSERT_EQ(p.size_closed(), cb.size());
+    for(unsigned i = 0; i < cb.size(); i++) {
+        EXPECT_EQ(p[i].boundsFast(), cb[i]);
+    }
+
+    // a copy shares the bounds until one of the two changes
+    Path q = p;
+    q *= Translate(1000, 0);
+    EXPECT_EQ(curve_union(q, true), *q.boundsExact());
+    EXPECT_EQ(curve_union(p, true), *p.boundsExact());
+    EXPECT_EQ(q[0].boundsFast(), q.curveBounds()[0]);
+
+    q.appendNew<LineSegment>(Point(5000, 5000));
+    EXPECT_EQ(5000, q.boundsFast()->right());
+    EXPECT_EQ(q.size_closed(), q.curveBounds().size());
+    q.setFinal(Point(6000, 5000));
+    EXPECT_EQ(6000, q.boundsExact()->right());
+    q.erase_last();
+    EXPECT_EQ(curve_union(q, false), *q.boundsFast());
+    EXPECT_EQ(curve_union(p, false), *p.boundsFast());
+
+    q.clear();
+    EXPECT_FALSE(q.boundsFast());
+    EXPECT_FALSE(q.boundsExact());
+    EXPECT_EQ(1u, q.curveBounds().size());
+    q.append(p);
+    EXPECT_EQ(*p.boundsExact(), *q.boundsExact());
+
+    // winding outside the bounds
+    EXPECT_EQ(0, winding(square, Point(2, 0.5)));
+    EXPECT_EQ(0, winding(square, Point(-1, 2)));
+    EXPECT_NE(0, winding(square, Point(0.5, 0.5)));
+}
+
+TEST_F(PathTest, SortCrossings) {
+    Crossings cr;
+    cr.push_back(Crossing(0.7, 2.5, 0, 1, false));
+    cr.push_back(Crossing(0.2, 0.5, 0, 1, true));
+    cr.push_back(Crossing(0.5, 1.5, 0, 1, false));
+
+    sort_crossings(cr, 0);
+    EXPECT_EQ(0.2, cr[0].ta);
+    EXPECT_EQ(0.5, cr[1].ta);
+    EXPECT_EQ(0.7, cr[2].ta);
+
+    // by the times on the other path, latest first
+    std::sort(cr.begin(), cr.end(), CrossingOrder(1, true));
+    EXPECT_EQ(2.5, cr[0].tb);
+    EXPECT_EQ(1.5, cr[1].tb);
+    EXPECT_EQ(0.5, cr[2].tb);
+}
+
+TEST_F(PathTest, CurveSweepClosingSegment) {
+    // b only crosses the closing segment of the square
+    Path b = string_to_path("M -0.5,0.5 L 0.5,0.5 L 0.5,0.6 z");
+    Crossings cr = curve_sweep<SimpleCrosser>(square, b);
+    ASSERT_FALSE(cr.empty());
+    for(unsigned i = 0; i < cr.size(); i++) {
+        EXPECT_TRUE(Interval(3, 4).contains(cr[i].ta));
+        EXPECT_TRUE(are_near(square.pointAt(cr[i].ta), b.pointAt(cr[i].tb), 1e-6));
+    }
+}
+
+TEST_F(PathTest, PortionWrapsAround) {
+    // through the closing segment of the square
+    Path p = square.portion(3.5, 0.5);
+    ASSERT_EQ(2u, p.size());
+    EXPECT_EQ(Point(0, 0.5), p.initialPoint());
+    EXPECT_EQ(Point(0, 0), p[0].finalPoint());
+    EXPECT_EQ(Point(0.5, 0), p.finalPoint());
+
+    p = square.portion(2.5, 0.5);
+    ASSERT_EQ(3u, p.size());
+    EXPECT_EQ(Point(0.5, 1), p.initialPoint());
+    EXPECT_EQ(Point(0, 1), p[1].initialPoint());
+    EXPECT_EQ(Point(0, 0), p[1].finalPoint());
+    EXPECT_EQ(Point(0.5, 0), p.finalPoint());
+
+    // a degenerate closing segment is left out
+    Path triangle = string_to_path("M 0,0 1,0 1,1 0,0 z");
+    p = triangle.portion(2.5, 0.5);
+    ASSERT_EQ(2u, p.size());
+    EXPECT_EQ(Point(0.5, 0.5), p.initialPoint());
+    EXPECT_EQ(Point(0, 0), p[0].finalPoint());
+    EXPECT_EQ(Point(0.5, 0), p.finalPoint());
+}
+
     /*TEST_F(PathTest,Operators) {
     cout << "scalar operators\n";
     cout << hump + 3 << endl;
@@ -0,0 +1,133 @@
+/*
+ * Rasterizer performance test
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/rasterizer.h>
+#include <2geom/path-intersection.h>
+#include "testing.h"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+using namespace Geom;
+
+// closed paths of cubics, of very different sizes, spread over the drawing
+static PathVector random_paths(unsigned n, unsigned curves, Coord extent) {
+    PathVector pv;
+    for(unsigned i = 0; i < n; i++) {
+        Point o(uniform() * extent, uniform() * extent);
+        Coord size = 4 + uniform() * uniform() * extent / 4;
+        Path p(o);
+        for(unsigned j = 0; j < curves; j++) {
+            p.appendNew<CubicBezier>(o + size * Point(uniform(), uniform()),
+                                     o + size * Point(uniform(), uniform()),
+                                     o + size * Point(uniform(), uniform()));
+        }
+        p.close();
+        pv.push_back(p);
+    }
+    return pv;
+}
+
+int main(int argc, char **argv) {
+    unsigned n = argc > 1 ? std::atoi(argv[1]) : 200;
+    const int extent = 1024, tile = 256;
+    std::srand(n);
+    PathVector pv = random_paths(n, 10, extent);
+    std::cout << n << " paths of 10 cubics over " << extent << " x " << extent
+              << " pixels, in tiles of " << tile << std::endl;
+
+    double start = seconds();
+    Rasterizer r(pv);
+    std::cout << "  flattening: " << (seconds() - start) * 1e3 << " ms" << std::endl;
+
+    std::vector<int> wind(tile * tile);
+    std::vector<Coord> cov(tile * tile);
+    double megapixels = extent * (double) extent * 1e-6;
+    long inside = 0;
+    start = seconds();
+    for(int y = 0; y < extent; y += tile) {
+        for(int x = 0; x < extent; x += tile) {
+            r.winding(IntRect(x, y, x + tile, y + tile), &wind[0]);
+            for(int i = 0; i < tile * tile; i++) {
+                inside += wind[i] != 0;
+            }
+        }
+    }
+    double elapsed = seconds() - start;
+    std::cout << "  winding: " << megapixels / elapsed << " Mpixels/s, "
+              << inside << " pixels inside" << std::endl;
+
+    bool rules[] = {false, true};
+    for(unsigned k = 0; k < 2; k++) {
+        Coord area = 0;
+        start = seconds();
+        for(int y = 0; y < extent; y += tile) {
+            for(int x = 0; x < extent; x += tile) {
+                r.coverage(IntRect(x, y, x + tile, y + tile), &cov[0], rules[k]);
+                for(int i = 0; i < tile * tile; i++) {
+                    area += cov[i];
+                }
+            }
+        }
+        elapsed = seconds() - start;
+        std::cout << "  coverage, " << (rules[k] ? "even-odd" : "nonzero") << ": "
+                  << megapixels / elapsed << " Mpixels/s, covered area " << area << std::endl;
+    }
+
+    // the same winding numbers from winding() at every pixel center of one tile
+    const int probe = 32;
+    int mismatches = 0;
+    r.winding(IntRect(0, 0, probe, probe), &wind[0]);
+    start = seconds();
+    for(int y = 0; y < probe; y++) {
+        for(int x = 0; x < probe; x++) {
+            int w = 0;
+            for(unsigned i = 0; i < pv.size(); i++) {
+                w += winding(pv[i], Point(x + 0.5, y + 0.5));
+            }
+            mismatches += w != wind[y * probe + x];
+        }
+    }
+    elapsed = seconds() - start;
+    std::cout << "  winding() per pixel: " << probe * probe * 1e-6 / elapsed << " Mpixels/s, "
+              << mismatches << " of " << probe * probe << " pixels differ" << std::endl;
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
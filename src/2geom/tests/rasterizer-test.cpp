@@ -0,0 +1,181 @@
+/*
+ * Unit tests for the scanline rasterizer
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <gtest/gtest.h>
+#include <2geom/rasterizer.h>
+#include <2geom/path-intersection.h>
+#include <2geom/svg-path-parser.h>
+#include <cmath>
+#include <vector>
+
+namespace Geom {
+
+static std::vector<Coord> coverage(Rasterizer const &r, IntRect const &area, bool evenodd)
+{
+    std::vector<Coord> out(area.width() * area.height());
+    r.coverage(area, &out[0], evenodd);
+    return out;
+}
+
+static Coord sum(std::vector<Coord> const &v)
+{
+    Coord s = 0;
+    for (unsigned i = 0; i < v.size(); ++i) s += v[i];
+    return s;
+}
+
+TEST(RasterizerTest, WindingMatchesPaths) {
+    // polygons in both directions, overlapping, partly outside the area, and an open one
+    PathVector pv = parse_svg_path("M 1.2,1.7 30.3,3.1 25.6,20.4 z "
+                                   "M 10.1,-5.3 L 10.9,40.2 50.3,12.8 z "
+                                   "M 5.4,5.9 8.7,28.3 -9.2,18.6 "
+                                   "M 2.2,2.1 9.8,2.1 9.8,9.6 2.2,9.6 z");
+    Rasterizer r(pv);
+    IntRect area(-3, -2, 37, 31);
+    std::vector<int> out(area.width() * area.height());
+    r.winding(area, &out[0]);
+
+    for (int y = 0; y < area.height(); ++y) {
+        for (int x = 0; x < area.width(); ++x) {
+            Point c(area.left() + x + 0.5, area.top() + y + 0.5);
+            int expected = 0;
+            for (unsigned i = 0; i < pv.size(); ++i) {
+                expected += Geom::winding(pv[i], c);
+            }
+            EXPECT_EQ(expected, out[y * area.width() + x]) << c;
+        }
+    }
+}
+
+TEST(RasterizerTest, CoverageArea) {
+    PathVector triangle = parse_svg_path("M 1.2,1.7 30.3,3.1 25.6,20.4 z");
+    Coord expected = 0.5 * std::fabs(29.1 * 18.7 - 24.4 * 1.4);
+    IntRect area(0, 0, 32, 24);
+    EXPECT_NEAR(expected, sum(coverage(Rasterizer(triangle), area, true)), 1e-9);
+    EXPECT_NEAR(expected, sum(coverage(Rasterizer(triangle), area, false)), 1e-9);
+
+    // a circle with a ray of 10 around (20.3, 12.6)
+    PathVector circle = parse_svg_path("M 30.3,12.6 A 10,10 0 0 1 10.3,12.6 "
+                                       "A 10,10 0 0 1 30.3,12.6 z");
+    std::vector<Coord> cov = coverage(Rasterizer(circle, 1e-4), area, false);
+    EXPECT_NEAR(M_PI * 100, sum(cov), 0.01);
+    for (unsigned i = 0; i < cov.size(); ++i) {
+        EXPECT_GE(cov[i], 0);
+        EXPECT_LE(cov[i], 1 + 1e-12);
+    }
+}
+
+TEST(RasterizerTest, PartialPixels) {
+    // covers half of the pixels at its left and right ends, and a quarter at its corners
+    PathVector pv = parse_svg_path("M 0.5,0.5 3.5,0.5 3.5,2 0.5,2 z");
+    std::vector<Coord> cov = coverage(Rasterizer(pv), IntRect(0, 0, 5, 3), true);
+    Coord expected[] = {0.25, 0.5, 0.5, 0.25, 0,
+                        0.5, 1, 1, 0.5, 0,
+                        0, 0, 0, 0, 0};
+    for (unsigned i = 0; i < 15; ++i) {
+        EXPECT_NEAR(expected[i], cov[i], 1e-12) << i;
+    }
+
+    // a slanted edge through the middle of a pixel covers half of it
+    PathVector slant = parse_svg_path("M 0,0 2,0 1,1 z");
+    cov = coverage(Rasterizer(slant), IntRect(0, 0, 2, 1), true);
+    EXPECT_NEAR(1, cov[0] + cov[1], 1e-12);
+    EXPECT_NEAR(0.5, cov[0], 1e-12);
+}
+
+TEST(RasterizerTest, FillRules) {
+    // two squares in the same direction, overlapping on [4, 6] x [0, 6]
+    PathVector pv = parse_svg_path("M 0,0 6,0 6,6 0,6 z M 4,0 10,0 10,6 4,6 z");
+    Rasterizer r(pv);
+    IntRect area(0, 0, 10, 6);
+    std::vector<int> wind(60);
+    r.winding(area, &wind[0]);
+    std::vector<Coord> evenodd = coverage(r, area, true);
+    std::vector<Coord> nonzero = coverage(r, area, false);
+    for (unsigned i = 0; i < 60; ++i) {
+        int x = i % 10;
+        EXPECT_EQ(x >= 4 && x < 6 ? 2 : 1, wind[i]);
+        EXPECT_NEAR(x >= 4 && x < 6 ? 0 : 1, evenodd[i], 1e-12);
+        EXPECT_NEAR(1, nonzero[i], 1e-12);
+    }
+}
+
+TEST(RasterizerTest, TilesAgree) {
+    PathVector pv = parse_svg_path("M 1.2,1.7 C 40,-10 -5,30 30.3,23.1 Q 10,40 3.3,13.4 z "
+                                   "M 5.5,5.5 A 7,4 30 1 0 12.5,8.25 z");
+    Rasterizer r(pv);
+    IntRect whole(-4, -4, 36, 28);
+    std::vector<Coord> all = coverage(r, whole, false);
+    std::vector<int> all_wind(all.size());
+    r.winding(whole, &all_wind[0]);
+
+    for (int ty = -4; ty < 28; ty += 8) {
+        for (int tx = -4; tx < 36; tx += 8) {
+            IntRect tile(tx, ty, tx + 8, ty + 8);
+            std::vector<Coord> part = coverage(r, tile, false);
+            std::vector<int> wind(64);
+            r.winding(tile, &wind[0]);
+            for (int i = 0; i < 64; ++i) {
+                int k = (ty + i / 8 - whole.top()) * whole.width() + tx + i % 8 - whole.left();
+                EXPECT_NEAR(all[k], part[i], 1e-9);
+                EXPECT_EQ(all_wind[k], wind[i]);
+            }
+        }
+    }
+}
+
+TEST(RasterizerTest, EdgeCases) {
+    Rasterizer empty((PathVector()));
+    std::vector<Coord> cov = coverage(empty, IntRect(0, 0, 3, 3), true);
+    EXPECT_EQ(0, sum(cov));
+
+    // paths are clipped to the area on both sides
+    PathVector pv = parse_svg_path("M -10,0 2,0 2,2 -10,2 z M 3,0 8,0 8,3 z");
+    cov = coverage(Rasterizer(pv), IntRect(0, 0, 3, 3), false);
+    Coord expected[] = {1, 1, 0, 1, 1, 0, 0, 0, 0};
+    for (unsigned i = 0; i < 9; ++i) {
+        EXPECT_EQ(expected[i], cov[i]) << i;
+    }
+
+    EXPECT_THROW(Rasterizer(pv, 0), RangeError);
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,153 @@
+/*
+ * Unit tests for the RTree spatial index
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <gtest/gtest.h>
+#include <2geom/rtree.h>
+#include <algorithm>
+#include <cstdlib>
+
+namespace Geom {
+
+class RTreeTest : public ::testing::Test {
+protected:
+    RTreeTest() {
+        std::srand(1);
+        for (unsigned i = 0; i < 2000; ++i) {
+            Point p(std::rand() % 1000, std::rand() % 1000);
+            Point d(std::rand() % 30, std::rand() % 30);
+            items.push_back(std::make_pair(Rect(p, p + d), i));
+        }
+    }
+
+    std::vector<unsigned> brute_query(Rect const &area, std::vector<bool> const &alive) {
+        std::vector<unsigned> ret;
+        for (unsigned i = 0; i < items.size(); ++i) {
+            if (alive[i] && area.intersects(items[i].first)) ret.push_back(i);
+        }
+        return ret;
+    }
+
+    std::vector<unsigned> sorted_query(RTree<unsigned> const &tree, Rect const &area) {
+        std::vector<unsigned> ret;
+        tree.query(area, ret);
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    }
+
+    std::vector<std::pair<Rect, unsigned> > items;
+};
+
+TEST_F(RTreeTest, BulkLoadQuery) {
+    RTree<unsigned> tree(items.begin(), items.end());
+    std::vector<bool> alive(items.size(), true);
+    EXPECT_EQ(tree.size(), items.size());
+
+    for (unsigned i = 0; i < 50; ++i) {
+        Point p(std::rand() % 1000, std::rand() % 1000);
+        Rect area(p, p + Point(std::rand() % 200, std::rand() % 200));
+        EXPECT_EQ(sorted_query(tree, area), brute_query(area, alive));
+    }
+}
+
+TEST_F(RTreeTest, InsertErase) {
+    RTree<unsigned> tree;
+    std::vector<bool> alive(items.size(), true);
+    for (unsigned i = 0; i < items.size(); ++i) {
+        tree.insert(items[i]);
+    }
+    EXPECT_EQ(tree.size(), items.size());
+
+    Rect all(-100, -100, 2000, 2000);
+    EXPECT_EQ(sorted_query(tree, all), brute_query(all, alive));
+
+    for (unsigned i = 0; i < items.size(); i += 3) {
+        EXPECT_TRUE(tree.erase(items[i].first, items[i].second));
+        alive[i] = false;
+    }
+    EXPECT_FALSE(tree.erase(items[0].first, items[0].second));
+    EXPECT_EQ(sorted_query(tree, all), brute_query(all, alive));
+
+    for (unsigned i = 0; i < 50; ++i) {
+        Point p(std::rand() % 1000, std::rand() % 1000);
+        Rect area(p, p + Point(std::rand() % 200, std::rand() % 200));
+        EXPECT_EQ(sorted_query(tree, area), brute_query(area, alive));
+    }
+
+    for (unsigned i = 0; i < items.size(); ++i) {
+        if (alive[i]) {
+            EXPECT_TRUE(tree.erase(items[i].first, items[i].second));
+        }
+    }
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.height(), 1u);
+    EXPECT_FALSE(tree.bounds());
+}
+
+TEST_F(RTreeTest, Nearest) {
+    RTree<unsigned> tree(items.begin(), items.end());
+    for (unsigned i = 0; i < 20; ++i) {
+        Point p(std::rand() % 1200 - 100, std::rand() % 1200 - 100);
+        std::vector<unsigned> found;
+        tree.nearest(p, 10, found);
+        ASSERT_EQ(found.size(), 10u);
+
+        std::vector<Coord> dists;
+        for (unsigned j = 0; j < items.size(); ++j) {
+            dists.push_back(distance(p, items[j].first));
+        }
+        std::sort(dists.begin(), dists.end());
+        for (unsigned j = 0; j < found.size(); ++j) {
+            EXPECT_EQ(distance(p, items[found[j]].first), dists[j]);
+        }
+    }
+}
+
+TEST_F(RTreeTest, VisitorStops) {
+    RTree<unsigned> tree(items.begin(), items.end());
+    struct CountTo {
+        unsigned n;
+        bool operator()(Rect const &, unsigned) { return --n > 0; }
+    } v = { 5 };
+    EXPECT_FALSE(tree.visit(Rect(-100, -100, 2000, 2000), v));
+    EXPECT_EQ(v.n, 0u);
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
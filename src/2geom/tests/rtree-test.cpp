@@ -30,7 +30,7 @@
 */
 
 
-#include <2geom/rtree.h>
+#include <2geom/orphan-code/rtree.h>
 
 #include <time.h>
 #include <vector>
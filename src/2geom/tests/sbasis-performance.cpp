@@ -0,0 +1,127 @@
+/*
+ * Timing and heap allocations of the SBasis functions used by path effects
+ *//*
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/sbasis-geometric.h>
+#include <2geom/piecewise.h>
+#include <2geom/path.h>
+#include "testing.h"
+#include <iostream>
+#include <new>
+#include <cstdlib>
+#include <ctime>
+
+using namespace Geom;
+
+static unsigned long allocations = 0;
+
+void *operator new(std::size_t n) {
+    ++allocations;
+    void *p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) throw() {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) throw() {
+    std::free(p);
+}
+
+static Piecewise<D2<SBasis> > random_curves(unsigned n) {
+    Path p(Point(0, 0));
+    for(unsigned i = 0; i < n; i++) {
+        Point a(uniform() * 100, uniform() * 100);
+        Point b(uniform() * 100, uniform() * 100);
+        Point c(uniform() * 100, uniform() * 100);
+        p.appendNew<CubicBezier>(a, b, c);
+    }
+    return p.toPwSb();
+}
+
+static double sink = 0;
+
+typedef void (*Op)(Piecewise<D2<SBasis> > const &);
+
+static void op_arc_length(Piecewise<D2<SBasis> > const &pw) {
+    sink += arcLengthSb(pw).lastValue();
+}
+static void op_curvature(Piecewise<D2<SBasis> > const &pw) {
+    sink += curvature(pw).size();
+}
+static void op_unit_vector(Piecewise<D2<SBasis> > const &pw) {
+    sink += unitVector(derivative(pw)).size();
+}
+static void op_products(Piecewise<D2<SBasis> > const &pw) {
+    for(unsigned i = 0; i < pw.size(); i++) {
+        D2<SBasis> const &s = pw.segs[i];
+        SBasis speed = multiply(derivative(s[X]), derivative(s[X]))
+                     + multiply(derivative(s[Y]), derivative(s[Y]));
+        sink += compose(speed, Linear(0.25, 0.75)).at0() + integral(speed).at1();
+    }
+}
+
+static void measure(char const *name, Op op, Piecewise<D2<SBasis> > const &pw, unsigned reps) {
+    // fill static tables
+    op(pw);
+    unsigned long before = allocations;
+    double start = seconds();
+    for(unsigned r = 0; r < reps; r++) {
+        op(pw);
+    }
+    double elapsed = seconds() - start;
+    std::cout << "  " << name << ": " << elapsed / reps * 1e6 << "us, "
+              << (allocations - before) / (double) reps << " allocations" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned reps = argc > 1 ? std::atoi(argv[1]) : 200;
+    unsigned n = 20;
+    std::srand(n);
+    Piecewise<D2<SBasis> > pw = random_curves(n);
+    std::cout << n << " cubic segments, " << reps << " repetitions" << std::endl;
+
+    measure("arcLengthSb", op_arc_length, pw, reps);
+    measure("curvature", op_curvature, pw, reps);
+    measure("unitVector", op_unit_vector, pw, reps);
+    measure("multiply, compose, integral", op_products, pw, reps * 10);
+    std::cout << "(" << sink << ")" << std::endl;
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
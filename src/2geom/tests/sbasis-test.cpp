@@ -215,6 +215,44 @@ TEST_F(SBasisTest,Operators) {
     }
 }
 
+TEST_F(SBasisTest, InPlaceOperations) {
+    // big enough to leave the inline storage
+    SBasis big = shift(wiggle, 8) + hump;
+    EXPECT_LT(8u, big.size());
+
+    SBasis Bs[] = {unit, hump, wiggle, big};
+    for(unsigned i = 0; i < sizeof(Bs)/sizeof(SBasis); i++) {
+        SBasis const &a = Bs[i];
+        SBasis const &b = Bs[(i + 1) % 4];
+        SBasis c = big;
+
+        multiply_into(c, a, b);
+        EXPECT_EQ(multiply(a, b), c);
+        multiply_add_into(c, a, b);
+        EXPECT_EQ(multiply_add(a, b, multiply(a, b)), c);
+        derivative_into(c, a);
+        EXPECT_EQ(derivative(a), c);
+        integral_into(c, a);
+        EXPECT_EQ(integral(a), c);
+        compose_into(c, a, hump);
+        EXPECT_EQ(compose(a, hump), c);
+
+        // the result may alias an operand
+        c = a;
+        multiply_into(c, c, b);
+        EXPECT_EQ(multiply(a, b), c);
+        c = a;
+        c *= c;
+        EXPECT_EQ(multiply(a, a), c);
+        c = a;
+        derivative_into(c, c);
+        EXPECT_EQ(derivative(a), c);
+        c = b;
+        compose_into(c, a, c);
+        EXPECT_EQ(compose(a, b), c);
+    }
+}
+
 }  // namespace
 
 int main(int argc, char **argv) {
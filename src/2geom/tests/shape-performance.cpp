@@ -0,0 +1,100 @@
+/*
+ * Timing of union_all() against a sequential fold of boolop()
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/shape.h>
+#include <2geom/transforms.h>
+#include "testing.h"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Geom;
+
+/* Footprints in blocks of eight slightly turned squares that overlap their
+ * neighbours, with streets between the blocks. */
+static std::vector<Shape> footprints(unsigned n) {
+    std::vector<Shape> ret;
+    unsigned blocks = n / 8, side = 1;
+    while(side * side < blocks) side++;
+    for(unsigned i = 0; i < blocks * 8; i++) {
+        unsigned b = i / 8;
+        Point c(b % side * 100 + i % 8 * 9 + uniform() * 2, b / side * 100 + uniform() * 10);
+        Affine m = Rotate(uniform() * 0.3) * Translate(c);
+        Coord s = 5 + uniform();
+        Path p(Point(-s, -s) * m);
+        p.appendNew<LineSegment>(Point(s, -s) * m);
+        p.appendNew<LineSegment>(Point(s, s) * m);
+        p.appendNew<LineSegment>(Point(-s, s) * m);
+        p.close();
+        ret.push_back(Shape(Region(p).asFill()));
+    }
+    return ret;
+}
+
+int main(int argc, char **argv) {
+    unsigned max = argc > 1 ? std::atoi(argv[1]) : 1024;
+#ifdef _OPENMP
+    std::cout << omp_get_max_threads() << " threads" << std::endl;
+#endif
+
+    for(unsigned n = 64; n <= max; n *= 4) {
+        std::srand(n);
+        std::vector<Shape> shapes = footprints(n);
+
+        double start = wall_seconds();
+        Shape fold = shapes[0];
+        for(unsigned i = 1; i < shapes.size(); i++)
+            fold = boolop(fold, shapes[i], BOOLOP_UNION);
+        double fold_time = wall_seconds() - start;
+
+        start = wall_seconds();
+        Shape all = union_all(shapes);
+        double all_time = wall_seconds() - start;
+
+        std::cout << n << " footprints: fold " << fold_time << "s, " << fold.size()
+                  << " regions; union_all " << all_time << "s, " << all.size()
+                  << " regions" << std::endl;
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,178 @@
+/*
+ * Unit tests for unions and intersections of many shapes
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <2geom/shape.h>
+#include <2geom/path-intersection.h>
+#include <2geom/transforms.h>
+#include <cstdlib>
+#include <vector>
+
+namespace Geom {
+
+// a filled square of half side s around c, turned by the angle a
+static Shape square(Point const &c, Coord s, Coord a)
+{
+    Affine m = Rotate(a) * Translate(c);
+    Path p(Point(-s, -s) * m);
+    p.appendNew<LineSegment>(Point(s, -s) * m);
+    p.appendNew<LineSegment>(Point(s, s) * m);
+    p.appendNew<LineSegment>(Point(-s, s) * m);
+    p.close();
+    return Shape(Region(p).asFill());
+}
+
+static bool in_any(std::vector<Shape> const &shapes, Point const &p)
+{
+    for (unsigned i = 0; i < shapes.size(); ++i) {
+        if (shapes[i].contains(p)) return true;
+    }
+    return false;
+}
+
+static bool in_all(std::vector<Shape> const &shapes, Point const &p)
+{
+    for (unsigned i = 0; i < shapes.size(); ++i) {
+        if (!shapes[i].contains(p)) return false;
+    }
+    return true;
+}
+
+TEST(ShapeTest, ClosingSegmentCrossings) {
+    // the squares cross at (0, 3), on the closing segment of the first one, and at (5, 10)
+    Path a(Point(0, 0));
+    a.appendNew<LineSegment>(Point(10, 0));
+    a.appendNew<LineSegment>(Point(10, 10));
+    a.appendNew<LineSegment>(Point(0, 10));
+    a.close();
+    Path b = a * Translate(-5, 3);
+    Crossings cr = crossings(a, b);
+    ASSERT_EQ(2u, cr.size());
+    unsigned closing = 0;
+    for (unsigned i = 0; i < cr.size(); ++i) {
+        if (cr[i].ta > 3) {
+            ++closing;
+            EXPECT_TRUE(are_near(a.pointAt(cr[i].ta), Point(0, 3)));
+        }
+    }
+    EXPECT_EQ(1u, closing);
+
+    Shape x = boolop(Shape(Region(a).asFill()), Shape(Region(b).asFill()), BOOLOP_INTERSECT);
+    EXPECT_TRUE(x.contains(Point(2, 5)));
+    EXPECT_FALSE(x.contains(Point(2, 1)));
+    EXPECT_FALSE(x.contains(Point(7, 5)));
+}
+
+TEST(ShapeTest, UnionAllMatchesFold) {
+    std::srand(3);
+    std::vector<Shape> shapes;
+    // a heap of overlapping squares, and rows of footprints apart from it
+    for (unsigned i = 0; i < 20; ++i) {
+        shapes.push_back(square(Point(uniform() * 30, uniform() * 30), 3 + uniform() * 8,
+                                uniform() * 3));
+    }
+    for (unsigned i = 0; i < 20; ++i) {
+        Point c(100 + (i % 5) * 40 + uniform() * 5, (i / 5) * 40 + uniform() * 5);
+        shapes.push_back(square(c, 3 + uniform() * 8, uniform() * 3));
+    }
+
+    Shape fold = shapes[0];
+    for (unsigned i = 1; i < shapes.size(); ++i) {
+        fold = boolop(fold, shapes[i], BOOLOP_UNION);
+    }
+    Shape all = union_all(shapes);
+    EXPECT_EQ(fold.size(), all.size());
+    for (unsigned i = 0; i < 5000; ++i) {
+        Point p(uniform() * 300 - 10, uniform() * 200 - 10);
+        bool expected = in_any(shapes, p);
+        EXPECT_EQ(expected, fold.contains(p)) << p;
+        EXPECT_EQ(expected, all.contains(p)) << p;
+    }
+}
+
+TEST(ShapeTest, IntersectAllMatchesFold) {
+    std::srand(5);
+    std::vector<Shape> shapes;
+    for (unsigned i = 0; i < 7; ++i) {
+        shapes.push_back(square(Point(10 + uniform() * 3, 10 + uniform() * 3), 8, uniform() * 3));
+    }
+
+    Shape fold = shapes[0];
+    for (unsigned i = 1; i < shapes.size(); ++i) {
+        fold = boolop(fold, shapes[i], BOOLOP_INTERSECT);
+    }
+    Shape all = intersect_all(shapes);
+    for (unsigned i = 0; i < 5000; ++i) {
+        Point p(uniform() * 30 - 5, uniform() * 30 - 5);
+        bool expected = in_all(shapes, p);
+        EXPECT_EQ(expected, fold.contains(p)) << p;
+        EXPECT_EQ(expected, all.contains(p)) << p;
+    }
+}
+
+TEST(ShapeTest, DisjointShapes) {
+    std::vector<Shape> shapes;
+    for (unsigned i = 0; i < 9; ++i) {
+        shapes.push_back(square(Point((i % 3) * 10, (i / 3) * 10), 2, i));
+    }
+    Shape all = union_all(shapes);
+    EXPECT_EQ(9u, all.size());
+    EXPECT_TRUE(all.contains(Point(20, 10)));
+    EXPECT_FALSE(all.contains(Point(15, 10)));
+
+    EXPECT_EQ(0u, intersect_all(shapes).size());
+    EXPECT_FALSE(intersect_all(shapes).contains(Point(20, 10)));
+}
+
+TEST(ShapeTest, EdgeCases) {
+    std::vector<Shape> none;
+    EXPECT_EQ(0u, union_all(none).size());
+    EXPECT_FALSE(union_all(none).contains(Point(0, 0)));
+    // the intersection of nothing is everything
+    EXPECT_TRUE(intersect_all(none).contains(Point(0, 0)));
+
+    std::vector<Shape> one(1, square(Point(0, 0), 1, 0));
+    EXPECT_TRUE(union_all(one).contains(Point(0.5, 0.5)));
+    EXPECT_FALSE(union_all(one).contains(Point(1.5, 0.5)));
+    EXPECT_TRUE(intersect_all(one).contains(Point(0.5, 0.5)));
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
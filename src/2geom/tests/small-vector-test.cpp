@@ -0,0 +1,136 @@
+/*
+ * Unit tests for SmallVector
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <gtest/gtest.h>
+#include <2geom/small-vector.h>
+#include <vector>
+
+namespace Geom {
+
+typedef SmallVector<int, 4> Vec;
+
+static Vec make(int first, int n) {
+    Vec v;
+    for (int i = 0; i < n; ++i) {
+        v.push_back(first + i);
+    }
+    return v;
+}
+
+static void expect_range(Vec const &v, int first, int n) {
+    ASSERT_EQ((unsigned) n, v.size());
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(first + i, v[i]);
+    }
+}
+
+TEST(SmallVectorTest, GrowAndShrink) {
+    Vec v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(4u, v.capacity());
+    v = make(0, 10);
+    expect_range(v, 0, 10);
+    EXPECT_LE(10u, v.capacity());
+
+    // storage is kept when shrinking
+    Vec::size_type cap = v.capacity();
+    v.resize(2);
+    expect_range(v, 0, 2);
+    EXPECT_EQ(cap, v.capacity());
+    v.resize(5, 7);
+    EXPECT_EQ(7, v[4]);
+    v.pop_back();
+    EXPECT_EQ(4u, v.size());
+    EXPECT_THROW(v.at(4), std::out_of_range);
+}
+
+TEST(SmallVectorTest, Copy) {
+    for (int n = 0; n < 8; ++n) {
+        Vec a = make(100, n);
+        Vec b(a);
+        expect_range(b, 100, n);
+        Vec c = make(0, 8 - n);
+        c = a;
+        expect_range(c, 100, n);
+        EXPECT_TRUE(a == c);
+        if (n > 0) {
+            c[0] = -1;
+            EXPECT_TRUE(a != c);
+        }
+    }
+    // push_back of an element of the same vector while it grows
+    Vec d = make(1, 4);
+    d.push_back(d[0]);
+    EXPECT_EQ(1, d[4]);
+}
+
+TEST(SmallVectorTest, Insert) {
+    std::vector<int> src;
+    for (int i = 0; i < 6; ++i) src.push_back(10 + i);
+    Vec v = make(0, 3);
+    v.insert(v.begin() + 1, src.begin(), src.begin() + 2);
+    int expected[] = {0, 10, 11, 1, 2};
+    ASSERT_EQ(5u, v.size());
+    for (unsigned i = 0; i < 5; ++i) EXPECT_EQ(expected[i], v[i]);
+
+    Vec w(src.begin(), src.end());
+    expect_range(w, 10, 6);
+}
+
+TEST(SmallVectorTest, Swap) {
+    // every combination of inline and heap storage
+    int sizes[] = {0, 2, 4, 6, 12};
+    for (unsigned i = 0; i < 5; ++i) {
+        for (unsigned j = 0; j < 5; ++j) {
+            Vec a = make(0, sizes[i]), b = make(100, sizes[j]);
+            a.swap(b);
+            expect_range(a, 100, sizes[j]);
+            expect_range(b, 0, sizes[i]);
+            // both stay usable
+            a.push_back(-1);
+            b.push_back(-2);
+            EXPECT_EQ(-1, a.back());
+            EXPECT_EQ(-2, b.back());
+        }
+    }
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,164 @@
+/*
+ * Throughput of the SVG path parser, in one piece and in chunks
+ *//*
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/svg-path-parser.h>
+#include "testing.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+
+using namespace Geom;
+
+/* Only adds up the coordinates, so that the time is spent in the parser. */
+class SumSink : public SVGPathSink {
+public:
+    double sum;
+    SumSink() : sum(0) {}
+    void moveTo(Point p) { sum += p[X] + p[Y]; }
+    void hlineTo(Coord v) { sum += v; }
+    void vlineTo(Coord v) { sum += v; }
+    void lineTo(Point p) { sum += p[X] + p[Y]; }
+    void curveTo(Point c0, Point c1, Point p) { sum += c0[X] + c1[Y] + p[X] + p[Y]; }
+    void quadTo(Point c, Point p) { sum += c[X] + p[Y]; }
+    void arcTo(double rx, double, double, bool, bool, Point p) { sum += rx + p[X]; }
+    void backspace() {}
+    void closePath() { sum += 1; }
+    void finish() {}
+};
+
+/* Path data in the style of an SVGD dump: absolute commands with six digit coordinates. */
+static std::string make_data(unsigned bytes) {
+    std::ostringstream os;
+    os.precision(9);
+    std::srand(1);
+    while((unsigned) os.tellp() < bytes) {
+        os << "M " << std::rand() % 100000 / 100.0 << "," << std::rand() % 100000 / 100.0;
+        for(unsigned i = 0; i < 20; i++) {
+            if(i % 3) {
+                os << " L " << std::rand() / 4e6 << "," << std::rand() / 4e6;
+            } else {
+                os << " C " << std::rand() / 4e6 << "," << std::rand() / 4e6
+                   << " " << std::rand() / 4e6 << "," << std::rand() / 4e6
+                   << " " << std::rand() / 4e6 << "," << std::rand() / 4e6;
+            }
+        }
+        os << " z ";
+    }
+    return os.str();
+}
+
+static void report(char const *name, double start, unsigned reps, size_t bytes, double check) {
+    double elapsed = (seconds() - start) / reps;
+    std::cout << "  " << name << ": " << elapsed * 1e6 << "us, "
+              << bytes / elapsed / (1 << 20) << " MB/s (" << check << ")" << std::endl;
+}
+
+/* The contents of a file, repeated until they are about as large as the synthetic data. */
+static std::string scale_file(char const *name, unsigned bytes) {
+    std::ifstream file(name);
+    std::ostringstream os;
+    os << file.rdbuf();
+    std::string contents = os.str();
+    std::string data;
+    if(contents.empty()) return data;
+    while(data.size() < bytes) {
+        data += contents;
+        data += '\n';
+    }
+    return data;
+}
+
+static void run(std::string const &data, unsigned reps) {
+    double start = seconds();
+    double check = 0;
+    for(unsigned i = 0; i < reps; i++) {
+        SumSink sink;
+        parse_svg_path(data.c_str(), sink);
+        check += sink.sum;
+    }
+    report("one piece", start, reps, data.size(), check);
+
+    size_t chunks[] = {1 << 16, 4096, 61};
+    for(unsigned c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        start = seconds();
+        check = 0;
+        for(unsigned i = 0; i < reps; i++) {
+            SumSink sink;
+            SVGPathParser parser(sink);
+            for(size_t pos = 0; pos < data.size(); pos += chunks[c]) {
+                parser.feed(data.data() + pos, std::min(chunks[c], data.size() - pos));
+            }
+            parser.finish();
+            check += sink.sum;
+        }
+        std::ostringstream name;
+        name << "chunks of " << chunks[c];
+        report(name.str().c_str(), start, reps, data.size(), check);
+    }
+}
+
+/* Usage: svg-path-parser-performance [repetitions] [file.svgd...]
+ * Each file, for instance from src/2geom/toys, is repeated up to 8 MB. */
+int main(int argc, char **argv) {
+    unsigned reps = argc > 1 ? std::atoi(argv[1]) : 5;
+    unsigned const bytes = 8 << 20;
+
+    std::string data = make_data(bytes);
+    std::cout << "generated, " << data.size() << " bytes, " << reps << " repetitions" << std::endl;
+    run(data, reps);
+
+    for(int i = 2; i < argc; i++) {
+        data = scale_file(argv[i], bytes);
+        if(data.empty()) {
+            std::cout << argv[i] << ": cannot read" << std::endl;
+            continue;
+        }
+        std::cout << argv[i] << ", " << data.size() << " bytes" << std::endl;
+        try {
+            run(data, reps);
+        } catch(SVGPathParseError const &) {
+            std::cout << "  invalid path data" << std::endl;
+        }
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
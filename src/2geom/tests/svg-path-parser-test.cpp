@@ -0,0 +1,192 @@
+/*
+ * Unit tests for the SVG path parser
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <gtest/gtest.h>
+#include <2geom/svg-path-parser.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace Geom {
+
+/* Writes down every call, so that two parses can be compared exactly. */
+class RecordingSink : public SVGPathSink {
+public:
+    std::ostringstream log;
+    RecordingSink() { log.precision(17); }
+
+    void moveTo(Point p) { log << "M" << p[X] << "," << p[Y] << " "; }
+    void hlineTo(Coord v) { log << "H" << v << " "; }
+    void vlineTo(Coord v) { log << "V" << v << " "; }
+    void lineTo(Point p) { log << "L" << p[X] << "," << p[Y] << " "; }
+    void curveTo(Point c0, Point c1, Point p) {
+        log << "C" << c0[X] << "," << c0[Y] << "," << c1[X] << "," << c1[Y]
+            << "," << p[X] << "," << p[Y] << " ";
+    }
+    void quadTo(Point c, Point p) {
+        log << "Q" << c[X] << "," << c[Y] << "," << p[X] << "," << p[Y] << " ";
+    }
+    void arcTo(double rx, double ry, double angle, bool large_arc, bool sweep, Point p) {
+        log << "A" << rx << "," << ry << "," << angle << "," << large_arc << "," << sweep
+            << "," << p[X] << "," << p[Y] << " ";
+    }
+    void backspace() { log << "backspace "; }
+    void closePath() { log << "Z "; }
+    void finish() { log << "finish"; }
+};
+
+static char const *path_data =
+    "M 10,20 L 30.5,-40 h 1e2 v-.5 c 1 2 3 4 5 6 S 7,8 9,10 q -1.25e-1,2 3,4 "
+    "t 5,6 a 10,20 30 1 0 40,50 z m1,1 l2,2 H-3.75 V+4e+1 Z";
+
+static std::string parse_whole(char const *data) {
+    RecordingSink sink;
+    parse_svg_path(data, sink);
+    return sink.log.str();
+}
+
+TEST(SVGPathParserTest, SplitInput) {
+    std::string data(path_data);
+    std::string expected = parse_whole(path_data);
+
+    // split in two pieces at every position, which cuts every number at every digit
+    for (unsigned i = 0; i <= data.size(); ++i) {
+        RecordingSink sink;
+        SVGPathParser parser(sink);
+        parser.feed(data.data(), i);
+        parser.feed(data.data() + i, data.size() - i);
+        parser.finish();
+        EXPECT_EQ(expected, sink.log.str()) << "split at " << i;
+    }
+
+    // one character at a time, with empty pieces in between
+    RecordingSink sink;
+    SVGPathParser parser(sink);
+    for (unsigned i = 0; i < data.size(); ++i) {
+        parser.feed(data.data() + i, 1);
+        parser.feed(data.data() + i, 0);
+    }
+    parser.finish();
+    EXPECT_EQ(expected, sink.log.str());
+}
+
+TEST(SVGPathParserTest, Reuse) {
+    RecordingSink sink;
+    SVGPathParser parser(sink);
+    parser.feed(std::string("M 1,2 L 3."));
+    // parse() starts over, without the partial number and the pending coordinate
+    sink.log.str("");
+    parser.parse(path_data);
+    EXPECT_EQ(parse_whole(path_data), sink.log.str());
+}
+
+TEST(SVGPathParserTest, Numbers) {
+    // numbers need no separators when the next one starts with a sign or a second dot
+    EXPECT_EQ(std::string("M1.5,0.5 L0.001,-2 L-0.5,0.75 finish"),
+              parse_whole("M1.5.5L1e-3-2-.5.75"));
+
+    // every conversion must be correctly rounded, whether or not it takes the fast path
+    char const *formats[] = {"%.17g", "%.6f", "%.3e", "%.15g", "%.0f", "%.25f"};
+    double values[] = {0.1, 0.3, 1.0 / 3, 2.5e-7, 123456.789, 9007199254740993.0,
+                       1e22, 1e23, 4.9e-324, 1.7976931348623157e308, 8.589973e9, 0};
+    unsigned const nvalues = sizeof(values) / sizeof(values[0]);
+    srand(3);
+    for (unsigned i = 0; i < nvalues + 500; ++i) {
+        double v = i < nvalues ? values[i]
+            : (rand() - RAND_MAX / 2) * pow(10.0, rand() % 40 - 20) / RAND_MAX;
+        for (unsigned f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f) {
+            char number[400];
+            snprintf(number, sizeof(number), formats[f], v);
+            std::string data = std::string("M ") + number + " " + number;
+            std::vector<Path> pv = parse_svg_path(data.c_str());
+            ASSERT_EQ(1u, pv.size());
+            double expected = strtod(number, NULL);
+            EXPECT_EQ(expected, pv[0].initialPoint()[X]) << number;
+            EXPECT_EQ(signbit(expected), signbit(pv[0].initialPoint()[X])) << number;
+        }
+    }
+}
+
+TEST(SVGPathParserTest, Errors) {
+    RecordingSink sink;
+    SVGPathParser parser(sink);
+    EXPECT_THROW(parser.feed(std::string("M 1,2 X")), SVGPathParseError);
+
+    // a path cut short is only detected at the end
+    parser.reset();
+    parser.feed(std::string("M 1,2 L 3"));
+    EXPECT_THROW(parser.finish(), SVGPathParseError);
+
+    parser.reset();
+    parser.feed(std::string("M 1,2 L 3,4"));
+    EXPECT_NO_THROW(parser.finish());
+}
+
+TEST(SVGPathParserTest, LongLines) {
+    // more than the size of the line buffer used by read_svgd_f()
+    std::string line = "M 0,0";
+    for (unsigned i = 1; i < 5000; ++i) {
+        std::ostringstream os;
+        os << " L " << i << "," << i % 7;
+        line += os.str();
+    }
+    line += " z";
+
+    FILE *f = tmpfile();
+    ASSERT_TRUE(f != NULL);
+    fprintf(f, "%s\nM 0,0 L 1,1\n", line.c_str());
+    rewind(f);
+    std::vector<Path> first = read_svgd_f(f);
+    std::vector<Path> second = read_svgd_f(f);
+    std::vector<Path> third = read_svgd_f(f);
+    fclose(f);
+
+    ASSERT_EQ(1u, first.size());
+    EXPECT_EQ(5000u, first[0].size_closed());
+    EXPECT_EQ(Point(4999, 4999 % 7), first[0][4998].finalPoint());
+    ASSERT_EQ(1u, second.size());
+    EXPECT_EQ(Point(1, 1), second[0].finalPoint());
+    EXPECT_TRUE(third.empty());
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
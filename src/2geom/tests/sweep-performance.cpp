@@ -0,0 +1,105 @@
+/*
+ * Timing of the list and interval tree sweeps in sweep_bounds()
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/sweep.h>
+#include "testing.h"
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+
+using namespace Geom;
+
+/* Small boxes scattered uniformly over a square that grows with n,
+ * so the expected number of overlaps per box stays constant. */
+static std::vector<Rect> random_rects(unsigned n) {
+    std::vector<Rect> rs;
+    double side = 10 * std::sqrt((double) n);
+    for(unsigned i = 0; i < n; i++) {
+        Point p(uniform() * side, uniform() * side);
+        rs.push_back(Rect(p, p + Point(1 + uniform() * 10, 1 + uniform() * 10)));
+    }
+    return rs;
+}
+
+/* Boxes that are long in X and packed into a few horizontal bands, as produced
+ * by hatching or text baselines. Thousands of them overlap in X at any time,
+ * but each one only touches its neighbours in Y. */
+static std::vector<Rect> clustered_rects(unsigned n) {
+    std::vector<Rect> rs;
+    unsigned bands = 8;
+    for(unsigned i = 0; i < n; i++) {
+        double x = uniform() * 1000;
+        double y = (i % bands) * 1000.0 + uniform() * n / bands;
+        rs.push_back(Rect(x, y, x + 500 + uniform() * 500, y + 1 + uniform()));
+    }
+    return rs;
+}
+
+typedef std::vector<std::vector<unsigned> > (*SweepFunc)(std::vector<Rect> const &, Dim2);
+
+static void time_sweep(char const *name, SweepFunc f, std::vector<Rect> const &rs) {
+    double start = seconds();
+    std::vector<std::vector<unsigned> > pairs = f(rs, X);
+    double elapsed = seconds() - start;
+    unsigned long k = 0;
+    for(unsigned i = 0; i < pairs.size(); i++) k += pairs[i].size();
+    std::cout << "  " << name << ": " << elapsed << "s, " << k << " pairs" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    // the list sweep is quadratic; skip it above this size unless asked
+    unsigned scan_limit = argc > 1 ? std::atoi(argv[1]) : 100000;
+    unsigned sizes[] = {10000, 100000, 1000000};
+
+    for(unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        unsigned n = sizes[s];
+        for(unsigned clustered = 0; clustered < 2; clustered++) {
+            std::srand(n);
+            std::vector<Rect> rs = clustered ? clustered_rects(n) : random_rects(n);
+            std::cout << n << (clustered ? " clustered" : " random") << " rects" << std::endl;
+            if(n <= scan_limit) {
+                time_sweep("scan", sweep_bounds_scan, rs);
+            }
+            time_sweep("tree", sweep_bounds_tree, rs);
+        }
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,116 @@
+/*
+ * Unit tests for the sweepline rectangle intersection
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <gtest/gtest.h>
+#include <2geom/sweep.h>
+#include <cstdlib>
+
+namespace Geom {
+
+static std::vector<Rect> random_rects(unsigned n, double extent) {
+    std::vector<Rect> rs;
+    for(unsigned i = 0; i < n; i++) {
+        Point p(std::rand() % 1000, std::rand() % 1000);
+        Point d(std::rand() / (RAND_MAX + 1.0) * extent, std::rand() / (RAND_MAX + 1.0) * extent);
+        rs.push_back(Rect(p, p + d));
+    }
+    return rs;
+}
+
+static unsigned count_pairs(std::vector<std::vector<unsigned> > const &pairs) {
+    unsigned n = 0;
+    for(unsigned i = 0; i < pairs.size(); i++) n += pairs[i].size();
+    return n;
+}
+
+TEST(SweepTest, TreeMatchesScan) {
+    std::srand(1);
+    for(unsigned d = 0; d < 2; d++) {
+        std::vector<Rect> rs = random_rects(500, 80);
+        std::vector<std::vector<unsigned> > scan = sweep_bounds_scan(rs, (Dim2)d);
+        std::vector<std::vector<unsigned> > tree = sweep_bounds_tree(rs, (Dim2)d);
+        EXPECT_EQ(scan, tree);
+        EXPECT_EQ(tree, sweep_bounds(rs, (Dim2)d));
+    }
+}
+
+TEST(SweepTest, RedBlueTreeMatchesScan) {
+    std::srand(2);
+    for(unsigned d = 0; d < 2; d++) {
+        std::vector<Rect> a = random_rects(300, 120);
+        std::vector<Rect> b = random_rects(400, 60);
+        std::vector<std::vector<unsigned> > scan = sweep_bounds_scan(a, b, (Dim2)d);
+        std::vector<std::vector<unsigned> > tree = sweep_bounds_tree(a, b, (Dim2)d);
+        EXPECT_EQ(scan, tree);
+        EXPECT_EQ(tree, sweep_bounds(a, b, (Dim2)d));
+    }
+}
+
+TEST(SweepTest, ReportsAllOverlaps) {
+    std::srand(3);
+    std::vector<Rect> rs = random_rects(200, 100);
+    std::vector<std::vector<unsigned> > tree = sweep_bounds_tree(rs);
+
+    unsigned expected = 0;
+    for(unsigned i = 0; i < rs.size(); i++) {
+        for(unsigned j = i + 1; j < rs.size(); j++) {
+            if(rs[i].intersects(rs[j])) ++expected;
+        }
+    }
+    EXPECT_EQ(count_pairs(tree), expected);
+    for(unsigned i = 0; i < tree.size(); i++) {
+        for(unsigned j = 0; j < tree[i].size(); j++) {
+            EXPECT_TRUE(rs[i].intersects(rs[tree[i][j]]));
+        }
+    }
+}
+
+TEST(SweepTest, TouchingRects) {
+    std::vector<Rect> rs;
+    for(unsigned i = 0; i < 100; i++) {
+        rs.push_back(Rect(i, 0, i + 1, 1));
+    }
+    std::vector<std::vector<unsigned> > tree = sweep_bounds_tree(rs);
+    EXPECT_EQ(tree, sweep_bounds_scan(rs));
+    EXPECT_EQ(count_pairs(tree), 99u);
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -1,6 +1,12 @@
 #include "gtest/gtest.h"
 #include <vector>
+#include <cstdlib>
+#include <ctime>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <2geom/interval.h>
+#include <2geom/point.h>
 
 // streams out a vector
 template <class T>
@@ -51,3 +57,37 @@ void vector_equal(std::vector<double> a, std::vector<double> b) {
     }
 }
 
+// uniformly distributed in [0, 1), from std::rand() so that std::srand() repeats a run
+inline double uniform() {
+    return std::rand() / (RAND_MAX + 1.0);
+}
+
+// processor time; adds up the time spent by all threads
+inline double seconds() {
+    return std::clock() / (double) CLOCKS_PER_SEC;
+}
+
+// elapsed time, for timing code that runs on several threads
+inline double wall_seconds() {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return seconds();
+#endif
+}
+
+// crossings of a polyline with the ray going right from p, signed by their direction;
+// the winding number around p if the polyline is closed
+inline int polyline_winding(std::vector<Geom::Point> const &pts, Geom::Point const &p) {
+    using Geom::X;
+    using Geom::Y;
+    int wind = 0;
+    for(unsigned i = 0; i + 1 < pts.size(); i++) {
+        Geom::Point const &a = pts[i], &b = pts[i+1];
+        if((a[Y] <= p[Y]) == (b[Y] <= p[Y])) continue;
+        if(a[X] + (p[Y] - a[Y]) * (b[X] - a[X]) / (b[Y] - a[Y]) > p[X]) {
+            wind += b[Y] > a[Y] ? 1 : -1;
+        }
+    }
+    return wind;
+}
@@ -0,0 +1,220 @@
+/*
+ * Concurrent read-only use of shared paths and shapes
+ *
+ * Several threads evaluate, intersect and combine the same PathVector and
+ * Shape objects, whose lazy caches are all cold when the threads start, and
+ * compare every result with the one computed beforehand by a single thread.
+ * Build with -D2GEOM_THREAD_SANITIZER=ON to have data races reported.
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/pathvector.h>
+#include <2geom/path-intersection.h>
+#include <2geom/shape.h>
+#include <2geom/svg-elliptical-arc.h>
+#include <2geom/transforms.h>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <pthread.h>
+
+using namespace Geom;
+
+/* A small pseudo-random generator, so that the scene can be built twice
+ * with the same contents. */
+class Random {
+public:
+    explicit Random(unsigned seed) : _state(seed) {}
+    double uniform() {
+        _state = _state * 1103515245u + 12345u;
+        return (_state >> 8) / double(1u << 24);
+    }
+private:
+    unsigned _state;
+};
+
+struct Scene {
+    PathVector paths;
+    std::vector<Shape> shapes;
+    std::vector<Point> queries;
+};
+
+static Scene make_scene(unsigned seed) {
+    Random r(seed);
+    Scene s;
+    for(unsigned i = 0; i < 12; i++) {
+        Point o(r.uniform() * 100, r.uniform() * 100);
+        Path p(o);
+        for(unsigned j = 0; j < 8; j++) {
+            Point a = o + 40 * Point(r.uniform(), r.uniform());
+            Point b = o + 40 * Point(r.uniform(), r.uniform());
+            Point c = o + 40 * Point(r.uniform(), r.uniform());
+            switch(j % 4) {
+            case 0:
+                p.appendNew<LineSegment>(a);
+                break;
+            case 1:
+                p.appendNew<QuadraticBezier>(a, b);
+                break;
+            case 2:
+                p.appendNew<CubicBezier>(a, b, c);
+                break;
+            default:
+                p.appendNew<SVGEllipticalArc>(30, 10 + 10 * r.uniform(), r.uniform() * M_PI,
+                                              false, true, a);
+                break;
+            }
+        }
+        p.close();
+        s.paths.push_back(p);
+    }
+    for(unsigned i = 0; i < 6; i++) {
+        Affine m = Rotate(r.uniform()) * Translate(r.uniform() * 20, r.uniform() * 20);
+        Coord w = 10 + 10 * r.uniform();
+        Path p(Point(0, 0) * m);
+        p.appendNew<LineSegment>(Point(w, 0) * m);
+        p.appendNew<CubicBezier>(Point(w + 5, 5) * m, Point(w + 5, w - 5) * m, Point(w, w) * m);
+        p.appendNew<LineSegment>(Point(0, w) * m);
+        p.close();
+        s.shapes.push_back(Shape(Region(p).asFill()));
+    }
+    for(unsigned i = 0; i < 16; i++) {
+        s.queries.push_back(Point(r.uniform() * 140, r.uniform() * 140));
+    }
+    return s;
+}
+
+// everything computed from a scene, compared exactly between threads
+struct Results {
+    std::vector<Point> points;
+    std::vector<Coord> times;
+    std::vector<int> windings;
+    std::vector<Rect> bounds;
+    std::vector<Crossing> crossings;
+    std::vector<unsigned> region_sizes;
+
+    bool operator==(Results const &o) const {
+        return points == o.points && times == o.times && windings == o.windings
+            && bounds == o.bounds && crossings == o.crossings
+            && region_sizes == o.region_sizes;
+    }
+};
+
+static void add_shape(Results &res, Shape const &s) {
+    res.region_sizes.push_back(s.size());
+    for(unsigned i = 0; i < s.size(); i++) {
+        Path p = s[i];
+        res.region_sizes.push_back(p.size());
+        if(!p.empty()) res.bounds.push_back(*p.boundsExact());
+    }
+}
+
+static void compute(Scene const &s, Results &res) {
+    for(unsigned i = 0; i < s.paths.size(); i++) {
+        Path const &p = s.paths[i];
+        res.bounds.push_back(*p.boundsFast());
+        res.bounds.push_back(*p.boundsExact());
+        std::vector<Rect> const &cb = p.curveBounds();
+        res.bounds.insert(res.bounds.end(), cb.begin(), cb.end());
+        for(unsigned k = 0; k <= 4 * p.size(); k++) {
+            res.points.push_back(p.pointAt(k / 4.));
+        }
+        for(unsigned k = 0; k < s.queries.size(); k++) {
+            res.times.push_back(p.nearestPoint(s.queries[k]));
+            res.windings.push_back(winding(p, s.queries[k]));
+        }
+    }
+    CrossingSet cs = crossings(s.paths, s.paths);
+    for(unsigned i = 0; i < cs.size(); i++) {
+        res.crossings.insert(res.crossings.end(), cs[i].begin(), cs[i].end());
+    }
+    for(unsigned i = 0; i + 1 < s.shapes.size(); i++) {
+        add_shape(res, boolop(s.shapes[i], s.shapes[i + 1], BOOLOP_UNION));
+        add_shape(res, boolop(s.shapes[i], s.shapes[i + 1], BOOLOP_INTERSECT));
+        add_shape(res, boolop(s.shapes[i], s.shapes[i + 1], BOOLOP_SUBTRACT_A_B));
+    }
+}
+
+struct Task {
+    Scene const *scene;
+    Results const *expected;
+    unsigned rounds;
+    unsigned failures;
+};
+
+static void *run(void *arg) {
+    Task &task = *static_cast<Task *>(arg);
+    for(unsigned i = 0; i < task.rounds; i++) {
+        Results res;
+        compute(*task.scene, res);
+        if(!(res == *task.expected)) task.failures++;
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    unsigned nthreads = argc > 1 ? std::atoi(argv[1]) : 4;
+    unsigned rounds = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    Results expected;
+    compute(make_scene(1), expected);
+
+    // a second copy of the scene, so that its caches are filled by the threads
+    Scene shared = make_scene(1);
+    std::vector<Task> tasks(nthreads);
+    std::vector<pthread_t> threads(nthreads);
+    for(unsigned i = 0; i < nthreads; i++) {
+        tasks[i].scene = &shared;
+        tasks[i].expected = &expected;
+        tasks[i].rounds = rounds;
+        tasks[i].failures = 0;
+        if(pthread_create(&threads[i], NULL, run, &tasks[i]) != 0) {
+            std::cerr << "cannot start thread " << i << std::endl;
+            return 1;
+        }
+    }
+    unsigned failures = 0;
+    for(unsigned i = 0; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+        failures += tasks[i].failures;
+    }
+
+    std::cout << nthreads << " threads, " << rounds << " rounds each: "
+              << failures << " mismatches" << std::endl;
+    return failures ? 1 : 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,112 @@
+/*
+ * Timing of TopoGraph construction on inputs of growing size
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/toposweep.h>
+#include "testing.h"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+using namespace Geom;
+
+/* Two closed paths with wavy upper edges that cross each other about once per
+ * four curves. The sweep only ever holds a handful of sections, so the time per
+ * section should stay flat as n grows; one path per wave keeps the winding
+ * vector of each section short. */
+static PathVector waves(unsigned n) {
+    PathVector pv;
+    for(unsigned k = 0; k < 2; k++) {
+        double phase = k * 2;
+        Path p(Point(0, -10.0 - k));
+        for(unsigned i = 0; i < n / 4; i++) {
+            Point o(i * 4 + phase, 0);
+            p.appendNew<CubicBezier>(o + Point(1, 3), o + Point(3, 3), o + Point(4, 0));
+            p.appendNew<LineSegment>(o + Point(4.001, k ? 0.5 : -0.5));
+        }
+        p.appendNew<LineSegment>(Point(n + phase, -10.0 - k));
+        p.close();
+        pv.push_back(p);
+    }
+    return pv;
+}
+
+/* n closed strips stacked on top of each other, each as long as the input is
+ * wide and with edges cut into short segments, so that all of them are in the
+ * sweep at once and the active set holds two sections per strip. */
+static PathVector strips(unsigned n) {
+    PathVector pv;
+    unsigned const cuts = 16;
+    for(unsigned k = 0; k < n; k++) {
+        double y = k * 2;
+        Path p(Point(0, y));
+        for(unsigned i = 1; i <= cuts; i++) p.appendNew<LineSegment>(Point(i * 10.0, y));
+        for(unsigned i = cuts; i-- > 0; ) p.appendNew<LineSegment>(Point(i * 10.0, y + 1));
+        p.close();
+        pv.push_back(p);
+    }
+    return pv;
+}
+
+static void time_graph(PathVector const &pv, unsigned n, char const *what) {
+    double start = seconds();
+    TopoGraph g(pv, X, 0.00001);
+    double elapsed = seconds() - start;
+
+    unsigned long sections = 0;
+    for(unsigned i = 0; i < g.size(); i++) sections += g[i].enters.size();
+    std::cout << n << " " << what << ": " << elapsed << "s, " << g.size() << " vertices, "
+              << sections << " sections, " << elapsed / sections * 1e6 << "us per section"
+              << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned max = argc > 1 ? std::atoi(argv[1]) : 1024000;
+    unsigned max_strips = argc > 2 ? std::atoi(argv[2]) : 1024;
+
+    for(unsigned n = 1000; n <= max; n *= 4) {
+        time_graph(waves(n), n, "curves");
+    }
+    //the active set grows with n here, but the time per section should only grow with its
+    //logarithm and with the winding vector, which has one entry per strip
+    for(unsigned n = 16; n <= max_strips; n *= 4) {
+        time_graph(strips(n), n, "strips");
+    }
+    return 0;
+}
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,87 @@
+/*
+ * Unit tests for TopoGraph construction
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+
+#include <gtest/gtest.h>
+#include <2geom/toposweep.h>
+#include <2geom/svg-path-parser.h>
+
+namespace Geom {
+
+static void expect_consistent(TopoGraph const &g, PathVector const &pv) {
+    for (unsigned i = 0; i < g.size(); ++i) {
+        for (unsigned j = 0; j < g[i].degree(); ++j) {
+            TopoGraph::Edge e = g[i][j];
+            EXPECT_LT(e.other, g.size());
+            EXPECT_EQ(pv.size(), e.section->windings.size());
+        }
+    }
+}
+
+TEST(TopoSweepTest, OverlappingSquares) {
+    // used to crash in the first sort and then loop forever
+    PathVector pv = parse_svg_path("M 0,0 H 2 V 2 H 0 Z M 1,1 H 3 V 3 H 1 Z");
+    TopoGraph g(pv, X, 1e-5);
+    EXPECT_EQ(10u, g.size());
+    expect_consistent(g, pv);
+}
+
+TEST(TopoSweepTest, NearEndpointsShareVertex) {
+    // the last point is within tolerance of the first, but in another cell of the lookup grid
+    PathVector pv = parse_svg_path("M 0,0 L 4,1 L 1,3 L 0.0000004,-0.0000003");
+    TopoGraph g(pv, X, 1e-5);
+    ASSERT_EQ(3u, g.size());
+    EXPECT_EQ(Point(0, 0), g[0].avg);
+    expect_consistent(g, pv);
+
+    // the same points are distinct vertices with a smaller tolerance
+    TopoGraph h(pv, X, 1e-7);
+    EXPECT_EQ(4u, h.size());
+}
+
+TEST(TopoSweepTest, CrossingPaths) {
+    PathVector pv = parse_svg_path("M 0,0 L 4,1 L 1,3 Z M 2,-1 L 3,3 L 0,2 Z");
+    TopoGraph g(pv, X, 1e-5);
+    EXPECT_EQ(8u, g.size());
+    expect_consistent(g, pv);
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
@@ -0,0 +1,128 @@
+/*
+ * Unit tests for WindingIndex
+ * Uses the Google Testing Framework
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include "testing.h"
+#include <2geom/winding-index.h>
+#include <2geom/path-flatten.h>
+#include <2geom/path-intersection.h>
+#include <2geom/svg-path-parser.h>
+#include <cstdlib>
+#include <vector>
+
+namespace Geom {
+
+class WindingIndexTest : public ::testing::Test {
+protected:
+    WindingIndexTest() {
+        // a square, curves that turn back in X and Y, and an open path
+        paths = parse_svg_path("M 0,0 L 100,0 100,100 0,100 z "
+                               "M 10,10 C 120,-20 -20,120 90,80 Q 50,-40 20,90 z "
+                               "M 30,30 C 70,0 90,60 50,70 L 20,60");
+        std::srand(1);
+        Path random(Point(50, 50));
+        for (unsigned i = 0; i < 300; ++i) {
+            Point a(uniform() * 100, uniform() * 100), b(uniform() * 100, uniform() * 100);
+            if (i % 2) {
+                random.appendNew<LineSegment>(a);
+            } else {
+                random.appendNew<QuadraticBezier>(a, b);
+            }
+        }
+        random.close();
+        paths.push_back(random);
+
+        for (unsigned i = 0; i < 1000; ++i) {
+            points.push_back(Point(uniform() * 120 - 10, uniform() * 120 - 10));
+        }
+    }
+
+    PathVector paths;
+    std::vector<Point> points;
+};
+
+TEST_F(WindingIndexTest, MatchesWinding) {
+    for (unsigned i = 0; i < paths.size(); ++i) {
+        WindingIndex index(paths[i]);
+        for (unsigned j = 0; j < points.size(); ++j) {
+            EXPECT_EQ(winding(paths[i], points[j]), index.winding(points[j]))
+                << "path " << i << " at " << points[j];
+            EXPECT_EQ(contains(paths[i], points[j], false), index.contains(points[j], false));
+        }
+    }
+}
+
+TEST_F(WindingIndexTest, Arcs) {
+    // winding() itself is not reliable around elliptical arcs, so compare with polylines
+    Path arcs = parse_svg_path("M 20,90 A 30,20 40 1 1 60,50 A 10,10 0 0 0 10,10 "
+                               "A 40,40 0 0 1 90,40 z")[0];
+    std::vector<Point> polyline(flatten_count(arcs, 1e-6));
+    flatten(arcs, 1e-6, &polyline[0]);
+    WindingIndex index(arcs);
+    for (unsigned j = 0; j < points.size(); ++j) {
+        EXPECT_EQ(polyline_winding(polyline, points[j]), index.winding(points[j])) << points[j];
+    }
+}
+
+TEST_F(WindingIndexTest, Batch) {
+    for (unsigned i = 0; i < paths.size(); ++i) {
+        WindingIndex index(paths[i]);
+        std::vector<int> result;
+        index.winding(points, result);
+        ASSERT_EQ(points.size(), result.size());
+        for (unsigned j = 0; j < points.size(); ++j) {
+            EXPECT_EQ(index.winding(points[j]), result[j]);
+        }
+    }
+}
+
+TEST_F(WindingIndexTest, EdgeCases) {
+    WindingIndex empty((Path(Point(3, 4))));
+    EXPECT_EQ(0, empty.winding(Point(3, 4)));
+
+    // horizontal lines do not count, and open paths are closed by a straight line
+    WindingIndex flat(parse_svg_path("M 0,10 L 20,10 20,20 0,20")[0]);
+    EXPECT_EQ(0, flat.winding(Point(10, 5)));
+    EXPECT_EQ(1, flat.winding(Point(10, 15)));
+    EXPECT_EQ(0, flat.winding(Point(30, 15)));
+    EXPECT_EQ(0, flat.winding(Point(-10, 15)));
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
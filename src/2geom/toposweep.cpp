@@ -3,6 +3,12 @@
 #include <2geom/path-intersection.h>
 #include <2geom/basic-intersection.h>
 
+#include <cmath>
+#include <deque>
+#include <map>
+#include <queue>
+#include <set>
+
 //using namespace Geom;
 
 namespace Geom {
@@ -218,13 +224,35 @@ void merge(X &a, X const &b, Z const &z) {
      std::inplace_merge(a.begin(), a.begin() + start, a.end(), z);
 }
 
-//TODO: faster than linear
-unsigned find_vertex(std::vector<TopoGraph::Vertex> const &vertices, Point p, double tol) {
-    for(unsigned i = 0; i < vertices.size(); i++)
-        if(are_near(vertices[i].avg, p, tol)) return i;
-    return vertices.size();
+// Cells of a grid of tol-sized cells; every point near p is in one of the nine cells around it.
+typedef std::pair<double, double> GridCell;
+GridCell grid_cell(Point const &p, double size) {
+    return GridCell(std::floor(p[X] / size), std::floor(p[Y] / size));
 }
 
+// Buckets the vertices into a grid of tol-sized cells.  Vertices never move once created.
+class VertexGrid {
+    std::map<GridCell, std::vector<unsigned> > cells;
+    double size;
+public:
+    VertexGrid(double tol) : size(tol > 0 ? tol : 1) {}
+    void insert(Point const &p, unsigned ix) { cells[grid_cell(p, size)].push_back(ix); }
+    // returns the first vertex near p, like a linear search would
+    unsigned find(std::vector<TopoGraph::Vertex> const &vertices, Point const &p, double tol) const {
+        unsigned ret = vertices.size();
+        GridCell c = grid_cell(p, size);
+        for(int i = -1; i <= 1; i++) {
+            for(int j = -1; j <= 1; j++) {
+                std::map<GridCell, std::vector<unsigned> >::const_iterator it = cells.find(GridCell(c.first + i, c.second + j));
+                if(it == cells.end()) continue;
+                for(unsigned k = 0; k < it->second.size() && it->second[k] < ret; k++)
+                    if(are_near(vertices[it->second[k]].avg, p, tol)) ret = it->second[k];
+            }
+        }
+        return ret;
+    }
+};
+
 //takes a vector of T pointers, and returns a vector of T with copies
 template<typename T>
 std::vector<T> deref_vector(std::vector<boost::shared_ptr<T> > const &xs, unsigned from = 0) {
@@ -241,7 +269,7 @@ struct ReverseAdapter {
     typedef typename C::second_argument_type first_argument_type;
     typedef typename C::first_argument_type second_argument_type;
     typedef typename C::result_type result_type;
-    const C &comp;
+    C comp;
     ReverseAdapter(const C &c) : comp(c) {}
     result_type operator()(const first_argument_type &a, const second_argument_type &b) const { return comp(b, a); }
 };
@@ -252,7 +280,7 @@ struct DerefAdapter {
     typedef typename boost::shared_ptr<typename C::first_argument_type> first_argument_type;
     typedef typename boost::shared_ptr<typename C::second_argument_type> second_argument_type;
     typedef typename C::result_type result_type;
-    const C &comp;
+    C comp;
     DerefAdapter(const C &c) : comp(c) {}
     result_type operator()(const first_argument_type a, const second_argument_type b) const {
         if(!a) return false;
@@ -301,7 +329,7 @@ struct MergeIterator {
                 ++ai;
                 if(ai >= a.size()) on_a = false;
             } else {
-                b.erase(b.end());
+                b.pop_back();
                 if(b.empty()) on_a = true;
             }
         }
@@ -322,28 +350,289 @@ void modify_windings(std::vector<int> &windings, boost::shared_ptr<Section> sec,
     if(sec->f > sec->t) windings[k]--;
 }
 
+struct Context;
+typedef std::multimap<double, Context *> ContextExtents;
+typedef std::multimap<Section const *, Context *> ContextHolders;
+
 struct Context {
     boost::shared_ptr<Section> section;
     int from_vert;
     int to_vert;
-    Context(boost::shared_ptr<Section> sect, int from) : section(sect), from_vert(from), to_vert(-1) {}
+    bool active;        //still in the sweep
+    bool finishing;     //already returned by ActiveSet::finished()
+    int winding;        //what modify_windings adds for the section, as last counted
+    ContextExtents::iterator extent;
+    std::multiset<double>::iterator span;
+    ContextHolders::iterator holder;
+    //node of the treap that holds the sweep line
+    Context *left, *right, *parent;
+    unsigned priority, count;
+    Context(boost::shared_ptr<Section> sect, int from) : section(sect), from_vert(from), to_vert(-1),
+        active(false), finishing(false), winding(0), left(0), right(0), parent(0), priority(0), count(1) {}
 };
 
-template<typename C>
-struct ContextAdapter {
-    typedef Context first_argument_type;
-    typedef typename C::second_argument_type second_argument_type;
-    typedef typename C::result_type result_type;
-    const C &comp;
-    ContextAdapter(const C &c) : comp(c) {}
-    result_type operator()(const Context &a, const second_argument_type &b) const { return comp(a.section, b); }
+// The sections crossing the sweep line, in vertical section order.  They are kept in a treap
+// ordered by position and counting its subtrees, so that the position of a section and the
+// section at a position take logarithmic time, and a new section is placed by the same binary
+// search a vector would do.  Rather than scanning the whole line for every event, it finds
+//  - the windings up to a section by moving a running sum from the previous query, one section
+//    at a time; the sweep visits the line in order, so the distance is usually short,
+//  - the finished sections with a heap of end points,
+//  - the sections ending near a point with a grid of end points,
+//  - the sections that a new one may cross by their extent across the sweep.
+// Splitting a section moves its end point and may change its extent; update() files them
+// again, and the entries for the old end point are left in place and skipped when met.
+class ActiveSet {
+public:
+    typedef std::vector<Context *> Contexts;
+
+    ActiveSet(PathVector const &ps, Dim2 d, double tol)
+        : sorter(SectionSorter(ps, (Dim2)(1-d), tol)), root(0), seed(2463534242u), cursor(0)
+        , windings(ps.size(), 0), ends(EndOrder(d)), dim(d), cell_size(tol > 0 ? tol : 1)
+    {}
+
+    unsigned size() const { return count(root); }
+    bool empty() const { return !root; }
+
+    // the section at the given position on the sweep line
+    Context *operator[](unsigned ix) const {
+        Context *n = root;
+        while(ix != count(n->left)) {
+            if(ix < count(n->left)) {
+                n = n->left;
+            } else {
+                ix -= count(n->left) + 1;
+                n = n->right;
+            }
+        }
+        return n;
+    }
+
+    unsigned index(Context const *c) const {
+        unsigned ix = count(c->left);
+        for(; c->parent; c = c->parent)
+            if(c == c->parent->right) ix += count(c->parent->left) + 1;
+        return ix;
+    }
+
+    // adds a section to the sweep in order, and returns its context
+    Context *insert(boost::shared_ptr<Section> s, int from_vert) {
+        //the search of std::lower_bound, so that the sections end up where a vector puts them
+        unsigned first = 0, len = size();
+        while(len > 0) {
+            unsigned half = len / 2;
+            if(sorter((*this)[first + half]->section, s)) {
+                first += half + 1;
+                len -= half + 1;
+            } else {
+                len = half;
+            }
+        }
+        storage.push_back(Context(s, from_vert));
+        Context *c = &storage.back();
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        c->priority = seed;
+        Context *a, *b;
+        split(root, first, a, b);
+        set_root(merge(merge(a, c), b));
+
+        c->active = true;
+        c->winding = winding_of(*s);
+        if(first < cursor) {
+            cursor++;
+            add(c, 1);
+        }
+        c->holder = holders.insert(std::make_pair(s.get(), c));
+        add_extent(c);
+        add_end(c);
+        return c;
+    }
+
+    void erase(Context *c) {
+        unsigned ix = index(c);
+        if(ix < cursor) {
+            cursor--;
+            add(c, -1);
+        }
+        Context *a, *b, *self, *rest;
+        split(root, ix, a, b);
+        split(b, 1, self, rest);
+        set_root(merge(a, rest));
+        extents.erase(c->extent);
+        spans.erase(c->span);
+        holders.erase(c->holder);
+        c->active = false;
+    }
+
+    // to be called after a section was split; it may be in the sweep more than once
+    void update(Section const *s) {
+        std::pair<ContextHolders::iterator, ContextHolders::iterator> r = holders.equal_range(s);
+        for(ContextHolders::iterator it = r.first; it != r.second; ++it) {
+            Context *c = it->second;
+            int w = winding_of(*s);
+            if(w != c->winding) {
+                bool counted = index(c) < cursor;
+                if(counted) add(c, -1);
+                c->winding = w;
+                if(counted) add(c, 1);
+            }
+            extents.erase(c->extent);
+            spans.erase(c->span);
+            add_extent(c);
+            add_end(c);
+        }
+    }
+
+    // appends the sections ending at or before lim, last on the sweep line first
+    void finished(Point const &lim, Contexts &out) {
+        unsigned from = out.size();
+        while(!ends.empty() && !Point::LexOrderRt(dim)(lim, ends.top().first)) {
+            Point p = ends.top().first;
+            Context *c = ends.top().second;
+            ends.pop();
+            if(c->active && !c->finishing && c->section->tp == p) {
+                c->finishing = true;
+                out.push_back(c);
+            }
+        }
+        sort(out, from);
+        std::reverse(out.begin() + from, out.end());
+    }
+
+    // appends the sections ending near p, in order
+    void ending_near(Point const &p, double tol, Contexts &out) {
+        unsigned from = out.size();
+        GridCell c = grid_cell(p, cell_size);
+        for(int i = -1; i <= 1; i++) {
+            for(int j = -1; j <= 1; j++) {
+                GridCell key(c.first + i, c.second + j);
+                std::map<GridCell, Contexts>::iterator it = cells.find(key);
+                if(it == cells.end()) continue;
+                //drop the entries of removed sections and old end points on the way
+                Contexts &v = it->second;
+                unsigned n = 0;
+                for(unsigned k = 0; k < v.size(); k++) {
+                    if(!v[k]->active || grid_cell(v[k]->section->tp, cell_size) != key) continue;
+                    v[n++] = v[k];
+                    if(are_near(v[k]->section->tp, p, tol)) out.push_back(v[k]);
+                }
+                if(n) v.resize(n); else cells.erase(it);
+            }
+        }
+        sort(out, from);
+        out.erase(std::unique(out.begin() + from, out.end()), out.end());
+    }
+
+    // appends the sections whose extent across the sweep intersects si, in order
+    void overlapping(Interval const &si, Contexts &out) const {
+        if(spans.empty()) return;
+        unsigned from = out.size();
+        //twice the longest extent, so that rounding cannot drop a candidate
+        double reach = 2 * *spans.rbegin();
+        for(ContextExtents::const_iterator it = extents.lower_bound(si.min() - reach);
+            it != extents.end() && it->first <= si.max(); ++it) {
+            Section const &sec = *it->second->section;
+            if(si.intersects(Interval(sec.fp[1-dim], sec.tp[1-dim]))) out.push_back(it->second);
+        }
+        sort(out, from);
+    }
+
+    // the windings that modify_windings would sum over the sections up to and including c
+    std::vector<int> const &windings_through(Context const *c) {
+        unsigned target = index(c) + 1;
+        for(; cursor < target; cursor++) add((*this)[cursor], 1);
+        while(cursor > target) add((*this)[--cursor], -1);
+        return windings;
+    }
+
+private:
+    typedef std::pair<Point, Context *> End;
+    struct EndOrder {
+        Dim2 d;
+        EndOrder(Dim2 dim) : d(dim) {}
+        //reversed, so that the heap gives the first end point in the sweep
+        bool operator()(End const &a, End const &b) const { return Point::LexOrderRt(d)(b.first, a.first); }
+    };
+
+    DerefAdapter<SectionSorter> sorter;
+    std::deque<Context> storage;
+    Context *root;
+    unsigned seed;
+    //the windings sum the sections before this position
+    unsigned cursor;
+    std::vector<int> windings;
+    std::priority_queue<End, std::vector<End>, EndOrder> ends;
+    std::map<GridCell, Contexts> cells;
+    ContextExtents extents;
+    std::multiset<double> spans;
+    ContextHolders holders;
+    Dim2 dim;
+    double cell_size;
+
+    static unsigned count(Context const *n) { return n ? n->count : 0; }
+    static void pull(Context *n) {
+        n->count = 1 + count(n->left) + count(n->right);
+        if(n->left) n->left->parent = n;
+        if(n->right) n->right->parent = n;
+    }
+    // splits t into its first k sections and the rest
+    static void split(Context *t, unsigned k, Context *&a, Context *&b) {
+        if(!t) {
+            a = b = 0;
+        } else if(count(t->left) < k) {
+            split(t->right, k - count(t->left) - 1, t->right, b);
+            pull(a = t);
+        } else {
+            split(t->left, k, a, t->left);
+            pull(b = t);
+        }
+    }
+    static Context *merge(Context *a, Context *b) {
+        if(!a) return b;
+        if(!b) return a;
+        if(a->priority > b->priority) {
+            a->right = merge(a->right, b);
+            pull(a);
+            return a;
+        }
+        b->left = merge(a, b->left);
+        pull(b);
+        return b;
+    }
+    void set_root(Context *r) {
+        root = r;
+        if(root) root->parent = 0;
+    }
+    // sorts out[from..] by position on the sweep line
+    void sort(Contexts &out, unsigned from) const {
+        if(out.size() - from < 2) return;
+        std::vector<std::pair<unsigned, Context *> > ixs;
+        for(unsigned i = from; i < out.size(); i++) ixs.push_back(std::make_pair(index(out[i]), out[i]));
+        std::sort(ixs.begin(), ixs.end());
+        for(unsigned i = 0; i < ixs.size(); i++) out[from + i] = ixs[i].second;
+    }
+
+    int winding_of(Section const &sec) const {
+        if(sec.fp[dim] == sec.tp[dim]) return 0;
+        return sec.f < sec.t ? 1 : (sec.f > sec.t ? -1 : 0);
+    }
+    void add(Context const *c, int sign) {
+        windings[c->section->curve.path] += sign * c->winding;
+    }
+    void add_extent(Context *c) {
+        Interval e(c->section->fp[1-dim], c->section->tp[1-dim]);
+        c->extent = extents.insert(std::make_pair(e.min(), c));
+        c->span = spans.insert(e.extent());
+    }
+    void add_end(Context *c) {
+        ends.push(End(c->section->tp, c));
+        cells[grid_cell(c->section->tp, cell_size)].push_back(c);
+    }
 };
 
 #define DINF std::numeric_limits<double>::infinity()
 
 TopoGraph::TopoGraph(PathVector const &ps, Dim2 d, double t) : dim(d), tol(t) {
-    //s_sort = vertical section order
-    ContextAdapter<DerefAdapter<SectionSorter> > s_sort = DerefAdapter<SectionSorter>(SectionSorter(ps, (Dim2)(1-d), tol));
     //sweep_sort = horizontal sweep order
     DerefAdapter<SweepSorter> sweep_sort = DerefAdapter<SweepSorter>(SweepSorter(d));
     //heap_sort = reverse horizontal sweep order
@@ -354,13 +643,15 @@ TopoGraph::TopoGraph(PathVector const &ps, Dim2 d, double t) : dim(d), tol(t) {
     std::vector<boost::shared_ptr<Section> > input_sections = mono_sections(ps, d), chops;
     std::sort(input_sections.begin(), input_sections.end(), sweep_sort);
     
-    std::vector<Context> context;
+    //the sections crossing the sweep line, in vertical section order
+    ActiveSet context(ps, d, tol);
     
     vertices.reserve(input_sections.size());
     
+    VertexGrid grid(tol);
+    
     //std::vector<unsigned> to_process;
     
-    std::vector<int> windings(ps.size(), 0);
     for(MergeIterator<Area, Area, DerefAdapter<SweepSorter> > iter(input_sections, chops, sweep_sort); ; ++iter) {
         //represents our position in the sweep, which controls what we finalize
         //if we have no more to process, finish the rest by setting our position to infinity
@@ -376,61 +667,58 @@ TopoGraph::TopoGraph(PathVector const &ps, Dim2 d, double t) : dim(d), tol(t) {
             }
         } */
         
-        //find all sections to remove
-        for(int i = context.size() - 1; i >= 0; i--) {
-            boost::shared_ptr<Section> sec = context[i].section;
-            if(Point::LexOrderRt(d)(lim, sec->tp)) {
-                //sec->tp is less than or equal to lim
-                if(context[i].to_vert == -1) {
-                    //we need to create a new vertex; add everything that enters it
-                    //Point avg;
-                    //unsigned cnt;
-                    std::vector<Edge> enters;
-                    std::fill(windings.begin(), windings.end(), 0);
-                    for(unsigned j = 0; j < context.size(); j++) {
-                        modify_windings(windings, context[j].section, d);
-                        if(are_near(sec->tp, context[j].section->tp, tol)) {
-                            assert(-1 == context[j].to_vert);
-                            context[j].section->windings = windings;
-                            context[j].to_vert = vertices.size();
-                            enters.push_back(Edge(context[j].section, context[j].from_vert));
-                            //avg += context[j].section->tp;
-                            //cnt++;
-                        }
-                    }
-                    //Vertex &v(avg / (double)cnt);
-                    Vertex v(context[i].section->tp);
-                    v.enters = enters;
-                    vertices.push_back(v);
-                    //to_process.push_back(vertices.size() - 1);
+        //find all sections to remove, whose sec->tp is less than or equal to lim
+        ActiveSet::Contexts finished;
+        context.finished(lim, finished);
+        for(unsigned i = 0; i < finished.size(); i++) {
+            Context *sec = finished[i];
+            if(sec->to_vert == -1) {
+                //we need to create a new vertex; add everything that enters it
+                //Point avg;
+                //unsigned cnt;
+                std::vector<Edge> enters;
+                ActiveSet::Contexts near;
+                context.ending_near(sec->section->tp, tol, near);
+                for(unsigned j = 0; j < near.size(); j++) {
+                    assert(-1 == near[j]->to_vert);
+                    near[j]->section->windings = context.windings_through(near[j]);
+                    near[j]->to_vert = vertices.size();
+                    enters.push_back(Edge(near[j]->section, near[j]->from_vert));
+                    //avg += near[j]->section->tp;
+                    //cnt++;
                 }
-                context.erase(context.begin() + i);
+                //Vertex &v(avg / (double)cnt);
+                Vertex v(sec->section->tp);
+                v.enters = enters;
+                grid.insert(v.avg, vertices.size());
+                vertices.push_back(v);
+                //to_process.push_back(vertices.size() - 1);
             }
+            context.erase(sec);
         }
         
         if(!iter.done()) {
             boost::shared_ptr<Section> s = *iter;
             
             //create a new context, associate a beginning vertex, and insert it in the proper location
-            unsigned ix = find_vertex(vertices, s->fp, tol);
+            unsigned ix = grid.find(vertices, s->fp, tol);
             if(ix == vertices.size()) {
+                grid.insert(s->fp, vertices.size());
                 vertices.push_back(Vertex(s->fp));
                 //to_process.push_back(vertices.size() - 1);
             }
-            unsigned context_ix = std::lower_bound(context.begin(), context.end(), s, s_sort) - context.begin();
-
-            context.insert(context.begin() + context_ix, Context(s, ix));
+            Context *cur = context.insert(s, ix);
             
             Interval si = Interval(s->fp[1-d], s->tp[1-d]);
             
             // Now we intersect with neighbors - do a sweep!
             std::vector<double> this_splits;
-            for(unsigned i = 0; i < context.size(); i++) {
-                if(context[i].section == context[context_ix].section) continue;
-                
-                boost::shared_ptr<Section> sec = context[i].section;
+            ActiveSet::Contexts others;
+            context.overlapping(si, others);
+            for(unsigned i = 0; i < others.size(); i++) {
+                if(others[i]->section == cur->section) continue;
                 
-                if(!si.intersects(Interval(sec->fp[1-d], sec->tp[1-d]))) continue;
+                boost::shared_ptr<Section> sec = others[i]->section;
                 
                 std::vector<double> other_splits;
                 Crossings xs = mono_intersect(s->curve.get(ps), Interval(s->f, s->t),
@@ -442,43 +730,45 @@ TopoGraph::TopoGraph(PathVector const &ps, Dim2 d, double t) : dim(d), tol(t) {
                     other_splits.push_back(xs[j].tb);
                 }
                 merge(chops, split_section(sec, ps, other_splits, d), heap_sort);
+                context.update(sec.get());
             }
             if(!this_splits.empty())
-                merge(chops, split_section(context[context_ix].section, ps, this_splits, d), heap_sort);
+                merge(chops, split_section(cur->section, ps, this_splits, d), heap_sort);
+            context.update(cur->section.get());
             
             std::sort(chops.begin(), chops.end(), heap_sort);
             
-            if(context[context_ix].section->tp[d] - context[context_ix].section->fp[d] <= tol) {
-                if(!are_near(context[context_ix].section->tp, context[context_ix].section->fp, tol)) {
-                    ix = find_vertex(vertices, context[context_ix].section->tp, tol);
+            if(cur->section->tp[d] - cur->section->fp[d] <= tol) {
+                if(!are_near(cur->section->tp, cur->section->fp, tol)) {
+                    ix = grid.find(vertices, cur->section->tp, tol);
                     if(ix != vertices.size()) {
-                        boost::shared_ptr<Section> sec = context[context_ix].section;
-                        Edge e(sec, context[context_ix].from_vert);
+                        boost::shared_ptr<Section> sec = cur->section;
+                        Edge e(sec, cur->from_vert);
                         
                         std::vector<Edge>::iterator it = std::lower_bound(vertices[ix].enters.begin(), vertices[ix].enters.end(), e, edge_sort);
                         
-                        if(vertices[ix].enters.empty()) {                        
-                            std::fill(windings.begin(), windings.end(), 0);
-                            for(unsigned j = 0; j <= context_ix; j++) modify_windings(windings, context[j].section, d);
+                        std::vector<int> w;
+                        if(vertices[ix].enters.empty()) {
+                            w = context.windings_through(cur);
                         } else if(it == vertices[ix].enters.end()) {
-                            windings = (it-1)->section->windings;
-                            modify_windings(windings, (it-1)->section, d);
+                            w = (it-1)->section->windings;
+                            modify_windings(w, (it-1)->section, d);
                         } else {
-                            windings = it->section->windings;
+                            w = it->section->windings;
                         }
                                    
-                        sec->windings = windings;
-                        modify_windings(windings, sec, d);
+                        sec->windings = w;
+                        modify_windings(w, sec, d);
                         
                         for(std::vector<Edge>::iterator it2 = it; it2 != vertices[ix].enters.end(); ++it2) {
-                            it2->section->windings = windings;
-                            modify_windings(windings, it2->section, d);
+                            it2->section->windings = w;
+                            modify_windings(w, it2->section, d);
                         }
                         
                         vertices[ix].enters.insert(it, e);
-                        context.erase(context.begin() + context_ix);
+                        context.erase(cur);
                     }
-                } else context.erase(context.begin() + context_ix);
+                } else context.erase(cur);
             }
         }
         
@@ -488,7 +778,7 @@ TopoGraph::TopoGraph(PathVector const &ps, Dim2 d, double t) : dim(d), tol(t) {
         monoss.push_back(rem);
         chopss.push_back(deref_vector(iter.b));
         rem.clear();
-        for(unsigned i = 0; i < context.size(); i++) rem.push_back(*context[i].section);
+        for(unsigned i = 0; i < context.size(); i++) rem.push_back(*context[i]->section);
         contexts.push_back(rem);
         #endif
         
@@ -614,7 +904,7 @@ Areas traverse_areas(TopoGraph const &g) {
                 e_ix = g[cur].find_section(e.section);
                 
                 if(deg == 1 || e_ix == deg) {
-                   visited[cur][e_ix] = true;
+                   if(e_ix < deg) visited[cur][e_ix] = true;
                    break;
                 }
                 
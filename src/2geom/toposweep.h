@@ -67,7 +67,7 @@ struct Section {
     Point fp, tp;
     std::vector<int> windings;
     Section(CurveIx cix, double fd, double td, Point fdp, Point tdp) : curve(cix), f(fd), t(td), fp(fdp), tp(tdp) { }
-    Section(CurveIx cix, double fd, double td, PathVector ps, Dim2 d) : curve(cix), f(fd), t(td) {
+    Section(CurveIx cix, double fd, double td, PathVector const &ps, Dim2 d) : curve(cix), f(fd), t(td) {
         fp = curve.get(ps).pointAt(f), tp = curve.get(ps).pointAt(t);
         if (Point::LexOrderRt(d)(tp, fp)) {
             //swap from and to, since tp is left or above fp
@@ -0,0 +1,214 @@
+/*
+ * Index of the monotone pieces of a path for fast winding number queries
+ *
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#include <2geom/winding-index.h>
+#include <2geom/path-intersection.h>
+#include <algorithm>
+
+namespace Geom {
+
+// deep enough to reach the resolution of the curve times
+static const unsigned MAX_DEPTH = 52;
+
+struct WindingIndex::MinOrder {
+    std::vector<Piece> const &pieces;
+    MinOrder(std::vector<Piece> const &p) : pieces(p) {}
+    bool operator()(unsigned a, unsigned b) const { return pieces[a].ymin < pieces[b].ymin; }
+};
+
+struct WindingIndex::MaxOrder {
+    std::vector<Piece> const &pieces;
+    MaxOrder(std::vector<Piece> const &p) : pieces(p) {}
+    bool operator()(unsigned a, unsigned b) const { return pieces[a].ymax > pieces[b].ymax; }
+};
+
+WindingIndex::WindingIndex(Path const &p)
+    : _path(p)
+    , _root(-1)
+{
+    // cutting at the ends of the curves too keeps every piece on a single curve
+    unsigned n = _path.size_open();
+    std::vector<double> times = path_mono_splits(_path);
+    for (unsigned i = 0; i <= n; ++i) {
+        times.push_back(i);
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    std::vector<Piece> pieces;
+    for (unsigned k = 1; k < times.size(); ++k) {
+        Coord from = times[k-1], to = times[k];
+        if (from < 0 || to > n) continue;
+        Piece piece;
+        piece.curve = unsigned(from);
+        piece.t0 = from - piece.curve;
+        piece.t1 = to - piece.curve;
+        pieces.push_back(piece);
+    }
+    // winding() counts the closing segment of open paths as well
+    Piece closing;
+    closing.curve = n;
+    closing.t0 = 0;
+    closing.t1 = 1;
+    pieces.push_back(closing);
+
+    for (unsigned i = 0; i < pieces.size(); ++i) {
+        Piece &piece = pieces[i];
+        Curve const &c = _path[piece.curve];
+        piece.p0 = c.pointAt(piece.t0);
+        piece.p1 = c.pointAt(piece.t1);
+        // horizontal pieces never cross a horizontal ray
+        if (piece.p0[Y] == piece.p1[Y]) continue;
+        piece.ymin = std::min(piece.p0[Y], piece.p1[Y]);
+        piece.ymax = std::max(piece.p0[Y], piece.p1[Y]);
+        piece.dir = piece.p1[Y] > piece.p0[Y] ? 1 : -1;
+        _pieces.push_back(piece);
+    }
+
+    std::vector<unsigned> all(_pieces.size());
+    for (unsigned i = 0; i < all.size(); ++i) {
+        all[i] = i;
+    }
+    _by_min.reserve(all.size());
+    _by_max.reserve(all.size());
+    _root = _build(all);
+}
+
+/* Stores the pieces that span the median of their tops in a new node, and the pieces
+ * above and below it in its subtrees. The piece at the median always stays in the node,
+ * and each subtree gets at most half of the pieces. */
+int WindingIndex::_build(std::vector<unsigned> &pieces)
+{
+    if (pieces.empty()) return -1;
+
+    std::vector<Coord> tops(pieces.size());
+    for (unsigned i = 0; i < pieces.size(); ++i) {
+        tops[i] = _pieces[pieces[i]].ymin;
+    }
+    std::nth_element(tops.begin(), tops.begin() + tops.size() / 2, tops.end());
+
+    Node node;
+    node.center = tops[tops.size() / 2];
+    node.first = _by_min.size();
+    std::vector<unsigned> below, above;
+    for (unsigned i = 0; i < pieces.size(); ++i) {
+        Piece const &piece = _pieces[pieces[i]];
+        if (piece.ymax <= node.center) {
+            below.push_back(pieces[i]);
+        } else if (piece.ymin > node.center) {
+            above.push_back(pieces[i]);
+        } else {
+            _by_min.push_back(pieces[i]);
+            _by_max.push_back(pieces[i]);
+        }
+    }
+    node.last = _by_min.size();
+    std::sort(_by_min.begin() + node.first, _by_min.end(), MinOrder(_pieces));
+    std::sort(_by_max.begin() + node.first, _by_max.end(), MaxOrder(_pieces));
+    pieces.clear();
+
+    int index = _nodes.size();
+    _nodes.push_back(node);
+    int b = _build(below);
+    int a = _build(above);
+    _nodes[index].below = b;
+    _nodes[index].above = a;
+    return index;
+}
+
+/* Whether the ray from p to the right crosses a piece that spans the height of p. As the
+ * piece is monotone, its ends bound it, so it is halved until p is clear of the bounds. */
+int WindingIndex::_crossing(Piece const &piece, Point const &p) const
+{
+    Curve const &c = _path[piece.curve];
+    Coord t0 = piece.t0, t1 = piece.t1;
+    Point a = piece.p0, b = piece.p1;
+    for (unsigned depth = 0; ; ++depth) {
+        if (p[X] < std::min(a[X], b[X])) return piece.dir;
+        if (p[X] >= std::max(a[X], b[X])) return 0;
+        if (depth == MAX_DEPTH) {
+            return p[X] < (a[X] + b[X]) / 2 ? piece.dir : 0;
+        }
+        Coord tm = (t0 + t1) / 2;
+        Point m = c.pointAt(tm);
+        if ((a[Y] <= p[Y]) != (m[Y] <= p[Y])) {
+            t1 = tm;
+            b = m;
+        } else {
+            t0 = tm;
+            a = m;
+        }
+    }
+}
+
+int WindingIndex::winding(Point const &p) const
+{
+    int wind = 0;
+    for (int n = _root; n >= 0;) {
+        Node const &node = _nodes[n];
+        if (p[Y] < node.center) {
+            // every piece of the node reaches below the point; look for those that start above it
+            for (unsigned i = node.first; i < node.last; ++i) {
+                Piece const &piece = _pieces[_by_min[i]];
+                if (piece.ymin > p[Y]) break;
+                wind += _crossing(piece, p);
+            }
+            n = node.below;
+        } else {
+            for (unsigned i = node.first; i < node.last; ++i) {
+                Piece const &piece = _pieces[_by_max[i]];
+                if (piece.ymax <= p[Y]) break;
+                wind += _crossing(piece, p);
+            }
+            n = node.above;
+        }
+    }
+    return wind;
+}
+
+void WindingIndex::winding(std::vector<Point> const &points, std::vector<int> &result) const
+{
+    result.resize(points.size());
+    for (unsigned i = 0; i < points.size(); ++i) {
+        result[i] = winding(points[i]);
+    }
+}
+
+} // end namespace Geom
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :
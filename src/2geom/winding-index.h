@@ -0,0 +1,110 @@
+/**
+ * \file
+ * \brief Index of the monotone pieces of a path for fast winding number queries
+ *//*
+ * Copyright 2026 Authors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it either under the terms of the GNU Lesser General Public
+ * License version 2.1 as published by the Free Software Foundation
+ * (the "LGPL") or, at your option, under the terms of the Mozilla
+ * Public License Version 1.1 (the "MPL"). If you do not alter this
+ * notice, a recipient may use your version of this file under either
+ * the MPL or the LGPL.
+ *
+ * You should have received a copy of the LGPL along with this library
+ * in the file COPYING-LGPL-2.1; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ * You should have received a copy of the MPL along with this library
+ * in the file COPYING-MPL-1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License
+ * Version 1.1 (the "License"); you may not use this file except in
+ * compliance with the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY
+ * OF ANY KIND, either express or implied. See the LGPL or the MPL for
+ * the specific language governing rights and limitations.
+ */
+
+#ifndef LIB2GEOM_SEEN_WINDING_INDEX_H
+#define LIB2GEOM_SEEN_WINDING_INDEX_H
+
+#include <vector>
+#include <2geom/path.h>
+
+namespace Geom {
+
+/**
+ * @brief Read-only Path prepared for many winding number queries.
+ *
+ * winding() walks every curve of the path for each point. The index instead cuts the
+ * path once, at the times returned by path_mono_splits() and at the ends of its curves,
+ * into pieces that are monotone in both X and Y, and keeps them in an interval tree
+ * on their Y ranges. A query only looks at the pieces that span its height; a piece
+ * entirely to one side of the point is decided by its ends alone, and the rest are
+ * bisected until the point falls outside the box of a half.
+ *
+ * The results are the same as those of winding(), except for points on the path.
+ * Like winding(), the path is treated as closed. The index keeps its own copy of
+ * the path; rebuild it when the path changes.
+ */
+class WindingIndex {
+public:
+    explicit WindingIndex(Path const &p);
+
+    Path const &path() const { return _path; }
+
+    int winding(Point const &p) const;
+    /** @brief Winding numbers of many points.
+     * Same as calling winding() for each point in turn; the results are stored in the
+     * order of the points. */
+    void winding(std::vector<Point> const &points, std::vector<int> &result) const;
+
+    bool contains(Point const &p, bool evenodd = true) const {
+        int w = winding(p);
+        return (evenodd ? w % 2 : w) != 0;
+    }
+
+private:
+    struct Piece {
+        unsigned curve;
+        Coord t0, t1;   // times on the curve
+        Point p0, p1;   // the points at those times
+        Coord ymin, ymax;
+        int dir;        // +1 if Y increases along the piece, -1 if it decreases
+    };
+    struct Node {
+        Coord center;
+        unsigned first, last; // the pieces that span the center
+        int below, above;     // children, or -1
+    };
+    struct MinOrder;
+    struct MaxOrder;
+
+    int _build(std::vector<unsigned> &pieces);
+    int _crossing(Piece const &piece, Point const &p) const;
+
+    Path _path;
+    std::vector<Piece> _pieces;
+    std::vector<Node> _nodes;
+    // the pieces of every node, sorted by their top and by their bottom respectively
+    std::vector<unsigned> _by_min, _by_max;
+    int _root;
+};
+
+} // end namespace Geom
+
+#endif // LIB2GEOM_SEEN_WINDING_INDEX_H
+
+/*
+  Local Variables:
+  mode:c++
+  c-file-style:"stroustrup"
+  c-file-offsets:((innamespace . 0)(inline-open . 0)(case-label . +))
+  indent-tabs-mode:nil
+  fill-column:99
+  End:
+*/
+// vim: filetype=cpp:expandtab:shiftwidth=4:tabstop=8:softtabstop=4:fileencoding=utf-8:textwidth=99 :